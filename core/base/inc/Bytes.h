@@ -53,6 +53,11 @@
 #include "Byteswap.h"
 #endif
 
+#if defined(R__BYTESWAP) && defined(__SSE2__) && !defined(__CINT__) && !defined(__CLING__)
+#define R__USESSE2SWAP
+#include <emmintrin.h>
+#endif
+
 //______________________________________________________________________________
 inline void tobuf(char *&buf, Bool_t x)
 {
@@ -446,6 +451,102 @@ inline void frombuf(char *&buf, Long_t *x)   { frombuf(buf, (ULong_t *) x); }
 inline void frombuf(char *&buf, Long64_t *x) { frombuf(buf, (ULong64_t *) x); }
 
 
+//______________________________________________________________________________
+// Copy n values of the given size while reversing the byte order of each of
+// them. The arrays do not need to be aligned and must not overlap.
+// Used by the array versions of tobuf() and frombuf() below.
+#ifdef R__BYTESWAP
+inline void R__swapcpy16(char *to, const char *from, Int_t n)
+{
+   Int_t i = 0;
+#if defined(R__USESSE2SWAP)
+   for (; i + 8 <= n; i += 8) {
+      __m128i v = _mm_loadu_si128((const __m128i *)(from + 2*i));
+      v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+      _mm_storeu_si128((__m128i *)(to + 2*i), v);
+   }
+#endif
+   for (; i < n; i++) {
+      to[2*i]   = from[2*i+1];
+      to[2*i+1] = from[2*i];
+   }
+}
+
+inline void R__swapcpy32(char *to, const char *from, Int_t n)
+{
+   Int_t i = 0;
+#if defined(R__USESSE2SWAP)
+   for (; i + 4 <= n; i += 4) {
+      __m128i v = _mm_loadu_si128((const __m128i *)(from + 4*i));
+      v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+      v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2,3,0,1));
+      v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2,3,0,1));
+      _mm_storeu_si128((__m128i *)(to + 4*i), v);
+   }
+#endif
+   for (; i < n; i++)
+      for (Int_t k = 0; k < 4; k++)
+         to[4*i+k] = from[4*i+3-k];
+}
+
+inline void R__swapcpy64(char *to, const char *from, Int_t n)
+{
+   Int_t i = 0;
+#if defined(R__USESSE2SWAP)
+   for (; i + 2 <= n; i += 2) {
+      __m128i v = _mm_loadu_si128((const __m128i *)(from + 8*i));
+      v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+      v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0,1,2,3));
+      v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0,1,2,3));
+      _mm_storeu_si128((__m128i *)(to + 8*i), v);
+   }
+#endif
+   for (; i < n; i++)
+      for (Int_t k = 0; k < 8; k++)
+         to[8*i+k] = from[8*i+7-k];
+}
+#endif
+
+//______________________________________________________________________________
+// Array versions of tobuf() and frombuf(): pack or unpack n values at once.
+#ifdef R__BYTESWAP
+# define R__BYTES_ARRAY(type, size)                                         \
+inline void tobuf(char *&buf, const type *x, Int_t n)                       \
+{                                                                           \
+   R__swapcpy##size(buf, (const char *)x, n);                               \
+   buf += n * (Int_t)sizeof(type);                                          \
+}                                                                           \
+inline void frombuf(char *&buf, type *x, Int_t n)                           \
+{                                                                           \
+   R__swapcpy##size((char *)x, buf, n);                                     \
+   buf += n * (Int_t)sizeof(type);                                          \
+}
+#else
+# define R__BYTES_ARRAY(type, size)                                         \
+inline void tobuf(char *&buf, const type *x, Int_t n)                       \
+{                                                                           \
+   memcpy(buf, x, n * sizeof(type));                                        \
+   buf += n * (Int_t)sizeof(type);                                          \
+}                                                                           \
+inline void frombuf(char *&buf, type *x, Int_t n)                           \
+{                                                                           \
+   memcpy(x, buf, n * sizeof(type));                                        \
+   buf += n * (Int_t)sizeof(type);                                          \
+}
+#endif
+
+R__BYTES_ARRAY(Short_t,   16)
+R__BYTES_ARRAY(UShort_t,  16)
+R__BYTES_ARRAY(Int_t,     32)
+R__BYTES_ARRAY(UInt_t,    32)
+R__BYTES_ARRAY(Float_t,   32)
+R__BYTES_ARRAY(Long64_t,  64)
+R__BYTES_ARRAY(ULong64_t, 64)
+R__BYTES_ARRAY(Double_t,  64)
+
+#undef R__BYTES_ARRAY
+
+
 //______________________________________________________________________________
 #ifdef R__BYTESWAP
 inline UShort_t host2net(UShort_t x)
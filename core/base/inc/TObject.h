@@ -70,6 +70,7 @@ public:
       kIsOnHeap      = 0x01000000,    ///< object is on heap
       kNotDeleted    = 0x02000000,    ///< object has not been deleted
       kZombie        = 0x04000000,    ///< object ctor failed
+      kHasCleanupHolders = 0x08000000, ///< object is registered with TROOT::RegisterCleanup
       kBitMask       = 0x00ffffff
    };
 
@@ -198,6 +199,7 @@ public:
    static void      SetObjectStat(Bool_t stat);
 
    friend class TClonesArray; // needs to reset kNotDeleted in fBits
+   friend class TROOT;        // needs to set kHasCleanupHolders in fBits
 
    ClassDef(TObject,1)  //Basic ROOT object
 };
@@ -237,6 +239,7 @@ inline TObject::TObject(const TObject &obj)
 
    fBits &= ~kIsReferenced;
    fBits &= ~kCanDelete;
+   fBits &= ~kHasCleanupHolders;
 
    // Set only after used in above call
    fUniqueID = obj.fUniqueID; // when really unique don't copy
@@ -250,6 +253,7 @@ inline TObject::TObject(const TObject &obj)
 inline TObject &TObject::operator=(const TObject &rhs)
 {
    if (R__likely(this != &rhs)) {
+      UInt_t holders = fBits & kHasCleanupHolders; // registrations are not copied
       fUniqueID = rhs.fUniqueID; // when really unique don't copy
       if (IsOnHeap()) {          // test uses fBits so don't move next line
          fBits = rhs.fBits;
@@ -260,6 +264,7 @@ inline TObject &TObject::operator=(const TObject &rhs)
       }
       fBits &= ~kIsReferenced;
       fBits &= ~kCanDelete;
+      fBits = (fBits & ~kHasCleanupHolders) | holders;
    }
    return *this;
 }
@@ -197,6 +197,7 @@ public:
    void              AddClassGenerator(TClassGenerator *gen);
    virtual void      Append(TObject *obj, Bool_t replace = kFALSE);
    void              Browse(TBrowser *b);
+   void              CallRecursiveRemove(TObject *obj);
    Bool_t            ClassSaved(TClass *cl);
    void              CloseFiles();
    void              EndOfProcessCleanups();
@@ -251,6 +252,8 @@ public:
    TSeqCollection   *GetListOfSpecials() const    { return fSpecials; }
    TSeqCollection   *GetListOfTasks() const       { return fTasks; }
    TSeqCollection   *GetListOfCleanups() const    { return fCleanups; }
+   Long64_t          GetNCleanupCalls() const;
+   Long64_t          GetNRecursiveRemove() const;
    TSeqCollection   *GetListOfStreamerInfo() const { return fStreamerInfo; }
    TSeqCollection   *GetListOfMessageHandlers() const { return fMessageHandlers; }
    TCollection      *GetListOfClassGenerators() const { return fClassGenerators; }
@@ -301,6 +304,7 @@ public:
    Long_t            ProcessLineFast(const char *line, Int_t *error = 0);
    Bool_t            ReadingObject() const;
    void              RefreshBrowsers();
+   void              RegisterCleanup(TObject *obj, TObject *holder);
    static void       RegisterModule(const char* modulename,
                                     const char** headers,
                                     const char** includePaths,
@@ -331,10 +335,12 @@ public:
    void              SetSelectedPad(TVirtualPad *pad) { fSelectPad = pad; }
    void              SetStyle(const char *stylename = "Default");
    void              Time(Int_t casetime=1) { fTimer = casetime; }
+   void              UnregisterCleanup(TObject *obj, TObject *holder);
    Int_t             Timer() const { return fTimer; }
 
    //---- static functions
    static Int_t       DecreaseDirLevel();
+   static Bool_t      GetCleanupStat();
    static Int_t       GetDirLevel();
    static const char *GetMacroPath();
    static void        SetMacroPath(const char *newpath);
@@ -342,6 +348,7 @@ public:
    static void        IndentLevel();
    static Bool_t      Initialized();
    static Bool_t      MemCheck();
+   static void        SetCleanupStat(Bool_t stat = kTRUE);
    static void        SetDirLevel(Int_t level = 0);
    static Int_t       ConvertVersionCode2Int(Int_t code);
    static Int_t       ConvertVersionInt2Code(Int_t v);
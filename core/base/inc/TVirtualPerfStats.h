@@ -63,6 +63,11 @@ public:
 
    virtual void UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen) = 0;
 
+   // Per-branch events, ignored unless overridden (see TTreePerfStats)
+   virtual void BasketReadEvent(TObject * /*branch*/, Int_t /*complen*/, Int_t /*objlen*/,
+                                Double_t /*unzipTime*/, Bool_t /*cacheMiss*/) {}
+   virtual void StreamEvent(TObject * /*branch*/, Double_t /*start*/) {}
+
    virtual void RateEvent(Double_t proctime, Double_t deltatime,
                           Long64_t eventsprocessed, Long64_t bytesRead) = 0;
 
@@ -203,7 +203,10 @@ TApplication::TApplication(const char *appClassName, Int_t *argc, char **argv,
       Int_t buffersize = gEnv->GetValue("Root.TMemStat.buffersize", 100000);
       Int_t maxcalls   = gEnv->GetValue("Root.TMemStat.maxcalls", 5000000);
       const char *ssystem = gEnv->GetValue("Root.TMemStat.system","gnubuiltin");
-      if (maxcalls > 0) {
+      Int_t sampling   = gEnv->GetValue("Root.TMemStat.sampling", 0);
+      if (sampling > 0) {
+         gROOT->ProcessLine(Form("new TMemStat(\"%s sampling=%d\");",ssystem,sampling));
+      } else if (maxcalls > 0) {
          gROOT->ProcessLine(Form("new TMemStat(\"%s\",%d,%d);",ssystem,buffersize,maxcalls));
       }
    }
@@ -38,6 +38,18 @@ Describe directory structure in memory.
 
 ClassImp(TDirectory);
 
+namespace {
+   ////////////////////////////////////////////////////////////////////////////
+   /// Return true if obj is a histogram. Histograms remove themselves from
+   /// their directory when deleted (TH1 is not known to libCore).
+
+   Bool_t IsHistogram(const TObject *obj)
+   {
+      TClass *cl = obj->IsA();
+      return cl->GetDirectoryAutoAdd() && cl->InheritsFrom("TH1");
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Directory default constructor.
 
@@ -169,7 +181,12 @@ void TDirectory::Append(TObject *obj, Bool_t replace /* = kFALSE */)
    }
 
    fList->Add(obj);
-   obj->SetBit(kMustCleanup);
+   // The deletion of a histogram only concerns its directory: register for
+   // it rather than broadcasting it to the list of cleanups.
+   if (IsHistogram(obj))
+      gROOT->RegisterCleanup(obj, this);
+   else
+      obj->SetBit(kMustCleanup);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1078,6 +1095,8 @@ TObject *TDirectory::Remove(TObject* obj)
    TObject *p = 0;
    if (fList) {
       p = fList->Remove(obj);
+      if (p && p->TestBit(kHasCleanupHolders))
+         gROOT->UnregisterCleanup(p, this);
    }
    return p;
 }
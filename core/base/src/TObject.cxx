@@ -59,6 +59,7 @@ ClassImp(TObject);
 
 void TObject::Copy(TObject &obj) const
 {
+   UInt_t holders = obj.fBits & kHasCleanupHolders; // registrations are not copied
    obj.fUniqueID = fUniqueID;   // when really unique don't copy
    if (obj.IsOnHeap()) {        // test uses fBits so don't move next line
       obj.fBits  = fBits;
@@ -69,6 +70,7 @@ void TObject::Copy(TObject &obj) const
    }
    obj.fBits &= ~kIsReferenced;
    obj.fBits &= ~kCanDelete;
+   obj.fBits = (obj.fBits & ~kHasCleanupHolders) | holders;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -84,8 +86,8 @@ TObject::~TObject()
    if (root) {
       if (root->MustClean()) {
          if (root == this) return;
-         if (TestBit(kMustCleanup)) {
-            root->GetListOfCleanups()->RecursiveRemove(this);
+         if (TestBit(kMustCleanup | kHasCleanupHolders)) {
+            root->CallRecursiveRemove(this);
          }
       }
    }
@@ -789,9 +791,11 @@ void TObject::Streamer(TBuffer &R__b)
    UShort_t pidf;
    if (R__b.IsReading()) {
       R__b.SkipVersion(); // Version_t R__v = R__b.ReadVersion(); if (R__v) { }
+      UInt_t holders = fBits & kHasCleanupHolders; // registrations are not streamed
       R__b >> fUniqueID;
       R__b >> fBits;
       fBits |= kIsOnHeap;  // by definition de-serialized object is on heap
+      fBits = (fBits & ~kHasCleanupHolders) | holders;
       if (TestBit(kIsReferenced)) {
          //if the object is referenced, we must read its old address
          //and store it in the ProcessID map in gROOT
@@ -20,33 +20,22 @@
 Monitors objects for deletion and reflects the deletion by reverting
 the internal pointer to zero. When this pointer is zero we know the
 object has been deleted. This avoids the unsafe TestBit(kNotDeleted)
-hack. The spied object must have the kMustCleanup bit set otherwise
-you will get an error.
+hack. The object spied by a TObjectRefSpy must have the kMustCleanup
+bit set otherwise you will get an error.
 */
 
 ClassImp(TObjectSpy);
 ClassImp(TObjectRefSpy);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Register the object that must be spied. The object must have the
-/// kMustCleanup bit set. If the object has been deleted during a
-/// RecusiveRemove() operation, GetObject() will return 0.
+/// Register the object that must be spied. If the object has been deleted,
+/// GetObject() will return 0. The object does not need the kMustCleanup
+/// bit, fixMustCleanupBit is ignored.
 
 TObjectSpy::TObjectSpy(TObject *obj, Bool_t fixMustCleanupBit) :
-   TObject(), fObj(obj), fResetMustCleanupBit(kFALSE)
+   TObject(), fObj(0), fResetMustCleanupBit(kFALSE)
 {
-   {
-      R__LOCKGUARD(gROOTMutex);
-      gROOT->GetListOfCleanups()->Add(this);
-   }
-   if (fObj && !fObj->TestBit(kMustCleanup)) {
-      if (fixMustCleanupBit) {
-         fResetMustCleanupBit = kTRUE;
-         fObj->SetBit(kMustCleanup, kTRUE);
-      } else {
-         Error("TObjectSpy", "spied object must have the kMustCleanup bit set");
-      }
-   }
+   SetObject(obj, fixMustCleanupBit);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,10 +43,7 @@ TObjectSpy::TObjectSpy(TObject *obj, Bool_t fixMustCleanupBit) :
 
 TObjectSpy::~TObjectSpy()
 {
-   if (fObj && fResetMustCleanupBit)
-      fObj->SetBit(kMustCleanup, kFALSE);
-   R__LOCKGUARD(gROOTMutex);
-   gROOT->GetListOfCleanups()->Remove(this);
+   SetObject(0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -75,22 +61,18 @@ void TObjectSpy::RecursiveRemove(TObject *obj)
 ////////////////////////////////////////////////////////////////////////////////
 /// Set obj as the spy target.
 
-void TObjectSpy::SetObject(TObject *obj, Bool_t fixMustCleanupBit)
+void TObjectSpy::SetObject(TObject *obj, Bool_t /* fixMustCleanupBit */)
 {
-   if (fObj && fResetMustCleanupBit)
-      fObj->SetBit(kMustCleanup, kFALSE);
-   fResetMustCleanupBit = kFALSE;
+   if (fObj)
+      gROOT->UnregisterCleanup(fObj, this);
 
    fObj = obj;
 
-   if (fObj && !fObj->TestBit(kMustCleanup)) {
-      if (fixMustCleanupBit) {
-         fResetMustCleanupBit = kTRUE;
-         fObj->SetBit(kMustCleanup, kTRUE);
-      } else {
-         Error("TObjectSpy", "spied object must have the kMustCleanup bit set");
-      }
-   }
+   // Only the deletion of the spied object is of interest: rather than
+   // being in the list of cleanups, register for that object only. This
+   // does not need the kMustCleanup bit of the object.
+   if (fObj)
+      gROOT->RegisterCleanup(fObj, this);
 }
 
 
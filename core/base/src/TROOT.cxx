@@ -74,6 +74,11 @@ of a main program creating an interactive version is shown below:
 
 #include <string>
 #include <map>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include <stdlib.h>
 #ifdef WIN32
 #include <io.h>
@@ -126,6 +131,7 @@ char *dlerror() {
 #include "TPluginManager.h"
 #include "TMap.h"
 #include "TObjString.h"
+#include "TStopwatch.h"
 #include "TVirtualMutex.h"
 #include "TInterpreter.h"
 #include "TListOfTypes.h"
@@ -161,6 +167,132 @@ TVirtualMutex* gROOTMutex = 0;
 // For accessing TThread::Tsd indirectly.
 void **(*gThreadTsd)(void*,Int_t) = 0;
 
+namespace {
+   ////////////////////////////////////////////////////////////////////////////
+   /// Index of the objects registered with TROOT::RegisterCleanup: for each
+   /// object, the holders whose RecursiveRemove must be called when it is
+   /// deleted. The registered objects have the kHasCleanupHolders bit set,
+   /// which is changed under the lock of their shard. The index is split in shards selected by the address of the
+   /// object, each with its own mutex, so that threads registering and
+   /// deleting unrelated objects do not contend on a global lock.
+   /// The holders are called without the shard lock, since they may register,
+   /// unregister or delete objects. Meanwhile each call is recorded in the
+   /// shard, and Remove() waits until a call for the same object and holder,
+   /// running in another thread, is finished: a holder which unregisters its
+   /// objects before being destructed is never used after its destruction.
+
+   class TCleanupIndex {
+      enum { kNShards = 64 };
+
+      struct TCall {
+         const TObject  *fObj;
+         TObject        *fHolder;
+         std::thread::id fThread;
+      };
+
+      struct TShard {
+         std::mutex fMutex;
+         std::condition_variable fCond;       // signalled when a call is finished
+         std::unordered_map<const TObject*, std::vector<TObject*>> fHolders;
+         std::vector<TCall> fCalls;           // RecursiveRemove calls in flight
+      };
+
+      TShard fShards[kNShards];
+
+      TShard &GetShard(const TObject *obj)
+      {
+         return fShards[(reinterpret_cast<size_t>(obj) >> 4) % kNShards];
+      }
+
+      static Bool_t IsCalledElsewhere(const TShard &shard, const TObject *obj, const TObject *holder)
+      {
+         std::thread::id self = std::this_thread::get_id();
+         for (auto &call : shard.fCalls)
+            if (call.fObj == obj && call.fHolder == holder && call.fThread != self) return kTRUE;
+         return kFALSE;
+      }
+
+   public:
+      /// Add holder for obj. Calls setBits(obj) under the lock.
+      template <typename SetBits>
+      void Add(const TObject *obj, TObject *holder, SetBits setBits)
+      {
+         TShard &shard = GetShard(obj);
+         std::lock_guard<std::mutex> lock(shard.fMutex);
+         shard.fHolders[obj].push_back(holder);
+         setBits(obj);
+      }
+
+      /// Remove holder for obj. Calls resetBits(obj) under the lock if obj
+      /// has no holder left.
+      template <typename ResetBits>
+      void Remove(const TObject *obj, TObject *holder, ResetBits resetBits)
+      {
+         TShard &shard = GetShard(obj);
+         std::unique_lock<std::mutex> lock(shard.fMutex);
+         auto iter = shard.fHolders.find(obj);
+         if (iter != shard.fHolders.end()) {
+            auto &holders = iter->second;
+            for (auto h = holders.begin(); h != holders.end(); ++h) {
+               if (*h == holder) {
+                  holders.erase(h);
+                  break;
+               }
+            }
+            if (holders.empty()) {
+               shard.fHolders.erase(iter);
+               resetBits(obj);
+            }
+         }
+         // obj may be being deleted in another thread, which is calling holder
+         shard.fCond.wait(lock, [&] { return !IsCalledElsewhere(shard, obj, holder); });
+      }
+
+      /// Remove obj from the index and call RecursiveRemove(obj) for its
+      /// holders. Returns the number of calls.
+      Long64_t Notify(TObject *obj)
+      {
+         TShard &shard = GetShard(obj);
+         std::thread::id self = std::this_thread::get_id();
+         std::vector<TObject*> holders;
+         {
+            std::lock_guard<std::mutex> lock(shard.fMutex);
+            auto iter = shard.fHolders.find(obj);
+            if (iter == shard.fHolders.end()) return 0;
+            holders.swap(iter->second);
+            shard.fHolders.erase(iter);
+            for (auto holder : holders)
+               shard.fCalls.push_back({obj, holder, self});
+         }
+         for (auto holder : holders) {
+            if (holder->TestBit(TObject::kNotDeleted)) holder->RecursiveRemove(obj);
+            {
+               std::lock_guard<std::mutex> lock(shard.fMutex);
+               for (auto call = shard.fCalls.begin(); call != shard.fCalls.end(); ++call) {
+                  if (call->fObj == obj && call->fHolder == holder && call->fThread == self) {
+                     shard.fCalls.erase(call);
+                     break;
+                  }
+               }
+            }
+            shard.fCond.notify_all();
+         }
+         return holders.size();
+      }
+   };
+
+   TCleanupIndex &GetCleanupIndex()
+   {
+      // Never deleted: objects can be destructed after the static destructors ran.
+      static TCleanupIndex *index = new TCleanupIndex;
+      return *index;
+   }
+
+   std::atomic<Bool_t>   gCleanupStat{kFALSE};  // Count the calls below, see TROOT::SetCleanupStat
+   std::atomic<Long64_t> gNRecursiveRemove{0}; // Objects whose deletion was broadcast to the cleanups
+   std::atomic<Long64_t> gNCleanupCalls{0};    // RecursiveRemove calls made for these deletions
+}
+
 //-------- Names of next three routines are a small homage to CMZ --------------
 ////////////////////////////////////////////////////////////////////////////////
 /// Return version id as an integer, i.e. "2.22/04" -> 22204.
@@ -1895,6 +2027,7 @@ void TROOT::InitSystem()
       { TUrl dummy("/dummy"); }
 #endif
       TObject::SetObjectStat(gEnv->GetValue("Root.ObjectStat", 0));
+      SetCleanupStat(gEnv->GetValue("Root.CleanupStat", 0));
    }
 }
 
@@ -1914,6 +2047,18 @@ void TROOT::InitThreads()
 
 void TROOT::InitInterpreter()
 {
+   // Breakdown of the time spent in the different initialization steps,
+   // printed when the environment variable ROOT_STARTUP_TIMING is set.
+   const Bool_t startupTiming = gSystem->Getenv("ROOT_STARTUP_TIMING") != nullptr;
+   std::vector<std::pair<const char*, Double_t>> startupSteps;
+   TStopwatch startupTimer;
+   auto endStartupStep = [&](const char *step) {
+      if (startupTiming) {
+         startupSteps.emplace_back(step, startupTimer.RealTime());
+         startupTimer.Start();
+      }
+   };
+
    // usedToIdentifyRootClingByDlSym is available when TROOT is part of
    // rootcling.
    if (!dlsym(RTLD_DEFAULT, "usedToIdentifyRootClingByDlSym")
@@ -1955,6 +2100,8 @@ void TROOT::InitInterpreter()
    } else {
       gInterpreterLib = RTLD_DEFAULT;
    }
+   endStartupStep("load libRIO and libCling");
+
    CreateInterpreter_t *CreateInterpreter = (CreateInterpreter_t*) dlsym(gInterpreterLib, "CreateInterpreter");
    if (!CreateInterpreter) {
       TString err = dlerror();
@@ -1972,6 +2119,7 @@ void TROOT::InitInterpreter()
    }
 
    fInterpreter = CreateInterpreter(gInterpreterLib);
+   endStartupStep("create interpreter");
 
    fCleanups->Add(fInterpreter);
    fInterpreter->SetBit(kMustCleanup);
@@ -1994,16 +2142,29 @@ void TROOT::InitInterpreter()
                                    kTRUE /*lateRegistration*/);
    }
    GetModuleHeaderInfoBuffer().clear();
+   endStartupStep("register dictionaries");
 
    fInterpreter->Initialize();
+   endStartupStep("initialize interpreter");
 
    // Read the rules before enabling the auto loading to not inadvertently
    // load the libraries for the classes concerned even-though the user is
    // *not* using them.
    TClass::ReadRules(); // Read the default customization rules ...
+   endStartupStep("read I/O rules");
 
    // Enable autoloading
    fInterpreter->EnableAutoLoading();
+   endStartupStep("read rootmaps");
+
+   if (startupTiming) {
+      Double_t total = 0;
+      for (const auto &step : startupSteps) {
+         Info("InitInterpreter", "%-28s %9.1f ms", step.first, 1000. * step.second);
+         total += step.second;
+      }
+      Info("InitInterpreter", "%-28s %9.1f ms", "total", 1000. * total);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2350,6 +2511,66 @@ const char *TROOT::GetGitDate()
    return fGitDate;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Called by the TObject destructor for the objects with the kMustCleanup
+/// or kHasCleanupHolders bit set: call RecursiveRemove(obj) for the holders
+/// registered for obj with RegisterCleanup and, if kMustCleanup is set, for
+/// all the collections in the list of cleanups.
+
+void TROOT::CallRecursiveRemove(TObject *obj)
+{
+   Long64_t ncalls = 0;
+   if (obj->TestBit(TObject::kHasCleanupHolders))
+      ncalls += GetCleanupIndex().Notify(obj);
+   if (obj->TestBit(kMustCleanup)) {
+      ncalls += fCleanups->GetSize();
+      fCleanups->RecursiveRemove(obj);
+      if (gCleanupStat) ++gNRecursiveRemove;
+   }
+   if (gCleanupStat) gNCleanupCalls += ncalls;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of RecursiveRemove calls made on the holders
+/// registered with RegisterCleanup and on the collections in the list of
+/// cleanups (not counting the calls these collections make on their
+/// content), since the counting was enabled with SetCleanupStat.
+
+Long64_t TROOT::GetNCleanupCalls() const
+{
+   return gNCleanupCalls;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of object deletions which were broadcast to the list
+/// of cleanups, i.e. of objects deleted with the kMustCleanup bit set,
+/// since the counting was enabled with SetCleanupStat.
+
+Long64_t TROOT::GetNRecursiveRemove() const
+{
+   return gNRecursiveRemove;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function returning true if the cleanup calls are counted, see
+/// SetCleanupStat.
+
+Bool_t TROOT::GetCleanupStat()
+{
+   return gCleanupStat;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function enabling the counting of the cleanup calls returned by
+/// GetNRecursiveRemove and GetNCleanupCalls. It is off by default, so that
+/// the deletion of objects does not update shared counters, and can also
+/// be enabled with the resource "Root.CleanupStat".
+
+void TROOT::SetCleanupStat(Bool_t stat)
+{
+   gCleanupStat = stat;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Refresh all browsers. Call this method when some command line
 /// command or script has changed the browser contents. Not needed
@@ -2468,6 +2689,24 @@ TObject *TROOT::Remove(TObject* obj)
    return TDirectory::Remove(obj);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Register holder to be notified, via holder->RecursiveRemove(obj), when
+/// obj is deleted. Unlike adding holder to the list of cleanups, which
+/// calls it for the deletion of any object with the kMustCleanup bit set,
+/// holder is only called for the objects it registered, and obj does not
+/// need the kMustCleanup bit: unless this bit is set by other holders, the
+/// deletion of obj is not broadcast to the list of cleanups. The holder
+/// must call UnregisterCleanup for the objects it still holds when it is
+/// deleted. The registration is dropped once obj is deleted.
+
+void TROOT::RegisterCleanup(TObject *obj, TObject *holder)
+{
+   if (!obj || !holder) return;
+   GetCleanupIndex().Add(obj, holder, [](const TObject *o) {
+      const_cast<TObject *>(o)->fBits |= TObject::kHasCleanupHolders;
+   });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove a class from the list and map of classes.
 /// This routine is deprecated, use TClass::RemoveClass directly.
@@ -2477,6 +2716,22 @@ void TROOT::RemoveClass(TClass *oldcl)
    TClass::RemoveClass(oldcl);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Cancel the registration of holder for the deletion of obj, see
+/// RegisterCleanup. The kMustCleanup bit of obj is left unchanged.
+/// If obj is being deleted in another thread, waits until that thread
+/// returned from holder->RecursiveRemove(obj), so that holder can be
+/// destructed right after. Therefore RecursiveRemove of a registered
+/// holder must not wait for locks held while calling UnregisterCleanup.
+
+void TROOT::UnregisterCleanup(TObject *obj, TObject *holder)
+{
+   if (!obj || !holder) return;
+   GetCleanupIndex().Remove(obj, holder, [](const TObject *o) {
+      const_cast<TObject *>(o)->fBits &= ~TObject::kHasCleanupHolders;
+   });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete all global interpreter objects created since the last call to Reset
 ///
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+
+#include "TNamed.h"
+#include "TObjectSpy.h"
+#include "TROOT.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+// Records the objects for which it has been notified.
+class TCleanupHolder : public TObject {
+public:
+   std::vector<TObject *> fRemoved;
+   void RecursiveRemove(TObject *obj) { fRemoved.push_back(obj); }
+};
+
+// Signals when its notification started, then takes some time.
+class TSlowHolder : public TObject {
+public:
+   std::atomic<bool> fEntered{false};
+   std::atomic<bool> fFinished{false};
+   void RecursiveRemove(TObject *)
+   {
+      fEntered = true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      fFinished = true;
+   }
+};
+}
+
+TEST(TROOTCleanups, RegisteredHolderIsNotified)
+{
+   TCleanupHolder holder;
+   TNamed *obj = new TNamed("obj", "");
+   TNamed *other = new TNamed("other", "");
+   gROOT->RegisterCleanup(obj, &holder);
+   EXPECT_TRUE(obj->TestBit(TObject::kHasCleanupHolders));
+   EXPECT_FALSE(obj->TestBit(kMustCleanup));
+
+   other->SetBit(kMustCleanup);
+   delete other;
+   EXPECT_TRUE(holder.fRemoved.empty());
+
+   // Only the holder is called, the deletion is not broadcast to the cleanups
+   TROOT::SetCleanupStat(kTRUE);
+   Long64_t nremove = gROOT->GetNRecursiveRemove();
+   Long64_t ncalls = gROOT->GetNCleanupCalls();
+   delete obj;
+   TROOT::SetCleanupStat(kFALSE);
+   ASSERT_EQ(1u, holder.fRemoved.size());
+   EXPECT_EQ(obj, holder.fRemoved[0]);
+   EXPECT_EQ(nremove, gROOT->GetNRecursiveRemove());
+   EXPECT_EQ(ncalls + 1, gROOT->GetNCleanupCalls());
+}
+
+TEST(TROOTCleanups, CountOnlyWhenEnabled)
+{
+   TNamed *obj = new TNamed("obj", "");
+   obj->SetBit(kMustCleanup);
+   Long64_t nremove = gROOT->GetNRecursiveRemove();
+   delete obj;
+   EXPECT_EQ(nremove, gROOT->GetNRecursiveRemove());
+
+   TROOT::SetCleanupStat(kTRUE);
+   obj = new TNamed("obj", "");
+   obj->SetBit(kMustCleanup);
+   Long64_t ncalls = gROOT->GetNCleanupCalls();
+   delete obj;
+   TROOT::SetCleanupStat(kFALSE);
+   EXPECT_EQ(nremove + 1, gROOT->GetNRecursiveRemove());
+   EXPECT_EQ(ncalls + gROOT->GetListOfCleanups()->GetSize(), gROOT->GetNCleanupCalls());
+}
+
+TEST(TROOTCleanups, RegistrationIsNotCopied)
+{
+   TCleanupHolder holder;
+   TNamed obj("obj", "");
+   gROOT->RegisterCleanup(&obj, &holder);
+   TNamed copy(obj);
+   EXPECT_FALSE(copy.TestBit(TObject::kHasCleanupHolders));
+   TNamed assigned;
+   assigned = obj;
+   EXPECT_FALSE(assigned.TestBit(TObject::kHasCleanupHolders));
+   obj = assigned;
+   EXPECT_TRUE(obj.TestBit(TObject::kHasCleanupHolders));
+
+   gROOT->UnregisterCleanup(&obj, &holder);
+   EXPECT_FALSE(obj.TestBit(TObject::kHasCleanupHolders));
+}
+
+TEST(TROOTCleanups, UnregisteredHolderIsNotNotified)
+{
+   TCleanupHolder holder;
+   TNamed *obj = new TNamed("obj", "");
+   gROOT->RegisterCleanup(obj, &holder);
+   gROOT->UnregisterCleanup(obj, &holder);
+   delete obj;
+   EXPECT_TRUE(holder.fRemoved.empty());
+}
+
+TEST(TROOTCleanups, SpyIsNotInListOfCleanups)
+{
+   TNamed *obj = new TNamed("obj", "");
+   TObjectSpy spy(obj);
+   EXPECT_EQ(nullptr, gROOT->GetListOfCleanups()->FindObject(&spy));
+   EXPECT_EQ(obj, spy.GetObject());
+   delete obj;
+   EXPECT_EQ(nullptr, spy.GetObject());
+}
+
+TEST(TROOTCleanups, UnregisterWaitsForRunningNotification)
+{
+   TSlowHolder holder;
+   TNamed *obj = new TNamed("obj", "");
+   gROOT->RegisterCleanup(obj, &holder);
+
+   std::thread deleter([obj]() { delete obj; });
+   while (!holder.fEntered)
+      std::this_thread::yield();
+   // As a holder being destructed would do: once this returns, the holder
+   // must not be used by the deleting thread anymore.
+   gROOT->UnregisterCleanup(obj, &holder);
+   EXPECT_TRUE(holder.fFinished);
+   deleter.join();
+}
@@ -579,6 +579,7 @@ DictFuncPtr_t TClassTable::GetDictNorm(const char *cname)
 ////////////////////////////////////////////////////////////////////////////////
 /// Given the class name returns the TClassProto object for the class.
 /// (uses hash of name).
+/// The proto classes of a PCM which were not read yet are read on demand.
 
 TProtoClass *TClassTable::GetProto(const char *cname)
 {
@@ -588,13 +589,20 @@ TProtoClass *TClassTable::GetProto(const char *cname)
    }
 
    TClassRec *r = FindElement(cname);
-   if (r) return r->fProto;
+   if (r && r->fProto) return r->fProto;
+   // The proto class might be in a PCM which was not read yet.
+   const char *normname = r ? r->fName : cname;
+   if (gCling && gCling->LoadPendingProtoClasses(normname)) {
+      r = FindElementImpl(normname,kFALSE);
+      if (r) return r->fProto;
+   }
    return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Given the class normalized name returns the TClassProto object for the class.
 /// (uses hash of name).
+/// The proto classes of a PCM which were not read yet are read on demand.
 
 TProtoClass *TClassTable::GetProtoNorm(const char *cname)
 {
@@ -604,7 +612,12 @@ TProtoClass *TClassTable::GetProtoNorm(const char *cname)
    }
 
    TClassRec *r = FindElementImpl(cname,kFALSE);
-   if (r) return r->fProto;
+   if (r && r->fProto) return r->fProto;
+   // The proto class might be in a PCM which was not read yet.
+   if (gCling && gCling->LoadPendingProtoClasses(cname)) {
+      r = FindElementImpl(cname,kFALSE);
+      if (r) return r->fProto;
+   }
    return 0;
 }
 
@@ -9,6 +9,7 @@
  *************************************************************************/
 
 #include <string>
+#include <vector>
 
 namespace cling {
    class Interpreter;
@@ -32,6 +33,7 @@ namespace RootCling {
       void (*fAddEnumToROOTFile)(const char *tdname) = nullptr;
       void (*fAddAncestorPCMROOTFile)(const char *pcmName) = nullptr;
       bool (*fCloseStreamerInfoROOTFile)(bool writeEmptyRootPCM) = nullptr;
+      bool (*fGetProtoClassNamesROOTFile)(std::vector<std::string> &protoClassNames, bool &hasTypes) = nullptr;
    };
 
    struct TROOTSYSSetter {
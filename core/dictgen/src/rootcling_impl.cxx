@@ -2591,6 +2591,11 @@ int ExtractAutoloadKeys(std::list<std::string> &names,
 /// class TButton
 /// (header1.h header2.h .. headerN.h)
 /// class TMyClass
+/// pcm libMyLib_rdict.pcm
+/// pcmclass TMyClass
+/// The pcm and pcmclass lines index the proto classes stored in the ROOT PCM,
+/// so that TCling does not need to open it before one of them is used. The
+/// pcm line carries the flag "types" if the PCM also stores typedefs or enums.
 
 int CreateNewRootMapFile(const std::string &rootmapFileName,
                          const std::string &rootmapLibName,
@@ -2601,7 +2606,10 @@ int CreateNewRootMapFile(const std::string &rootmapFileName,
                          const std::list<std::string> &enNames,
                          const std::list<std::string> &varNames,
                          const HeadersDeclsMap_t &headersClassesMap,
-                         const std::unordered_set<std::string> headersToIgnore)
+                         const std::unordered_set<std::string> headersToIgnore,
+                         const std::string &pcmName,
+                         const std::vector<std::string> &pcmProtoClassNames,
+                         bool pcmHasTypes)
 {
    // Create the rootmap file from the selected classes and namespaces
    std::ofstream rootmapFile(rootmapFileName.c_str());
@@ -2688,6 +2696,14 @@ int CreateNewRootMapFile(const std::string &rootmapFileName,
                rootmapFile << "var " << autoloadKey << std::endl;
       }
 
+      // And the index of the ROOT PCM.
+      if (!pcmName.empty()) {
+         rootmapFile << "# Content of the ROOT PCM, read when one of its classes is used\n";
+         rootmapFile << "pcm " << pcmName << (pcmHasTypes ? " types" : "") << std::endl;
+         for (const auto & protoClassName : pcmProtoClassNames)
+            rootmapFile << "pcmclass " << protoClassName << std::endl;
+      }
+
    }
 
    return 0;
@@ -4958,6 +4974,15 @@ int RootClingMain(int argc,
                                               scan.fSelectedTypedefs,
                                               interp);
 
+      // The ROOT PCM is already written, index its content.
+      std::string pcmName;
+      std::vector<std::string> pcmProtoClassNames;
+      bool pcmHasTypes = false;
+      if (!onepcm && gDriverConfig->fGetProtoClassNamesROOTFile &&
+          gDriverConfig->fGetProtoClassNamesROOTFile(pcmProtoClassNames, pcmHasTypes)) {
+         pcmName = llvm::sys::path::filename(modGen.GetModuleFileName());
+      }
+
       rootclingRetCode = CreateNewRootMapFile(rootmapFileName,
                                           rootmapLibName,
                                           classesDefsList,
@@ -4967,7 +4992,10 @@ int RootClingMain(int argc,
                                           enumNames,
                                           varNames,
                                           headersClassesMap,
-                                          headersToIgnore);
+                                          headersToIgnore,
+                                          pcmName,
+                                          pcmProtoClassNames,
+                                          pcmHasTypes);
 
       if (0 != rootclingRetCode) return 1;
    }
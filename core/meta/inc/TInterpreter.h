@@ -139,6 +139,8 @@ public:
    virtual Int_t    Load(const char *filenam, Bool_t system = kFALSE) = 0;
    virtual void     LoadMacro(const char *filename, EErrorCode *error = 0) = 0;
    virtual Int_t    LoadLibraryMap(const char *rootmapfile = 0) = 0;
+   virtual Bool_t   HasPendingProtoClass(const char * /* normname */) const { return kFALSE; }
+   virtual Bool_t   LoadPendingProtoClasses(const char * /* normname */) { return kFALSE; }
    virtual Int_t    RescanLibraryMap() = 0;
    virtual Int_t    ReloadAllSharedLibraryMaps() = 0;
    virtual Int_t    UnloadAllSharedLibraryMaps() = 0;
@@ -89,6 +89,9 @@ a 'using namespace std;' has been applied to and with:
 #include <assert.h>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
 
 #ifdef WIN32
 #include <io.h>
@@ -128,6 +131,147 @@ namespace {
          fSave(ROOT::Internal::gMmallocDesc) { ROOT::Internal::gMmallocDesc = value; }
       ~TMmallocDescTemp() { ROOT::Internal::gMmallocDesc = fSave; }
    };
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Registry of the loaded classes which can be searched without taking
+   /// gInterpreterMutex.
+   ///
+   /// Open addressing hash table keyed by the spelling used for the lookup (the
+   /// name given to TClass::GetClass or the type_info name). Readers only perform
+   /// atomic loads; insertions and removals are serialized by a dedicated mutex.
+   /// Entries and replaced tables are kept until the end of the process, so that a
+   /// reader never touches released memory of the registry itself. Only classes in
+   /// the kHasTClassInit state are registered, and all entries of a class are
+   /// removed in TClass::SetUnloaded and TClass::RemoveClass, before the state
+   /// changes. Readers therefore never need to check fState or fBits.
+
+   class TLoadedClassRegistry {
+   private:
+      struct Entry {
+         UInt_t      fHash;
+         std::string fName;
+         TClass     *fClass;
+      };
+
+      struct Table {
+         size_t fMask;                                 // number of slots - 1
+         std::unique_ptr<std::atomic<Entry *>[]> fSlots;
+         explicit Table(size_t size) : fMask(size - 1), fSlots(new std::atomic<Entry *>[size])
+         {
+            for (size_t n = 0; n < size; ++n)
+               fSlots[n].store(nullptr, std::memory_order_relaxed);
+         }
+      };
+
+      std::atomic<Table *> fTable{nullptr};           // table used by the readers
+      std::mutex fWriteMutex;                         // serializes Add and Remove
+      size_t fUsed = 0;                               // used slots (including removed ones) in fTable
+      std::vector<std::unique_ptr<Table>> fTables;    // all tables ever published
+      std::vector<std::unique_ptr<Entry>> fEntries;   // all entries ever published
+      std::unordered_map<TClass *, std::vector<Entry *>> fClassEntries; // live entries per class
+      Entry fRemoved{0, "", nullptr};                 // marker of a removed slot
+
+      static UInt_t Hash(const char *name)
+      {
+         // FNV-1a
+         UInt_t hash = 2166136261u;
+         for (; *name; ++name) {
+            hash ^= (unsigned char)*name;
+            hash *= 16777619u;
+         }
+         return hash;
+      }
+
+      static void Insert(Table &table, Entry *entry)
+      {
+         size_t i = entry->fHash & table.fMask;
+         while (table.fSlots[i].load(std::memory_order_relaxed))
+            i = (i + 1) & table.fMask;
+         table.fSlots[i].store(entry, std::memory_order_release);
+      }
+
+      Table *Grow()
+      {
+         size_t live = 0;
+         for (auto &iter : fClassEntries)
+            live += iter.second.size();
+         size_t size = 256;
+         while (size < 4 * (live + 1))
+            size *= 2;
+         fTables.emplace_back(new Table(size));
+         Table *table = fTables.back().get();
+         for (auto &iter : fClassEntries)
+            for (auto entry : iter.second)
+               Insert(*table, entry);
+         fUsed = live;
+         fTable.store(table, std::memory_order_release);
+         return table;
+      }
+
+   public:
+      TClass *Find(const char *name) const
+      {
+         const Table *table = fTable.load(std::memory_order_acquire);
+         if (!table) return nullptr;
+         UInt_t hash = Hash(name);
+         for (size_t i = hash & table->fMask, cnt = 0; cnt <= table->fMask; i = (i + 1) & table->fMask, ++cnt) {
+            const Entry *entry = table->fSlots[i].load(std::memory_order_acquire);
+            if (!entry) return nullptr;
+            if (entry->fHash == hash && entry != &fRemoved && entry->fName == name)
+               return entry->fClass;
+         }
+         return nullptr;
+      }
+
+      void Add(const char *name, TClass *cl)
+      {
+         std::lock_guard<std::mutex> lock(fWriteMutex);
+         if (Find(name)) return;
+         Table *table = fTable.load(std::memory_order_relaxed);
+         if (!table || 2 * (fUsed + 1) > table->fMask + 1)
+            table = Grow();
+         fEntries.emplace_back(new Entry{Hash(name), name, cl});
+         Entry *entry = fEntries.back().get();
+         fClassEntries[cl].push_back(entry);
+         Insert(*table, entry);
+         ++fUsed;
+      }
+
+      void Remove(TClass *cl)
+      {
+         std::lock_guard<std::mutex> lock(fWriteMutex);
+         auto iter = fClassEntries.find(cl);
+         if (iter == fClassEntries.end()) return;
+         // Readers may still probe any of the former tables.
+         for (auto &table : fTables) {
+            for (auto entry : iter->second) {
+               for (size_t i = entry->fHash & table->fMask; ; i = (i + 1) & table->fMask) {
+                  Entry *slot = table->fSlots[i].load(std::memory_order_relaxed);
+                  if (!slot) break;
+                  if (slot == entry) {
+                     table->fSlots[i].store(&fRemoved, std::memory_order_release);
+                     break;
+                  }
+               }
+            }
+         }
+         fClassEntries.erase(iter);
+      }
+   };
+
+   // Registries keyed by class name and by type_info name, never deleted since
+   // classes may be looked up until the very end of the process.
+   TLoadedClassRegistry &GetLoadedClassesByName()
+   {
+      static TLoadedClassRegistry *gRegistry = new TLoadedClassRegistry;
+      return *gRegistry;
+   }
+
+   TLoadedClassRegistry &GetLoadedClassesByTypeInfo()
+   {
+      static TLoadedClassRegistry *gRegistry = new TLoadedClassRegistry;
+      return *gRegistry;
+   }
 }
 
 std::atomic<Int_t> TClass::fgClassCount;
@@ -240,6 +384,23 @@ TClass::ENewType &TClass__GetCallingNew() {
    return fgCallingNew;
 }
 
+//Class whose instances are currently being allocated by TClass::New() or
+//TClass::NewArray() on this thread (see TClass::GetClassInNew()).
+const TClass *&TClass__GetClassInNew() {
+   TTHREAD_TLS(const TClass*) fgClassInNew = 0;
+   return fgClassInNew;
+}
+
+namespace {
+   // Publish the class being created for the duration of TClass::New()
+   // and TClass::NewArray(), restoring the outer one for nested creations.
+   struct TClassInNewRAII {
+      const TClass *fOuter;
+      TClassInNewRAII(const TClass *cl) : fOuter(TClass__GetClassInNew()) { TClass__GetClassInNew() = cl; }
+      ~TClassInNewRAII() { TClass__GetClassInNew() = fOuter; }
+   };
+}
+
 struct ObjRepoValue {
    ObjRepoValue(const TClass *what, Version_t version) : fClass(what),fVersion(version) {}
    const TClass *fClass;
@@ -489,6 +650,8 @@ void TClass::RemoveClass(TClass *oldcl)
    if (!oldcl) return;
 
    R__LOCKGUARD(gInterpreterMutex);
+   GetLoadedClassesByName().Remove(oldcl);
+   GetLoadedClassesByTypeInfo().Remove(oldcl);
    gROOT->GetListOfClasses()->Remove(oldcl);
    if (oldcl->GetTypeInfo()) {
       GetIdMap()->Remove(oldcl->GetTypeInfo()->name());
@@ -2890,16 +3053,26 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
    if (strncmp(name,"class ",6)==0) name += 6;
    if (strncmp(name,"struct ",7)==0) name += 7;
 
+   // Classes already looked up and loaded are found without taking the lock.
+   // The state of the class is not read here: a class is removed from the
+   // registry in SetUnloaded() and RemoveClass() before its state changes.
+   TClass *cl = GetLoadedClassesByName().Find(name);
+   if (cl) return cl;
+
    R__LOCKGUARD(gInterpreterMutex);
 
    if (!gROOT->GetListOfClasses())  return 0;
 
-   TClass *cl = (TClass*)gROOT->GetListOfClasses()->FindObject(name);
+   cl = (TClass*)gROOT->GetListOfClasses()->FindObject(name);
 
    // Early return to release the lock without having to execute the
    // long-ish normalization.
    if (cl) {
-      if (cl->IsLoaded() || cl->TestBit(kUnloading)) return cl;
+      if (cl->IsLoaded() && !cl->TestBit(kUnloading)) {
+         GetLoadedClassesByName().Add(name, cl);
+         return cl;
+      }
+      if (cl->TestBit(kUnloading)) return cl;
 
       // We could speed-up some of the search by adding (the equivalent of)
       //
@@ -2932,6 +3105,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
       TClass *loadedcl = (dict)();
       if (loadedcl) {
          loadedcl->PostLoadCheck();
+         if (loadedcl->IsLoaded()) GetLoadedClassesByName().Add(name, loadedcl);
          return loadedcl;
       }
 
@@ -2951,7 +3125,11 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
          cl = (TClass*)gROOT->GetListOfClasses()->FindObject(normalizedName.c_str());
 
          if (cl) {
-            if (cl->IsLoaded() || cl->TestBit(kUnloading)) return cl;
+            if (cl->IsLoaded() && !cl->TestBit(kUnloading)) {
+               GetLoadedClassesByName().Add(name, cl);
+               return cl;
+            }
+            if (cl->TestBit(kUnloading)) return cl;
 
             //we may pass here in case of a dummy class created by TVirtualStreamerInfo
             load = kTRUE;
@@ -3001,7 +3179,11 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
          }
       }
    }
-   if (loadedcl) return loadedcl;
+   if (loadedcl) {
+      if (loadedcl->IsLoaded() && !loadedcl->TestBit(kUnloading))
+         GetLoadedClassesByName().Add(name, loadedcl);
+      return loadedcl;
+   }
 
    // See if the TClassGenerator can produce the TClass we need.
    loadedcl = LoadClassCustom(normalizedName.c_str(),silent);
@@ -3065,15 +3247,23 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 
 TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /* silent */)
 {
+   // Lock-free lookup of the classes already found and loaded,
+   // see GetClass(const char*) above.
+   TClass* cl = GetLoadedClassesByTypeInfo().Find(typeinfo.name());
+   if (cl) return cl;
+
    //protect access to TROOT::GetListOfClasses
    R__LOCKGUARD(gInterpreterMutex);
 
    if (!gROOT->GetListOfClasses())    return 0;
 
-   TClass* cl = GetIdMap()->Find(typeinfo.name());
+   cl = GetIdMap()->Find(typeinfo.name());
 
    if (cl) {
-      if (cl->IsLoaded()) return cl;
+      if (cl->IsLoaded()) {
+         if (!cl->TestBit(kUnloading)) GetLoadedClassesByTypeInfo().Add(typeinfo.name(), cl);
+         return cl;
+      }
       //we may pass here in case of a dummy class created by TVirtualStreamerInfo
       load = kTRUE;
    } else {
@@ -3094,7 +3284,10 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    DictFuncPtr_t dict = TClassTable::GetDict(typeinfo);
    if (dict) {
       cl = (dict)();
-      if (cl) cl->PostLoadCheck();
+      if (cl) {
+         cl->PostLoadCheck();
+         if (cl->IsLoaded()) GetLoadedClassesByTypeInfo().Add(typeinfo.name(), cl);
+      }
       return cl;
    }
    if (cl) return cl;
@@ -4705,6 +4898,7 @@ const void *TClass::DynamicCast(const TClass *cl, const void *obj, Bool_t up)
 void *TClass::New(ENewType defConstructor, Bool_t quiet) const
 {
    void* p = 0;
+   TClassInNewRAII classInNew(this);
 
    if (fNew) {
       // We have the new operator wrapper function,
@@ -4887,6 +5081,7 @@ void *TClass::New(void *arena, ENewType defConstructor) const
 void *TClass::NewArray(Long_t nElements, ENewType defConstructor) const
 {
    void* p = 0;
+   TClassInNewRAII classInNew(this);
 
    if (fNewArray) {
       // We have the new operator wrapper function,
@@ -5540,6 +5735,17 @@ TClass::ENewType TClass::IsCallingNew()
    return TClass__GetCallingNew();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Static method returning the class whose object(s) TClass::New() or
+/// TClass::NewArray() is currently creating on this thread, or 0 outside
+/// of those calls. Memory profilers (see TMemStat) use it to attribute
+/// the allocations done while an object is constructed to its class.
+
+const TClass *TClass::GetClassInNew()
+{
+   return TClass__GetClassInNew();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return true if the shared library of this class is currently in the a
 /// process's memory.  Return false, after the shared library has been
@@ -5873,6 +6079,9 @@ void TClass::SetUnloaded()
       // Don't redo the work.
       return;
    }
+   // Lock-free lookups in GetClass must not find the class anymore.
+   GetLoadedClassesByName().Remove(this);
+   GetLoadedClassesByTypeInfo().Remove(this);
    SetBit(kUnloading);
 
    //R__ASSERT(fState == kLoaded);
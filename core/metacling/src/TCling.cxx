@@ -72,6 +72,7 @@ clang/LLVM technology.
 #include "ThreadLocalStorage.h"
 #include "TFile.h"
 #include "TKey.h"
+#include "TStopwatch.h"
 #include "ClingRAII.h"
 
 #include "clang/AST/ASTContext.h"
@@ -1279,19 +1280,109 @@ static bool R__InitStreamerInfoFactory()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the proto classes of a ROOT PCM and add them to the TClassTable.
+/// If updateExisting is true, the TClass objects created before the
+/// dictionary was loaded are replaced by the ones built from the dictionary.
+
+static void LoadProtoClasses(TFile *pcmFile, const TString &pcmFileName, Bool_t updateExisting)
+{
+   TObjArray *protoClasses;
+   if (gDebug > 1)
+         ::Info("TCling::LoadPCM","reading protoclasses for %s \n",pcmFileName.Data());
+
+   pcmFile->GetObject("__ProtoClasses", protoClasses);
+
+   if (protoClasses) {
+      for (auto obj : *protoClasses) {
+         TProtoClass * proto = (TProtoClass*)obj;
+         TClassTable::Add(proto);
+      }
+      // Now that all TClass-es know how to set them up we can update
+      // existing TClasses, which might cause the creation of e.g. TBaseClass
+      // objects which in turn requires the creation of TClasses, that could
+      // come from the PCH, but maybe later in the loop. Instead of resolving
+      // a dependency graph the addition to the TClassTable above allows us
+      // to create these dependent TClasses as needed below.
+      if (updateExisting) {
+         for (auto proto : *protoClasses) {
+            if (TClass* existingCl
+                = (TClass*)gROOT->GetListOfClasses()->FindObject(proto->GetName())) {
+               // We have an existing TClass object. It might be emulated
+               // or interpreted; we now have more information available.
+               // Make that available.
+               if (existingCl->GetState() != TClass::kHasTClassInit) {
+                  DictFuncPtr_t dict = gClassTable->GetDict(proto->GetName());
+                  if (!dict) {
+                     ::Error("TCling::LoadPCM", "Inconsistent TClassTable for %s",
+                             proto->GetName());
+                  } else {
+                     // This will replace the existing TClass.
+                     TClass *ncl = (*dict)();
+                     if (ncl) ncl->PostLoadCheck();
+
+                  }
+               }
+            }
+         }
+      }
+
+      protoClasses->Clear(); // Ownership was transfered to TClassTable.
+      delete protoClasses;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the index of the ROOT PCM pcmFileName that rootcling writes in the
+/// rootmap file of the library, next to the PCM: the names of the proto
+/// classes stored in the PCM and whether it also stores typedefs or enums.
+/// Returns false if there is no such rootmap or no index for this PCM.
+
+static bool ReadPCMIndex(const TString &pcmFileName, std::vector<std::string> &protoClassNames,
+                         bool &hasTypes)
+{
+   static const char *pcmSuffix = "_rdict.pcm";
+   if (!pcmFileName.EndsWith(pcmSuffix))
+      return false;
+   TString rootmapFileName = pcmFileName(0, pcmFileName.Length() - strlen(pcmSuffix)) + ".rootmap";
+   std::ifstream file(rootmapFileName.Data());
+   if (!file)
+      return false;
+
+   // "pcm libName_rdict.pcm [types]" followed by one "pcmclass name" line per proto class.
+   const std::string pcmKey = std::string("pcm ") + gSystem->BaseName(pcmFileName);
+   std::string line;
+   bool found = false;
+   while (getline(file, line, '\n')) {
+      if (!found) {
+         if (line.compare(0, pcmKey.size(), pcmKey) == 0 &&
+             (line.size() == pcmKey.size() || line[pcmKey.size()] == ' ')) {
+            found = true;
+            hasTypes = line.find(" types", pcmKey.size()) != std::string::npos;
+         }
+      } else if (line.compare(0, 9, "pcmclass ") == 0) {
+         protoClassNames.emplace_back(line, 9);
+      } else {
+         break;
+      }
+   }
+   return found;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Tries to load a PCM; returns true on success.
 
 bool TCling::LoadPCM(TString pcmFileName,
                      const char** headers,
-                     void (*triggerFunc)()) const {
+                     void (*triggerFunc)()) {
    // pcmFileName is an intentional copy; updated by FindFile() below.
 
    TString searchPath;
+   TString libraryName;
 
    if (triggerFunc) {
-      const char *libraryName = FindLibraryName(triggerFunc);
-      if (libraryName) {
+      libraryName = FindLibraryName(triggerFunc);
+      if (libraryName.Length()) {
          searchPath = llvm::sys::path::parent_path(libraryName);
 #ifdef R__WIN32
          searchPath += ";";
@@ -1307,6 +1398,22 @@ bool TCling::LoadPCM(TString pcmFileName,
    if (!gSystem->FindFile(searchPath, pcmFileName))
       return kFALSE;
 
+   // The proto classes are the bulk of a PCM: when the rootmap of the library
+   // lists them, only remember where to find them and read them when one of
+   // them is requested (see LoadPendingProtoClasses). The PCM is then not
+   // even opened, unless it also stores typedefs or enums.
+   static const bool eagerPCM = gSystem->Getenv("ROOT_EAGER_PCM");
+   bool protoClassesDeferred = false;
+   if (!eagerPCM) {
+      std::vector<std::string> protoClassNames;
+      bool hasTypes = true;
+      if (ReadPCMIndex(pcmFileName, protoClassNames, hasTypes)) {
+         protoClassesDeferred = DeferProtoClasses(pcmFileName, libraryName, protoClassNames);
+         if (protoClassesDeferred && !hasTypes)
+            return kTRUE;
+      }
+   }
+
    // Prevent the ROOT-PCMs hitting this during auto-load during
    // JITting - which will cause recursive compilation.
    // Avoid to call the plugin manager at all.
@@ -1343,46 +1450,22 @@ bool TCling::LoadPCM(TString pcmFileName,
          return kTRUE;
       }
 
-      TObjArray *protoClasses;
-      if (gDebug > 1)
-            ::Info("TCling::LoadPCM","reading protoclasses for %s \n",pcmFileName.Data());
-
-      pcmFile->GetObject("__ProtoClasses", protoClasses);
-
-      if (protoClasses) {
-         for (auto obj : *protoClasses) {
-            TProtoClass * proto = (TProtoClass*)obj;
-            TClassTable::Add(proto);
-         }
-         // Now that all TClass-es know how to set them up we can update
-         // existing TClasses, which might cause the creation of e.g. TBaseClass
-         // objects which in turn requires the creation of TClasses, that could
-         // come from the PCH, but maybe later in the loop. Instead of resolving
-         // a dependency graph the addition to the TClassTable above allows us
-         // to create these dependent TClasses as needed below.
-         for (auto proto : *protoClasses) {
-            if (TClass* existingCl
-                = (TClass*)gROOT->GetListOfClasses()->FindObject(proto->GetName())) {
-               // We have an existing TClass object. It might be emulated
-               // or interpreted; we now have more information available.
-               // Make that available.
-               if (existingCl->GetState() != TClass::kHasTClassInit) {
-                  DictFuncPtr_t dict = gClassTable->GetDict(proto->GetName());
-                  if (!dict) {
-                     ::Error("TCling::LoadPCM", "Inconsistent TClassTable for %s",
-                             proto->GetName());
-                  } else {
-                     // This will replace the existing TClass.
-                     TClass *ncl = (*dict)();
-                     if (ncl) ncl->PostLoadCheck();
-
-                  }
-               }
-            }
+      if (!protoClassesDeferred) {
+         // Without an index in the rootmap, the PCM itself may list the names
+         // of its proto classes, one per line.
+         TObjString *protoClassNamesKey = nullptr;
+         if (!eagerPCM)
+            pcmFile->GetObject("__ProtoClassNames", protoClassNamesKey);
+         std::vector<std::string> protoClassNames;
+         if (protoClassNamesKey) {
+            std::istringstream names(protoClassNamesKey->GetString().Data());
+            std::string name;
+            while (getline(names, name, '\n'))
+               if (!name.empty()) protoClassNames.emplace_back(std::move(name));
          }
-
-         protoClasses->Clear(); // Ownership was transfered to TClassTable.
-         delete protoClasses;
+         if (!protoClassNamesKey || !DeferProtoClasses(pcmFileName, libraryName, protoClassNames))
+            LoadProtoClasses(pcmFile, pcmFileName, kTRUE);
+         delete protoClassNamesKey;
       }
 
       TObjArray *dataTypes;
@@ -1461,6 +1544,109 @@ bool TCling::LoadPCM(TString pcmFileName,
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record that the proto classes of the ROOT PCM pcmFileName, whose names are
+/// given in protoClassNames, are to be read only when one of them is first
+/// requested. libraryName is the library of the dictionary: the PCM is
+/// forgotten when it is unloaded. Returns false (and nothing is recorded) if
+/// one of these classes already has an emulated or interpreted TClass: it
+/// must then be updated right away, see LoadProtoClasses.
+
+Bool_t TCling::DeferProtoClasses(const TString &pcmFileName, const TString &libraryName,
+                                 std::vector<std::string> &protoClassNames)
+{
+   for (auto &name : protoClassNames) {
+      TClass *existingCl = (TClass*)gROOT->GetListOfClasses()->FindObject(name.c_str());
+      if (existingCl && existingCl->GetState() != TClass::kHasTClassInit)
+         return kFALSE;
+   }
+
+   const size_t ipcm = fPendingPCMs.size();
+   fPendingPCMs.push_back({pcmFileName.Data(), gSystem->BaseName(libraryName)});
+   for (auto &name : protoClassNames)
+      fPendingProtoClasses.emplace(std::move(name), ipcm);
+
+   if (gDebug > 1)
+      ::Info("TCling::LoadPCM", "deferring %d protoclasses of %s", (Int_t)protoClassNames.size(),
+             pcmFileName.Data());
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget about the deferred proto classes of the PCM with index ipcm in
+/// fPendingPCMs.
+
+void TCling::DropPendingPCM(size_t ipcm)
+{
+   fPendingPCMs[ipcm].fFileName.clear();
+   fPendingPCMs[ipcm].fLibrary.clear();
+   for (auto it = fPendingProtoClasses.begin(); it != fPendingProtoClasses.end(); ) {
+      if (it->second == ipcm)
+         it = fPendingProtoClasses.erase(it);
+      else
+         ++it;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the TProtoClass of the class with the normalized name
+/// normname is in a ROOT PCM which was not read yet.
+
+Bool_t TCling::HasPendingProtoClass(const char *normname) const
+{
+   R__LOCKGUARD(gInterpreterMutex);
+   return fPendingProtoClasses.count(normname) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// If the TProtoClass of the class with the normalized name normname is in a
+/// PCM whose proto classes were deferred, read all the proto classes of that
+/// PCM into the TClassTable. Returns true if a PCM was read.
+
+Bool_t TCling::LoadPendingProtoClasses(const char *normname)
+{
+   R__LOCKGUARD(gInterpreterMutex);
+
+   if (fPendingProtoClasses.empty())
+      return kFALSE;
+   auto iter = fPendingProtoClasses.find(normname);
+   if (iter == fPendingProtoClasses.end())
+      return kFALSE;
+
+   // Forget about the PCM first: reading it can trigger requests for the
+   // proto classes of the classes it contains.
+   const size_t ipcm = iter->second;
+   TString pcmFileName = fPendingPCMs[ipcm].fFileName.c_str();
+   DropPendingPCM(ipcm);
+
+   static const bool startupTiming = gSystem->Getenv("ROOT_STARTUP_TIMING");
+   TStopwatch timer;
+
+   R__InitStreamerInfoFactory();
+   Int_t oldDebug = gDebug;
+   if (gDebug > 5) {
+      gDebug -= 5;
+      ::Info("TCling::LoadPendingProtoClasses", "Loading protoclasses of ROOT PCM %s for %s",
+             pcmFileName.Data(), normname);
+   } else {
+      gDebug = 0;
+   }
+   {
+      TDirectory::TContext ctxt;
+      TFile *pcmFile = new TFile(pcmFileName+"?filetype=pcm","READ");
+      // The TClass objects created since the PCM was deferred already
+      // used the dictionary: no need to replace them.
+      LoadProtoClasses(pcmFile, pcmFileName, kFALSE);
+      delete pcmFile;
+   }
+   gDebug = oldDebug;
+
+   if (startupTiming)
+      ::Info("TCling::LoadPendingProtoClasses", "%s: read protoclasses of %s in %.1f ms",
+             normname, pcmFileName.Data(), 1000. * timer.RealTime());
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 
 namespace {
@@ -6046,6 +6232,21 @@ void TCling::LibraryLoaded(const void* dyLibHandle, const char* canonicalName) {
 void TCling::LibraryUnloaded(const void* dyLibHandle, const char* canonicalName) {
    fPrevLoadedDynLibInfo = 0;
    fSharedLibs = "";
+
+   // The proto classes of a deferred PCM must not be read once the
+   // dictionary they describe is gone.
+   if (!canonicalName || fPendingPCMs.empty())
+      return;
+   R__LOCKGUARD(gInterpreterMutex);
+   const TString library = gSystem->BaseName(canonicalName);
+   for (size_t ipcm = 0; ipcm < fPendingPCMs.size(); ++ipcm) {
+      if (!fPendingPCMs[ipcm].fFileName.empty() && library == fPendingPCMs[ipcm].fLibrary.c_str()) {
+         if (gDebug > 1)
+            ::Info("TCling::LibraryUnloaded", "dropping the deferred protoclasses of %s",
+                   fPendingPCMs[ipcm].fFileName.c_str());
+         DropPendingPCM(ipcm);
+      }
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -108,6 +108,12 @@ private: // Data Members
    std::set<const char*> fParsedPayloadsAddresses; // Set of payloads which were parsed
    std::hash<std::string> fStringHashFunction; // A simple hashing function
    std::unordered_set<const clang::NamespaceDecl*> fNSFromRootmaps;   // Collection of namespaces fwd declared in the rootmaps
+   struct PendingPCM_t {
+      std::string fFileName; // ROOT PCM file, empty once read or dropped
+      std::string fLibrary;  // File name of the library of the dictionary, empty if unknown
+   };
+   std::vector<PendingPCM_t> fPendingPCMs; // ROOT PCMs whose proto classes have not been read yet
+   std::unordered_map<std::string,size_t> fPendingProtoClasses; // Not yet read proto classes and the index of their PCM in fPendingPCMs
    TObjArray*      fRootmapFiles;     // Loaded rootmap files.
    Bool_t          fLockProcessLine;  // True if ProcessLine should lock gInterpreterMutex.
    Bool_t          fAllowLibLoad;     // True if library load is allowed (i.e. not in rootcling)
@@ -189,6 +195,8 @@ public: // Public Interface
    Int_t   Load(const char* filenam, Bool_t system = kFALSE);
    void    LoadMacro(const char* filename, EErrorCode* error = 0);
    Int_t   LoadLibraryMap(const char* rootmapfile = 0);
+   Bool_t  HasPendingProtoClass(const char* normname) const;
+   Bool_t  LoadPendingProtoClasses(const char* normname);
    Int_t   RescanLibraryMap();
    Int_t   ReloadAllSharedLibraryMaps();
    Int_t   UnloadAllSharedLibraryMaps();
@@ -536,7 +544,10 @@ private: // Private Utility Functions and Classes
    void AddFriendToClass(clang::FunctionDecl*, clang::CXXRecordDecl*) const;
 
    bool LoadPCM(TString pcmFileName, const char** headers,
-                void (*triggerFunc)()) const;
+                void (*triggerFunc)());
+   Bool_t DeferProtoClasses(const TString &pcmFileName, const TString &libraryName,
+                            std::vector<std::string> &protoClassNames);
+   void DropPendingPCM(size_t ipcm);
    void InitRootmapFile(const char *name);
    int  ReadRootmapFile(const char *rootmapfile, TUniqueString* uniqueString = nullptr);
    Bool_t HandleNewTransaction(const cling::Transaction &T);
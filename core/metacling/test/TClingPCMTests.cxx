@@ -0,0 +1,86 @@
+#include "TClass.h"
+#include "TInterpreter.h"
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+
+// These tests check that the content of the ROOT PCMs (the TProtoClasses) is
+// only read when one of its classes is used, and that the resulting TClass is
+// the same as with an eagerly loaded PCM (ROOT_EAGER_PCM).
+
+TEST(TClingPCM, DeferredProtoClasses)
+{
+   if (gSystem->Getenv("ROOT_EAGER_PCM"))
+      return;
+
+   ASSERT_GE(gSystem->Load("libHist"), 0);
+
+   // Registering the library did not read its proto classes.
+   EXPECT_TRUE(gInterpreter->HasPendingProtoClass("TH1F"));
+   EXPECT_TRUE(gInterpreter->HasPendingProtoClass("TAxis"));
+   EXPECT_EQ(gROOT->GetListOfClasses()->FindObject("TH1F"), nullptr);
+
+   // Unrelated classes do not trigger the loading of libHist's PCM.
+   EXPECT_NE(TClass::GetClass("TNamed"), nullptr);
+   EXPECT_NE(TClass::GetClass("TObjString"), nullptr);
+   EXPECT_TRUE(gInterpreter->HasPendingProtoClass("TH1F"));
+   EXPECT_TRUE(gInterpreter->HasPendingProtoClass("TAxis"));
+
+   // The first use reads the whole PCM.
+   TClass *cl = TClass::GetClass("TH1F");
+   ASSERT_NE(cl, nullptr);
+   EXPECT_TRUE(cl->IsLoaded());
+   EXPECT_FALSE(gInterpreter->HasPendingProtoClass("TH1F"));
+   EXPECT_FALSE(gInterpreter->HasPendingProtoClass("TAxis"));
+}
+
+TEST(TClingPCM, EagerPCMSameClasses)
+{
+   TString rootexe = TROOT::GetBinDir() + "/root.exe";
+   if (gSystem->AccessPathName(rootexe))
+      return;
+
+   // Print what TClass knows about a few classes of libHist.
+   TString macro = TString::Format("%s/TClingPCMSignature_%d.C", gSystem->TempDirectory(), gSystem->GetPid());
+   {
+      std::ofstream out(macro.Data());
+      out << R"cpp(
+void TClingPCMSignature_Print(const char *name)
+{
+   TClass *cl = TClass::GetClass(name);
+   if (!cl) {
+      printf("%s missing\n", name);
+      return;
+   }
+   printf("%s size %d checksum %u\n", name, cl->Size(), cl->GetCheckSum());
+   TIter nextBase(cl->GetListOfBases());
+   while (TBaseClass *base = (TBaseClass *)nextBase())
+      printf("  base %s delta %d\n", base->GetName(), cl->GetBaseClassOffset(base->GetClassPointer()));
+   TIter nextMember(cl->GetListOfDataMembers());
+   while (TDataMember *dm = (TDataMember *)nextMember())
+      printf("  member %s %s offset %d\n", dm->GetTrueTypeName(), dm->GetName(), (int)dm->GetOffset());
+   cl->BuildRealData();
+   printf("  realdata %d\n", cl->GetListOfRealData()->GetSize());
+   printf("  streamerinfo checksum %u\n", cl->GetStreamerInfo()->GetCheckSum());
+}
+)cpp";
+      out << "void TClingPCMSignature_" << gSystem->GetPid() << "()\n{\n";
+      for (const char *name : {"TH1F", "TAxis", "TH2D", "TProfile", "TGraphErrors"})
+         out << "   TClingPCMSignature_Print(\"" << name << "\");\n";
+      out << "}\n";
+   }
+
+   TString cmd = rootexe + " -l -b -q " + macro;
+   TString deferred = gSystem->GetFromPipe(cmd);
+   gSystem->Setenv("ROOT_EAGER_PCM", "1");
+   TString eager = gSystem->GetFromPipe(cmd);
+   gSystem->Unsetenv("ROOT_EAGER_PCM");
+   gSystem->Unlink(macro);
+
+   EXPECT_FALSE(deferred.Contains("missing"));
+   EXPECT_TRUE(deferred.Contains("TH1F size"));
+   EXPECT_EQ(deferred, eager);
+}
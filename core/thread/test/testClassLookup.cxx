@@ -0,0 +1,53 @@
+#include "TClass.h"
+#include "TROOT.h"
+#include "TNamed.h"
+#include "TObjString.h"
+#include "TList.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+TEST(ClassLookup, ConcurrentGetClass)
+{
+   ROOT::EnableThreadSafety();
+
+   const char *names[] = {"TNamed", "TObjString", "TList", "class TNamed", "struct TList"};
+   TClass *expected[] = {TNamed::Class(), TObjString::Class(), TList::Class(), TNamed::Class(), TList::Class()};
+
+   std::atomic<int> failures(0);
+   auto lookup = [&]() {
+      for (int n = 0; n < 20000; ++n) {
+         int i = n % 5;
+         if (TClass::GetClass(names[i]) != expected[i]) ++failures;
+         if (TClass::GetClass(typeid(TNamed)) != TNamed::Class()) ++failures;
+         if (TClass::GetClass("NotExistingClassForLookupTest", kFALSE, kTRUE)) ++failures;
+      }
+   };
+
+   std::vector<std::thread> threads;
+   for (int i = 0; i < 8; ++i)
+      threads.emplace_back(lookup);
+   for (auto &th : threads)
+      th.join();
+
+   EXPECT_EQ(0, failures.load());
+}
+
+TEST(ClassLookup, NormalizedName)
+{
+   ROOT::EnableThreadSafety();
+
+   // The second lookups use the registry of the already loaded classes.
+   for (int n = 0; n < 2; ++n) {
+      TClass *cl = TClass::GetClass("vector<Int_t>");
+      ASSERT_NE(nullptr, cl);
+      EXPECT_STREQ("vector<int>", cl->GetName());
+      EXPECT_EQ(cl, TClass::GetClass("vector<int>"));
+      EXPECT_EQ(cl, TClass::GetClass(typeid(std::vector<int>)));
+   }
+}
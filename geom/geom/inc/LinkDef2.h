@@ -26,6 +26,7 @@
 #pragma link C++ class TGeoPatternHoneycomb+;
 #pragma link C++ class TGeoNodeCache+;
 #pragma link C++ class TGeoCacheState+;
+#pragma link C++ class TGeoTouchableCache+;
 #pragma link C++ class TVirtualMagField+;
 #pragma link C++ class TGeoUniformMagField+;
 #pragma link C++ class TGeoGlobalMagField;
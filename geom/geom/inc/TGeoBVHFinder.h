@@ -0,0 +1,57 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoBVHFinder
+#define ROOT_TGeoBVHFinder
+
+#include "TGeoVoxelFinder.h"
+
+#include <vector>
+
+class TGeoBVHFinder : public TGeoVoxelFinder
+{
+public:
+enum EBVHConstants {
+   kBVHMaxLeafSize = 4,              // leaves are never split below this size
+   kBVHMaxDepth    = 48,             // depth limit (bounds the traversal stack)
+   kBVHNbins       = 16              // number of SAH bins per axis
+};
+
+protected:
+   Int_t                 fNnodes;    // number of BVH nodes
+   std::vector<Double_t> fBVHBox;    // per node: xmin,ymin,zmin,xmax,ymax,zmax
+   std::vector<Int_t>    fBVHFirst;  // per node: first item (leaf) or index of the right child (internal)
+   std::vector<Int_t>    fBVHCount;  // per node: number of items (leaf) or 0 (internal)
+   std::vector<Int_t>    fBVHItems;  // daughter indices ordered by leaf
+
+   TGeoBVHFinder(const TGeoBVHFinder&);
+   TGeoBVHFinder& operator=(const TGeoBVHFinder&);
+
+   void                BuildBVH();
+   Int_t               BuildNode(Int_t begin, Int_t end, Int_t depth, const Double_t *centers);
+   Bool_t              IntersectNode(Int_t inode, const Double_t *point, const Double_t *invdir, Double_t &tnear) const;
+
+public :
+   TGeoBVHFinder();
+   TGeoBVHFinder(TGeoVolume *vol);
+   virtual ~TGeoBVHFinder();
+   virtual Double_t    Efficiency();
+   virtual Int_t      *GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td);
+   virtual Int_t      *GetNextCandidates(const Double_t *point, Int_t &ncheck, TGeoStateInfo &td);
+   virtual Int_t      *GetNextVoxel(const Double_t *point, const Double_t *dir, Int_t &ncheck, TGeoStateInfo &td);
+   Int_t               GetNnodes() const {return fNnodes;}
+   virtual void        Print(Option_t *option="") const;
+   virtual void        SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td);
+   virtual void        Voxelize(Option_t *option="");
+
+   ClassDef(TGeoBVHFinder, 1)                // bounding volume hierarchy finder
+};
+
+#endif
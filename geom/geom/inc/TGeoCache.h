@@ -50,6 +50,49 @@ public:
    ClassDef(TGeoCacheState, 0)       // class storing the cache state
 };
 
+class TGeoTouchableCache : public TObject
+{
+protected:
+   Int_t                fSize;          // number of entries (power of 2)
+   Int_t                fMaxLevels;     // maximum number of levels for a stored branch
+   Double_t             fReuseFraction; // maximum drift from the stored point, as fraction of the stored safety
+   Long64_t             fNlookups;      // number of safety lookups
+   Long64_t             fNhits;         // number of lookups served from the cache
+   Long64_t             fNstores;       // number of stored safety values
+   Long64_t             fNreplaced;     // number of entries replaced by a different branch
+   Int_t               *fLevels;        //! level of the branch stored in each entry (-1 if free)
+   TGeoNode           **fNodes;         //! branches of nodes, fMaxLevels per entry
+   Double_t            *fPoints;        //! points for which the safety was computed (master frame)
+   Double_t            *fSafeties;      //! safety values computed at fPoints
+
+   TGeoTouchableCache(const TGeoTouchableCache&);
+   TGeoTouchableCache& operator=(const TGeoTouchableCache&);
+
+   Int_t                GetSlot(TGeoNode **branch, Int_t level) const;
+   Bool_t               IsStored(Int_t slot, TGeoNode **branch, Int_t level) const;
+
+public:
+   TGeoTouchableCache();
+   TGeoTouchableCache(Int_t maxlevels, Int_t size=4096);
+   virtual ~TGeoTouchableCache();
+
+   virtual void         Clear(Option_t *option="");
+   Long64_t             GetNhits() const         {return fNhits;}
+   Long64_t             GetNlookups() const      {return fNlookups;}
+   Long64_t             GetNreplaced() const     {return fNreplaced;}
+   Long64_t             GetNstores() const       {return fNstores;}
+   Int_t                GetNused() const;
+   Double_t             GetReuseFraction() const {return fReuseFraction;}
+   Bool_t               GetSafety(TGeoNode **branch, Int_t level, const Double_t *point, Double_t &safe);
+   Int_t                GetSize() const          {return fSize;}
+   virtual void         Print(Option_t *option="") const;
+   void                 ResetStats() {fNlookups = fNhits = fNstores = fNreplaced = 0;}
+   void                 SetReuseFraction(Double_t fraction) {fReuseFraction = fraction;}
+   void                 SetSafety(TGeoNode **branch, Int_t level, const Double_t *point, Double_t safe);
+
+   ClassDef(TGeoTouchableCache, 0)   // cache of safety values per touchable
+};
+
 class TGeoNodeCache : public TObject
 {
 private:
@@ -40,6 +40,7 @@ protected:
    Int_t                 GetTouchedCluster(Int_t start, Double_t *point, Int_t *check_list,
                                            Int_t ncheck, Int_t *result);
    TGeoNode             *CrossDivisionCell();
+   Double_t              ComputeSafety(Bool_t inside);
    void                  SafetyOverlaps();
 
 private :
@@ -82,6 +83,7 @@ private :
    TGeoHMatrix          *fCurrentMatrix;    //! current stored global matrix
    TGeoHMatrix          *fGlobalMatrix;     //! current pointer to cached global matrix
    TGeoHMatrix          *fDivMatrix;        //! current local matrix of the selected division cell
+   TGeoTouchableCache   *fTouchables;       //! cache of safety values per touchable
    TString               fPath;             //! path to current node
 
 public :
@@ -107,6 +109,9 @@ public :
    TGeoNode              *FindNextBoundary(Double_t stepmax=TGeoShape::Big(),const char *path="", Bool_t frombdr=kFALSE);
    TGeoNode              *FindNextDaughterBoundary(Double_t *point, Double_t *dir, Int_t &idaughter, Bool_t compmatrix=kFALSE);
    TGeoNode              *FindNextBoundaryAndStep(Double_t stepmax=TGeoShape::Big(), Bool_t compsafe=kFALSE);
+   void                   FindNextBoundaryN(Int_t ntracks, const Double_t *x, const Double_t *y, const Double_t *z,
+                                            const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                            Double_t *steps, Int_t *idaughter, Double_t stepmax=TGeoShape::Big()) const;
    TGeoNode              *FindNode(Bool_t safe_start=kTRUE);
    TGeoNode              *FindNode(Double_t x, Double_t y, Double_t z);
    Double_t              *FindNormal(Bool_t forward=kTRUE);
@@ -116,6 +121,7 @@ public :
    void                   ResetState();
    void                   ResetAll();
    Double_t               Safety(Bool_t inside=kFALSE);
+   void                   SafetyN(Int_t ntracks, const Double_t *x, const Double_t *y, const Double_t *z, Double_t *safe) const;
    TGeoNode              *SearchNode(Bool_t downwards=kFALSE, const TGeoNode *skipnode=0);
    TGeoNode              *Step(Bool_t is_geom=kTRUE, Bool_t cross=kTRUE);
    const Double_t        *GetLastPoint() const {return fLastPoint;}
@@ -127,12 +133,15 @@ public :
    Double_t               GetStep() const              {return fStep;}
    Int_t                  GetThreadId() const          {return fThreadId;}
    void                   InspectState() const;
+   void                   PrintStats() const;
    Bool_t                 IsSafeStep(Double_t proposed, Double_t &newsafety) const;
+   Bool_t                 IsUsingStateCache() const {return (fTouchables)?kTRUE:kFALSE;}
    Bool_t                 IsSameLocation(Double_t x, Double_t y, Double_t z, Bool_t change=kFALSE);
    Bool_t                 IsSameLocation() const {return fIsSameLocation;}
    Bool_t                 IsSamePoint(Double_t x, Double_t y, Double_t z) const;
    Bool_t                 IsStartSafe() const {return fStartSafe;}
    void                   SetStartSafe(Bool_t flag=kTRUE)   {fStartSafe=flag;}
+   void                   SetStateCache(Bool_t flag=kTRUE, Int_t size=4096);
    void                   SetStep(Double_t step) {fStep=step;}
    Bool_t                 IsCheckingOverlaps() const   {return fSearchOverlaps;}
    Bool_t                 IsCurrentOverlapping() const {return fCurrentOverlapping;}
@@ -191,6 +200,8 @@ public :
    void                   MasterToTop(const Double_t *master, Double_t *top) const;
    void                   TopToMaster(const Double_t *top, Double_t *master) const;
    TGeoNodeCache         *GetCache() const         {return fCache;}
+   TGeoTouchableCache    *GetStateCache() const    {return fTouchables;}
+   void                   ClearStateCache()        {if (fTouchables) fTouchables->Clear();}
 //   void                   SetCache(const TGeoNodeCache *cache) {fCache = (TGeoNodeCache*)cache;}
    //--- stack manipulation
    Int_t                  PushPath(Int_t startlevel=0) {return fCache->PushState(fCurrentOverlapping, startlevel, fNmany);}
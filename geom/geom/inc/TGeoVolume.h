@@ -65,6 +65,7 @@ protected :
    Int_t              fNumber;         //  volume serial number in the list of volumes
    Int_t              fNtotal;         // total number of physical nodes
    Int_t              fRefCount;       // reference counter
+   Bool_t             fUseBVH;         // use a bounding volume hierarchy instead of voxels
    TGeoExtension     *fUserExtension;  //! Transient user-defined extension to volumes
    TGeoExtension     *fFWExtension;    //! Transient framework-defined extension to volumes
 
@@ -151,6 +152,7 @@ public:
    Bool_t          IsSelected() const  {return TObject::TestBit(kVolumeSelected);}
    Bool_t          IsCylVoxels() const {return TObject::TestBit(kVoxelsCyl);}
    Bool_t          IsXYZVoxels() const {return TObject::TestBit(kVoxelsXYZ);}
+   Bool_t          IsUsingBVH() const {return fUseBVH;}
    Bool_t          IsTopVolume() const;
    Bool_t          IsValid() const {return fShape->IsValid();}
    virtual Bool_t  IsVisible() const {return TGeoAtt::IsVisible();}
@@ -214,6 +216,7 @@ public:
    void            SetReplicated() {TObject::SetBit(kVolumeReplicated);}
    void            SetCurrentPoint(Double_t x, Double_t y, Double_t z);
    void            SetCylVoxels(Bool_t flag=kTRUE) {TObject::SetBit(kVoxelsCyl, flag); TObject::SetBit(kVoxelsXYZ, !flag);}
+   void            SetUseBVH(Bool_t flag=kTRUE) {fUseBVH = flag;}
    void            SetNodes(TObjArray *nodes) {fNodes = nodes; TObject::SetBit(kVolumeImportNodes);}
    void            SetOverlappingCandidate(Bool_t flag) {TObject::SetBit(kVolumeOC,flag);}
    void            SetShape(const TGeoShape *shape);
@@ -243,7 +246,7 @@ public:
    Double_t        Weight(Double_t precision=0.01, Option_t *option="va"); // *MENU*
    Double_t        WeightA() const;
 
-   ClassDef(TGeoVolume, 6)              // geometry volume descriptor
+   ClassDef(TGeoVolume, 7)              // geometry volume descriptor
 };
 
 ////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,490 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TGeoBVHFinder
+\ingroup Geometry_classes
+
+Finder class organizing the daughters of a volume in a bounding volume
+hierarchy instead of voxels.
+
+The hierarchy is built over the daughter bounding boxes computed by
+TGeoVoxelFinder::BuildVoxelLimits, using a binned surface area heuristic,
+and is stored as a flat array of nodes in depth-first order: the left child
+of an internal node immediately follows it, while the index of the right
+child is stored in the node. Contrary to the voxel slices, the cost of
+building and querying the hierarchy does not depend on how the daughters
+are distributed along the axes, which makes it a better choice for volumes
+with thousands of unevenly distributed daughters.
+
+The finder is selected per volume before closing the geometry:
+
+~~~ {.cpp}
+   vol->SetUseBVH();
+~~~
+
+Point queries (GetCheckList) return the daughters whose bounding box
+contains the point. Ray queries (SortCrossedVoxels/GetNextVoxel) return in a
+single batch all daughters whose bounding box is crossed by the ray, ordered
+front to back at node level, so that the navigator shrinks its step as early
+as possible.
+*/
+
+#include "TGeoBVHFinder.h"
+
+#include "TBuffer.h"
+#include "TMath.h"
+#include "TGeoBBox.h"
+#include "TGeoNode.h"
+#include "TGeoVolume.h"
+#include "TGeoStateInfo.h"
+
+#include <algorithm>
+
+ClassImp(TGeoBVHFinder);
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Half of the surface of a box given by its min/max corners.
+
+inline Double_t HalfArea(const Double_t *box)
+{
+   Double_t dx = box[3]-box[0];
+   Double_t dy = box[4]-box[1];
+   Double_t dz = box[5]-box[2];
+   return dx*dy + dy*dz + dz*dx;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset a min/max box to an empty one.
+
+inline void ResetBox(Double_t *box)
+{
+   box[0] = box[1] = box[2] = TGeoShape::Big();
+   box[3] = box[4] = box[5] = -TGeoShape::Big();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Grow a min/max box to include another one.
+
+inline void MergeBox(Double_t *box, const Double_t *other)
+{
+   for (Int_t i=0; i<3; i++) {
+      box[i]   = TMath::Min(box[i], other[i]);
+      box[i+3] = TMath::Max(box[i+3], other[i+3]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert the daughter box stored as (dx,dy,dz,ox,oy,oz) to min/max corners.
+
+inline void DaughterBox(const Double_t *boxes, Int_t id, Double_t *box)
+{
+   const Double_t *b = &boxes[6*id];
+   for (Int_t i=0; i<3; i++) {
+      box[i]   = b[i+3]-b[i];
+      box[i+3] = b[i+3]+b[i];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check if a min/max box contains the point.
+
+inline Bool_t BoxContains(const Double_t *box, const Double_t *point)
+{
+   return (point[0]>=box[0] && point[0]<=box[3] &&
+           point[1]>=box[1] && point[1]<=box[4] &&
+           point[2]>=box[2] && point[2]<=box[5]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Slab test of a ray against a min/max box. Returns the entry distance in
+/// tnear (negative if the point is inside). Components of the direction
+/// smaller than 1E-10 are flagged by a null inverse.
+
+inline Bool_t BoxCrossed(const Double_t *box, const Double_t *point, const Double_t *invdir, Double_t &tnear)
+{
+   Double_t tmin = -TGeoShape::Big();
+   Double_t tmax = TGeoShape::Big();
+   for (Int_t i=0; i<3; i++) {
+      if (invdir[i] == 0) {
+         if (point[i]<box[i] || point[i]>box[i+3]) return kFALSE;
+         continue;
+      }
+      Double_t t1 = (box[i]-point[i])*invdir[i];
+      Double_t t2 = (box[i+3]-point[i])*invdir[i];
+      if (t1 > t2) std::swap(t1, t2);
+      if (t1 > tmin) tmin = t1;
+      if (t2 < tmax) tmax = t2;
+   }
+   tnear = tmin;
+   return (tmin <= tmax+TGeoShape::Tolerance() && tmax >= -TGeoShape::Tolerance());
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor
+
+TGeoBVHFinder::TGeoBVHFinder()
+              :TGeoVoxelFinder(),
+               fNnodes(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor for the daughters of vol
+
+TGeoBVHFinder::TGeoBVHFinder(TGeoVolume *vol)
+              :TGeoVoxelFinder(vol),
+               fNnodes(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///copy constructor
+
+TGeoBVHFinder::TGeoBVHFinder(const TGeoBVHFinder& vf) :
+  TGeoVoxelFinder(vf),
+  fNnodes(vf.fNnodes),
+  fBVHBox(vf.fBVHBox),
+  fBVHFirst(vf.fBVHFirst),
+  fBVHCount(vf.fBVHCount),
+  fBVHItems(vf.fBVHItems)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///assignment operator
+
+TGeoBVHFinder& TGeoBVHFinder::operator=(const TGeoBVHFinder& vf)
+{
+   if(this!=&vf) {
+      TGeoVoxelFinder::operator=(vf);
+      fNnodes=vf.fNnodes;
+      fBVHBox=vf.fBVHBox;
+      fBVHFirst=vf.fBVHFirst;
+      fBVHCount=vf.fBVHCount;
+      fBVHItems=vf.fBVHItems;
+   }
+   return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+TGeoBVHFinder::~TGeoBVHFinder()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the hierarchy over the daughter bounding boxes.
+
+void TGeoBVHFinder::BuildBVH()
+{
+   fNnodes = 0;
+   fBVHBox.clear();
+   fBVHFirst.clear();
+   fBVHCount.clear();
+   fBVHItems.clear();
+   Int_t nd = fVolume->GetNdaughters();
+   if (!nd || !fBoxes) return;
+   fBVHItems.resize(nd);
+   std::vector<Double_t> centers(3*nd);
+   for (Int_t id=0; id<nd; id++) {
+      fBVHItems[id] = id;
+      centers[3*id]   = fBoxes[6*id+3];
+      centers[3*id+1] = fBoxes[6*id+4];
+      centers[3*id+2] = fBoxes[6*id+5];
+   }
+   fBVHBox.reserve(12*nd);
+   fBVHFirst.reserve(2*nd);
+   fBVHCount.reserve(2*nd);
+   BuildNode(0, nd, 0, &centers[0]);
+   fNnodes = fBVHCount.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the node holding the items in [begin,end) and split it recursively
+/// along the plane minimizing the surface area heuristic. Returns the node index.
+
+Int_t TGeoBVHFinder::BuildNode(Int_t begin, Int_t end, Int_t depth, const Double_t *centers)
+{
+   Int_t inode = fBVHCount.size();
+   fBVHFirst.push_back(begin);
+   fBVHCount.push_back(end-begin);
+   Double_t box[6], cbox[6], dbox[6];
+   ResetBox(box);
+   ResetBox(cbox);
+   for (Int_t i=begin; i<end; i++) {
+      Int_t id = fBVHItems[i];
+      DaughterBox(fBoxes, id, dbox);
+      MergeBox(box, dbox);
+      for (Int_t k=0; k<3; k++) {
+         cbox[k]   = TMath::Min(cbox[k], centers[3*id+k]);
+         cbox[k+3] = TMath::Max(cbox[k+3], centers[3*id+k]);
+      }
+   }
+   fBVHBox.insert(fBVHBox.end(), box, box+6);
+   Int_t n = end-begin;
+   if (n <= kBVHMaxLeafSize || depth >= kBVHMaxDepth) return inode;
+
+   // Binned SAH: find the best split plane among the bin boundaries on all axes
+   Double_t bestcost = TGeoShape::Big();
+   Int_t bestaxis = -1;
+   Int_t bestbin = 0;
+   Int_t    nbin[kBVHNbins];
+   Double_t bbin[kBVHNbins][6];
+   Double_t rarea[kBVHNbins];
+   Int_t    rcount[kBVHNbins];
+   for (Int_t iaxis=0; iaxis<3; iaxis++) {
+      Double_t extent = cbox[iaxis+3]-cbox[iaxis];
+      if (extent < TGeoShape::Tolerance()) continue;
+      Double_t scale = kBVHNbins/extent;
+      for (Int_t ib=0; ib<kBVHNbins; ib++) {
+         nbin[ib] = 0;
+         ResetBox(bbin[ib]);
+      }
+      for (Int_t i=begin; i<end; i++) {
+         Int_t id = fBVHItems[i];
+         Int_t ib = TMath::Min(Int_t((centers[3*id+iaxis]-cbox[iaxis])*scale), kBVHNbins-1);
+         nbin[ib]++;
+         DaughterBox(fBoxes, id, dbox);
+         MergeBox(bbin[ib], dbox);
+      }
+      // sweep from the right to get the cost of the right side of each plane
+      Double_t acc[6];
+      ResetBox(acc);
+      Int_t nacc = 0;
+      for (Int_t ib=kBVHNbins-1; ib>0; ib--) {
+         nacc += nbin[ib];
+         MergeBox(acc, bbin[ib]);
+         rcount[ib] = nacc;
+         rarea[ib] = nacc ? HalfArea(acc) : 0.;
+      }
+      // sweep from the left and evaluate the planes
+      ResetBox(acc);
+      nacc = 0;
+      for (Int_t ib=0; ib<kBVHNbins-1; ib++) {
+         nacc += nbin[ib];
+         MergeBox(acc, bbin[ib]);
+         if (!nacc || !rcount[ib+1]) continue;
+         Double_t cost = nacc*HalfArea(acc) + rcount[ib+1]*rarea[ib+1];
+         if (cost < bestcost) {
+            bestcost = cost;
+            bestaxis = iaxis;
+            bestbin = ib;
+         }
+      }
+   }
+   if (bestaxis < 0) return inode;
+   // Keep small nodes as leaves when splitting does not pay off, taking the
+   // traversal cost equal to the cost of checking one bounding box
+   Double_t area = HalfArea(box);
+   if (area > 0 && 1. + bestcost/area >= n && n <= 4*kBVHMaxLeafSize) return inode;
+
+   Double_t scale = kBVHNbins/(cbox[bestaxis+3]-cbox[bestaxis]);
+   Double_t cmin = cbox[bestaxis];
+   Int_t *mid = std::partition(&fBVHItems[begin], &fBVHItems[0]+end,
+      [&](Int_t id) {
+         return TMath::Min(Int_t((centers[3*id+bestaxis]-cmin)*scale), kBVHNbins-1) <= bestbin;
+      });
+   Int_t imid = mid - &fBVHItems[0];
+   if (imid == begin || imid == end) return inode;
+
+   fBVHCount[inode] = 0;
+   BuildNode(begin, imid, depth+1, centers);
+   Int_t right = BuildNode(imid, end, depth+1, centers);
+   fBVHFirst[inode] = right;
+   return inode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check if the ray crosses the box of a node and return the entry distance.
+
+Bool_t TGeoBVHFinder::IntersectNode(Int_t inode, const Double_t *point, const Double_t *invdir, Double_t &tnear) const
+{
+   return BoxCrossed(&fBVHBox[6*inode], point, invdir, tnear);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the hierarchy statistics and return the inverse of the expected
+/// number of bounding boxes checked by a random ray crossing the volume.
+
+Double_t TGeoBVHFinder::Efficiency()
+{
+   printf("BVH efficiency for %s\n", fVolume->GetName());
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   if (!fNnodes) return 0;
+   Double_t aroot = HalfArea(&fBVHBox[0]);
+   if (aroot <= 0) return 0;
+   Double_t cost = 0;
+   for (Int_t inode=0; inode<fNnodes; inode++) {
+      Double_t prob = HalfArea(&fBVHBox[6*inode])/aroot;
+      cost += prob*(fBVHCount[inode] ? fBVHCount[inode] : 2);
+   }
+   printf("expected checks per ray : %g (%i daughters)\n", cost, fVolume->GetNdaughters());
+   return (cost>0) ? 1./cost : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the list of daughter indices whose bounding box contains the point.
+
+Int_t *TGeoBVHFinder::GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td)
+{
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   nelem = 0;
+   td.fVoxNcandidates = 0;
+   if (!fNnodes || !BoxContains(&fBVHBox[0], point)) return 0;
+   Int_t stack[kBVHMaxDepth+2];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   Double_t dbox[6];
+   while (nstack) {
+      Int_t inode = stack[--nstack];
+      Int_t count = fBVHCount[inode];
+      if (count) {
+         const Int_t *items = &fBVHItems[fBVHFirst[inode]];
+         for (Int_t i=0; i<count; i++) {
+            DaughterBox(fBoxes, items[i], dbox);
+            if (BoxContains(dbox, point)) td.fVoxCheckList[nelem++] = items[i];
+         }
+         continue;
+      }
+      Int_t right = fBVHFirst[inode];
+      if (BoxContains(&fBVHBox[6*right], point)) stack[nstack++] = right;
+      if (BoxContains(&fBVHBox[6*(inode+1)], point)) stack[nstack++] = inode+1;
+   }
+   td.fVoxNcandidates = nelem;
+   return (nelem) ? td.fVoxCheckList : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// All candidates are returned by the first call to GetNextVoxel.
+
+Int_t *TGeoBVHFinder::GetNextCandidates(const Double_t * /*point*/, Int_t &ncheck, TGeoStateInfo & /*td*/)
+{
+   ncheck = 0;
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the candidates found by SortCrossedVoxels at the first call, then 0.
+
+Int_t *TGeoBVHFinder::GetNextVoxel(const Double_t * /*point*/, const Double_t * /*dir*/, Int_t &ncheck, TGeoStateInfo &td)
+{
+   ncheck = 0;
+   if (td.fVoxCurrent) return 0;
+   td.fVoxCurrent++;
+   ncheck = td.fVoxNcandidates;
+   return (ncheck) ? td.fVoxCheckList : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the hierarchy.
+
+void TGeoBVHFinder::Print(Option_t *) const
+{
+   if (NeedRebuild()) {
+      TGeoBVHFinder *vox = (TGeoBVHFinder*)this;
+      vox->Voxelize();
+      fVolume->FindOverlaps();
+   }
+   Int_t nleaves = 0;
+   Int_t maxleaf = 0;
+   for (Int_t inode=0; inode<fNnodes; inode++) {
+      if (!fBVHCount[inode]) continue;
+      nleaves++;
+      maxleaf = TMath::Max(maxleaf, fBVHCount[inode]);
+   }
+   printf("BVH for volume %s (nd=%i)\n", fVolume->GetName(), fVolume->GetNdaughters());
+   printf("nodes : %i  leaves : %i  max leaf size : %i\n", fNnodes, nleaves, maxleaf);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Collect the daughters whose bounding box is crossed by the ray starting
+/// from point. Children are visited nearest first so that the candidate list
+/// is ordered front to back at node level.
+
+void TGeoBVHFinder::SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td)
+{
+   if (NeedRebuild()) {
+      TGeoBVHFinder *vox = (TGeoBVHFinder*)this;
+      vox->Voxelize();
+      fVolume->FindOverlaps();
+   }
+   td.fVoxCurrent = 0;
+   td.fVoxNcandidates = 0;
+   if (!fNnodes) return;
+   Double_t *invdir = td.fVoxInvdir;
+   for (Int_t i=0; i<3; i++) invdir[i] = (TMath::Abs(dir[i])<1E-10) ? 0. : 1./dir[i];
+   Double_t tnear, tleft, tright;
+   if (!IntersectNode(0, point, invdir, tnear)) return;
+   Int_t stack[kBVHMaxDepth+2];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   Int_t ncand = 0;
+   Double_t dbox[6];
+   while (nstack) {
+      Int_t inode = stack[--nstack];
+      Int_t count = fBVHCount[inode];
+      if (count) {
+         const Int_t *items = &fBVHItems[fBVHFirst[inode]];
+         for (Int_t i=0; i<count; i++) {
+            DaughterBox(fBoxes, items[i], dbox);
+            if (BoxCrossed(dbox, point, invdir, tnear)) td.fVoxCheckList[ncand++] = items[i];
+         }
+         continue;
+      }
+      Int_t left = inode+1;
+      Int_t right = fBVHFirst[inode];
+      Bool_t hitleft = IntersectNode(left, point, invdir, tleft);
+      Bool_t hitright = IntersectNode(right, point, invdir, tright);
+      if (hitleft && hitright) {
+         // push the farthest first
+         if (tleft <= tright) {
+            stack[nstack++] = right;
+            stack[nstack++] = left;
+         } else {
+            stack[nstack++] = left;
+            stack[nstack++] = right;
+         }
+      } else if (hitleft) {
+         stack[nstack++] = left;
+      } else if (hitright) {
+         stack[nstack++] = right;
+      }
+   }
+   td.fVoxNcandidates = ncand;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the daughter bounding boxes and build the hierarchy. The voxel
+/// slices of the base class are not created.
+
+void TGeoBVHFinder::Voxelize(Option_t * /*option*/)
+{
+   if (fVolume->IsAssembly()) fVolume->GetShape()->ComputeBBox();
+   Int_t nd = fVolume->GetNdaughters();
+   TGeoVolume *vd;
+   for (Int_t i=0; i<nd; i++) {
+      vd = fVolume->GetNode(i)->GetVolume();
+      if (vd->IsAssembly()) vd->GetShape()->ComputeBBox();
+   }
+   BuildVoxelLimits();
+   BuildBVH();
+   SetNeedRebuild(kFALSE);
+}
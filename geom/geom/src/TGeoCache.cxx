@@ -16,6 +16,7 @@
 #include "TGeoMatrix.h"
 #include "TGeoVolume.h"
 #include "TObject.h"
+#include "TMath.h"
 
 //const Int_t kN3 = 3*sizeof(Double_t);
 
@@ -609,3 +610,185 @@ Bool_t TGeoCacheState::GetState(Int_t &level, Int_t &nmany, Double_t *point) con
    if (point) memcpy(point, fPoint, 3*sizeof(Double_t));
    return fOverlapping;
 }
+
+ClassImp(TGeoTouchableCache);
+
+/** \class TGeoTouchableCache
+\ingroup Geometry_classes
+
+Cache of the last safety values computed in each touchable (physical node),
+used by TGeoNavigator to avoid recomputing the safety when a track, or
+another track, comes back close to a point already visited in the same
+touchable. This is typically the case for the secondaries of a shower.
+
+Entries are keyed by the branch of nodes making the touchable (the same
+identity as for TGeoBranchArray) and stored in a direct-mapped table: a
+branch hashing to an occupied entry replaces it. A stored safety S computed at
+point P0 is valid for a point P as S-|P-P0|, since the safety is the radius
+of a sphere free of boundaries. It is only reused while |P-P0| is smaller than
+a fraction of S (see SetReuseFraction), so that the returned value stays close
+to the real one.
+
+The cache has to be cleared whenever node positions change (misalignment).
+*/
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hash of a branch of nodes.
+
+inline ULong64_t HashBranch(TGeoNode **branch, Int_t level)
+{
+   ULong64_t h = 14695981039346656037ULL;
+   for (Int_t i=0; i<=level; i++) {
+      h ^= (ULong64_t)(ULong_t)branch[i];
+      h *= 1099511628211ULL;
+   }
+   return h ^ (h >> 29);
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Dummy constructor
+
+TGeoTouchableCache::TGeoTouchableCache()
+                   :TObject(),
+                    fSize(0),
+                    fMaxLevels(0),
+                    fReuseFraction(0.5),
+                    fNlookups(0),
+                    fNhits(0),
+                    fNstores(0),
+                    fNreplaced(0),
+                    fLevels(0),
+                    fNodes(0),
+                    fPoints(0),
+                    fSafeties(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor. The number of entries is rounded up to a power of 2.
+
+TGeoTouchableCache::TGeoTouchableCache(Int_t maxlevels, Int_t size)
+                   :TObject(),
+                    fSize(1),
+                    fMaxLevels(maxlevels),
+                    fReuseFraction(0.5),
+                    fNlookups(0),
+                    fNhits(0),
+                    fNstores(0),
+                    fNreplaced(0),
+                    fLevels(0),
+                    fNodes(0),
+                    fPoints(0),
+                    fSafeties(0)
+{
+   while (fSize < size) fSize <<= 1;
+   fLevels = new Int_t[fSize];
+   fNodes = new TGeoNode*[fSize*fMaxLevels];
+   fPoints = new Double_t[3*fSize];
+   fSafeties = new Double_t[fSize];
+   Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+TGeoTouchableCache::~TGeoTouchableCache()
+{
+   delete [] fLevels;
+   delete [] fNodes;
+   delete [] fPoints;
+   delete [] fSafeties;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Invalidate all entries. Statistics are kept.
+
+void TGeoTouchableCache::Clear(Option_t *)
+{
+   for (Int_t i=0; i<fSize; i++) fLevels[i] = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Entry where a branch is stored.
+
+Int_t TGeoTouchableCache::GetSlot(TGeoNode **branch, Int_t level) const
+{
+   return Int_t(HashBranch(branch, level) & (fSize-1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check if the entry SLOT holds the given branch.
+
+Bool_t TGeoTouchableCache::IsStored(Int_t slot, TGeoNode **branch, Int_t level) const
+{
+   if (fLevels[slot] != level) return kFALSE;
+   TGeoNode **stored = &fNodes[slot*fMaxLevels];
+   for (Int_t i=level; i>=0; i--) {
+      if (stored[i] != branch[i]) return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of entries in use.
+
+Int_t TGeoTouchableCache::GetNused() const
+{
+   Int_t nused = 0;
+   for (Int_t i=0; i<fSize; i++) if (fLevels[i] >= 0) nused++;
+   return nused;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get a safety value for POINT in the touchable given by the branch, derived
+/// from the value stored for this touchable. Returns kFALSE if there is no
+/// stored value or if POINT drifted too far from the stored point.
+
+Bool_t TGeoTouchableCache::GetSafety(TGeoNode **branch, Int_t level, const Double_t *point, Double_t &safe)
+{
+   if (level >= fMaxLevels) return kFALSE;
+   fNlookups++;
+   Int_t slot = GetSlot(branch, level);
+   if (!IsStored(slot, branch, level)) return kFALSE;
+   const Double_t *stored = &fPoints[3*slot];
+   Double_t dx = point[0]-stored[0];
+   Double_t dy = point[1]-stored[1];
+   Double_t dz = point[2]-stored[2];
+   Double_t dmax = fReuseFraction*fSafeties[slot];
+   Double_t d2 = dx*dx+dy*dy+dz*dz;
+   if (d2 >= dmax*dmax) return kFALSE;
+   safe = fSafeties[slot]-TMath::Sqrt(d2);
+   fNhits++;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the safety computed at POINT in the touchable given by the branch.
+
+void TGeoTouchableCache::SetSafety(TGeoNode **branch, Int_t level, const Double_t *point, Double_t safe)
+{
+   if (level >= fMaxLevels) return;
+   Int_t slot = GetSlot(branch, level);
+   if (!IsStored(slot, branch, level)) {
+      if (fLevels[slot] >= 0) fNreplaced++;
+      fLevels[slot] = level;
+      memcpy(&fNodes[slot*fMaxLevels], branch, (level+1)*sizeof(TGeoNode*));
+   }
+   memcpy(&fPoints[3*slot], point, 3*sizeof(Double_t));
+   fSafeties[slot] = safe;
+   fNstores++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the cache statistics.
+
+void TGeoTouchableCache::Print(Option_t *) const
+{
+   printf("Touchable cache: %d/%d entries used, reuse fraction %g\n", GetNused(), fSize, fReuseFraction);
+   printf("   safety lookups: %lld  hits: %lld (%.1f%%)  stored: %lld  replaced: %lld\n",
+          fNlookups, fNhits, (fNlookups)?100.*fNhits/fNlookups:0., fNstores, fNreplaced);
+}
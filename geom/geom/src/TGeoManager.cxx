@@ -3294,6 +3294,14 @@ void TGeoManager::RefreshPhysicalNodes(Bool_t lock)
    TGeoPhysicalNode *pn;
    while ((pn=(TGeoPhysicalNode*)next())) pn->Refresh();
    if (fParallelWorld && fParallelWorld->IsClosed()) fParallelWorld->RefreshPhysicalNodes();
+   // Safety values cached by navigators are no longer valid
+   for (NavigatorsMapIt_t it = fNavigators.begin(); it != fNavigators.end(); ++it) {
+      TGeoNavigatorArray *array = it->second;
+      for (Int_t i=0; i<array->GetEntriesFast(); i++) {
+         TGeoNavigator *nav = (TGeoNavigator*)array->At(i);
+         if (nav) nav->ClearStateCache();
+      }
+   }
    if (lock) LockGeometry();
 }
 
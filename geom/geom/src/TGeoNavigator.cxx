@@ -43,6 +43,9 @@ gGeoManager->SetCurrentNavigator(0);
 #include "TGeoParallelWorld.h"
 #include "TGeoPhysicalNode.h"
 
+#include <memory>
+#include <vector>
+
 static Double_t gTolerance = TGeoShape::Tolerance();
 const char *kGeoOutsidePath = " ";
 const Int_t kN3 = 3*sizeof(Double_t);
@@ -86,6 +89,7 @@ TGeoNavigator::TGeoNavigator()
                fCurrentMatrix(0),
                fGlobalMatrix(0),
                fDivMatrix(0),
+               fTouchables(0),
                fPath()
 
 {
@@ -137,6 +141,7 @@ TGeoNavigator::TGeoNavigator(TGeoManager* geom)
                fCurrentMatrix(0),
                fGlobalMatrix(0),
                fDivMatrix(0),
+               fTouchables(0),
                fPath()
 
 {
@@ -196,6 +201,7 @@ TGeoNavigator::TGeoNavigator(const TGeoNavigator& gm)
                fBackupState(gm.fBackupState),
                fCurrentMatrix(gm.fCurrentMatrix),
                fGlobalMatrix(gm.fGlobalMatrix),
+               fTouchables(0),
                fPath(gm.fPath)
 {
    fThreadId = TGeoManager::ThreadId();
@@ -273,6 +279,7 @@ TGeoNavigator::~TGeoNavigator()
    if (fCache) delete fCache;
    if (fBackupState) delete fBackupState;
    if (fOverlapClusters) delete [] fOverlapClusters;
+   delete fTouchables;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1686,11 +1693,128 @@ void TGeoNavigator::ResetState()
    fIsStepEntering = fIsStepExiting = kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distance to the next boundary for a basket of NTRACKS tracks
+/// located in the current volume (and outside its daughters). The points
+/// (X,Y,Z) and directions (DX,DY,DZ) are given in the master frame as separate
+/// arrays. On output, STEPS contains the distance to the next boundary (at
+/// most STEPMAX) and IDAUGHTER the index of the daughter node that is entered,
+/// or -1 if the track exits the current volume or does not reach a boundary
+/// within STEPMAX. The navigator state is not changed.
+///
+/// The distances are computed with the vectorized shape methods
+/// (TGeoShape::DistFromInside_v/DistFromOutside_v) for all tracks at once,
+/// looping over all daughters: voxels, divisions and overlapping (MANY)
+/// nodes are not used.
+
+void TGeoNavigator::FindNextBoundaryN(Int_t ntracks, const Double_t *x, const Double_t *y, const Double_t *z,
+                                      const Double_t *dx, const Double_t *dy, const Double_t *dz,
+                                      Double_t *steps, Int_t *idaughter, Double_t stepmax) const
+{
+   if (ntracks <= 0) return;
+   std::vector<Double_t> point(3*ntracks), dir(3*ntracks);
+   std::vector<Double_t> dpoint(3*ntracks), ddir(3*ntracks);
+   std::vector<Double_t> dist(ntracks), dstep(ntracks, stepmax);
+   Double_t master[3], mdir[3];
+   Int_t i;
+   //---> convert points and directions to the local frame of the current node
+   for (i=0; i<ntracks; i++) {
+      master[0] = x[i];  master[1] = y[i];  master[2] = z[i];
+      mdir[0]   = dx[i]; mdir[1]   = dy[i]; mdir[2]   = dz[i];
+      fGlobalMatrix->MasterToLocal(master, &point[3*i]);
+      fGlobalMatrix->MasterToLocalVect(mdir, &dir[3*i]);
+   }
+
+   //---> distance to exit the current volume
+   TGeoVolume *vol = fCurrentNode->GetVolume();
+   vol->GetShape()->DistFromInside_v(point.data(), dir.data(), steps, ntracks, dstep.data());
+   for (i=0; i<ntracks; i++) {
+      if (steps[i] > stepmax) steps[i] = stepmax;
+      idaughter[i] = -1;
+   }
+
+   //---> distance to enter each of the daughters
+   Int_t nd = vol->GetNdaughters();
+   for (Int_t id=0; id<nd; id++) {
+      TGeoNode *node = vol->GetNode(id);
+      TGeoMatrix *mat = node->GetMatrix();
+      for (i=0; i<ntracks; i++) {
+         mat->MasterToLocal(&point[3*i], &dpoint[3*i]);
+         mat->MasterToLocalVect(&dir[3*i], &ddir[3*i]);
+         dstep[i] = steps[i];
+      }
+      node->GetVolume()->GetShape()->DistFromOutside_v(dpoint.data(), ddir.data(), dist.data(), ntracks, dstep.data());
+      for (i=0; i<ntracks; i++) {
+         if (dist[i] < steps[i]) {
+            steps[i]     = dist[i];
+            idaughter[i] = id;
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the safe distance for a basket of NTRACKS points (X,Y,Z), given in
+/// the master frame, located in the current volume and outside its daughters.
+/// This is the vectorized counterpart of Safety(), with the same restrictions
+/// as FindNextBoundaryN(). The navigator state is not changed.
+
+void TGeoNavigator::SafetyN(Int_t ntracks, const Double_t *x, const Double_t *y, const Double_t *z, Double_t *safe) const
+{
+   if (ntracks <= 0) return;
+   std::vector<Double_t> point(3*ntracks), dpoint(3*ntracks), dsafe(ntracks);
+   std::unique_ptr<Bool_t[]> inside(new Bool_t[ntracks]);
+   Double_t master[3];
+   Int_t i;
+   for (i=0; i<ntracks; i++) {
+      master[0] = x[i]; master[1] = y[i]; master[2] = z[i];
+      fGlobalMatrix->MasterToLocal(master, &point[3*i]);
+      inside[i] = kTRUE;
+   }
+
+   //---> safety to the current volume
+   TGeoVolume *vol = fCurrentNode->GetVolume();
+   vol->GetShape()->Safety_v(point.data(), inside.get(), safe, ntracks);
+
+   //---> safety to each of the daughters
+   for (i=0; i<ntracks; i++) inside[i] = kFALSE;
+   Int_t nd = vol->GetNdaughters();
+   for (Int_t id=0; id<nd; id++) {
+      TGeoNode *node = vol->GetNode(id);
+      TGeoMatrix *mat = node->GetMatrix();
+      for (i=0; i<ntracks; i++) mat->MasterToLocal(&point[3*i], &dpoint[3*i]);
+      node->GetVolume()->GetShape()->Safety_v(dpoint.data(), inside.get(), dsafe.data(), ntracks);
+      for (i=0; i<ntracks; i++) safe[i] = TMath::Min(safe[i], dsafe[i]);
+   }
+   for (i=0; i<ntracks; i++) {
+      if (safe[i] < gTolerance) safe[i] = 0;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute safe distance from the current point. This represent the distance
 /// from POINT to the closest boundary.
+/// If the state cache is enabled (see SetStateCache), the safety may be derived
+/// from the one computed previously at a close point in the same touchable. The
+/// value returned is then a lower limit of the distance to the closest boundary.
 
 Double_t TGeoNavigator::Safety(Bool_t inside)
+{
+   if (!fTouchables || inside || fIsOnBoundary || fIsOutside || fGeometry->IsParallelWorldNav())
+      return ComputeSafety(inside);
+   TGeoNode **branch = (TGeoNode **)fCache->GetBranch();
+   Int_t level = fCache->GetLevel();
+   if (fTouchables->GetSafety(branch, level, fPoint, fSafety)) return fSafety;
+   ComputeSafety(kFALSE);
+   if (fSafety > 0) fTouchables->SetSafety(branch, level, fPoint, fSafety);
+   return fSafety;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the safe distance from the current point, without using the state
+/// cache.
+
+Double_t TGeoNavigator::ComputeSafety(Bool_t inside)
 {
    if (fIsOnBoundary) {
       fSafety = 0;
@@ -2376,6 +2500,37 @@ void TGeoNavigator::InspectState() const
    Info("InspectState","on_bound=%i   entering=%i", fIsOnBoundary, fIsEntering);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Print the statistics of the state cache.
+
+void TGeoNavigator::PrintStats() const
+{
+   if (!fTouchables) {
+      Info("PrintStats","State cache not enabled for navigator of thread %d", fThreadId);
+      return;
+   }
+   Info("PrintStats","State cache for navigator of thread %d", fThreadId);
+   fTouchables->Print();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the cache of safety values per touchable. The cache keeps
+/// the last safety computed in each touchable, so that the safety at a close
+/// point in the same touchable does not have to be recomputed. Useful when
+/// many tracks are transported in the same regions, e.g. in showers.
+/// SIZE is the number of touchables cached. The cache has to be cleared
+/// (ClearStateCache) if the geometry is misaligned.
+
+void TGeoNavigator::SetStateCache(Bool_t flag, Int_t size)
+{
+   delete fTouchables;
+   fTouchables = 0;
+   if (!flag) return;
+   Int_t nlevel = fGeometry->GetMaxLevel();
+   if (nlevel<=0) nlevel = 100;
+   fTouchables = new TGeoTouchableCache(nlevel+1, size);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Checks if point (x,y,z) is still in the current node.
 /// check if this is an overlapping node
@@ -2652,6 +2807,7 @@ void TGeoNavigator::ResetAll()
       fCache = 0;
       BuildCache(dummy,nodeid);
    }
+   if (fTouchables) SetStateCache(kTRUE, fTouchables->GetSize());
 }
 
 ClassImp(TGeoNavigatorArray);
@@ -399,6 +399,7 @@ volumes (or volume assemblies) as content.
 #include "TGeoScaledShape.h"
 #include "TGeoCompositeShape.h"
 #include "TGeoVoxelFinder.h"
+#include "TGeoBVHFinder.h"
 #include "TGeoExtension.h"
 
 ClassImp(TGeoVolume);
@@ -457,6 +458,7 @@ TGeoVolume::TGeoVolume()
    fNumber   = 0;
    fNtotal   = 0;
    fRefCount = 0;
+   fUseBVH   = kFALSE;
    fUserExtension = 0;
    fFWExtension = 0;
    TObject::ResetBit(kVolumeImportNodes);
@@ -489,6 +491,7 @@ TGeoVolume::TGeoVolume(const char *name, const TGeoShape *shape, const TGeoMediu
    fNumber   = 0;
    fNtotal   = 0;
    fRefCount = 0;
+   fUseBVH   = kFALSE;
    fUserExtension = 0;
    fFWExtension = 0;
    if (fGeoManager) fNumber = fGeoManager->AddVolume(this);
@@ -515,6 +518,7 @@ TGeoVolume::TGeoVolume(const TGeoVolume& gv) :
   fNumber(gv.fNumber),
   fNtotal(gv.fNtotal),
   fRefCount(0),
+  fUseBVH(gv.fUseBVH),
   fUserExtension(gv.fUserExtension->Grab()),
   fFWExtension(gv.fFWExtension->Grab())
 {
@@ -542,6 +546,7 @@ TGeoVolume& TGeoVolume::operator=(const TGeoVolume& gv)
       fNumber=gv.fNumber;
       fRefCount = 0;
       fNtotal=gv.fNtotal;
+      fUseBVH=gv.fUseBVH;
       fUserExtension=gv.fUserExtension->Grab();
       fFWExtension=gv.fFWExtension->Grab();
    }
@@ -1793,8 +1798,9 @@ TGeoVolume *TGeoVolume::CloneVolume() const
    vol->SetFinder(fFinder);
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
+   vol->SetUseBVH(fUseBVH);
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      voxels = (fUseBVH) ? new TGeoBVHFinder(vol) : new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -2348,7 +2354,8 @@ void TGeoVolume::VisibleDaughters(Bool_t vis)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// build the voxels for this volume
+/// build the voxels for this volume, or a bounding volume hierarchy if
+/// SetUseBVH() was called
 
 void TGeoVolume::Voxelize(Option_t *option)
 {
@@ -2368,8 +2375,9 @@ void TGeoVolume::Voxelize(Option_t *option)
       if (!TObject::TestBit(kVolumeClone)) delete fVoxels;
       fVoxels = 0;
    }
-   // Create the voxels structure
-   fVoxels = new TGeoVoxelFinder(this);
+   // Create the voxels structure, or the bounding volume hierarchy if requested
+   if (fUseBVH) fVoxels = new TGeoBVHFinder(this);
+   else         fVoxels = new TGeoVoxelFinder(this);
    fVoxels->Voxelize(option);
    if (fVoxels) {
       if (fVoxels->IsInvalid()) {
@@ -2931,8 +2939,9 @@ TGeoVolume *TGeoVolumeAssembly::CloneVolume() const
    ((TGeoShapeAssembly*)vol->GetShape())->NeedsBBoxRecompute();
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
+   vol->SetUseBVH(fUseBVH);
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      voxels = (fUseBVH) ? new TGeoBVHFinder(vol) : new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -3015,8 +3024,9 @@ TGeoVolumeAssembly *TGeoVolumeAssembly::MakeAssemblyFromVolume(TGeoVolume *volor
    vol->GetShape()->ComputeBBox();
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
+   vol->SetUseBVH(volorig->IsUsingBVH());
    if (volorig->GetVoxels()) {
-      voxels = new TGeoVoxelFinder(vol);
+      voxels = (volorig->IsUsingBVH()) ? new TGeoBVHFinder(vol) : new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -1463,6 +1463,7 @@ void TFitEditor::SetFitObject(TVirtualPad *pad, TObject *obj, Int_t event)
 
    fParentPad = pad;
    fFitObject = obj;
+   fFitObject->SetBit(kMustCleanup); // see RecursiveRemove
    ShowObjectName(obj);
    UpdateGUI();
 
@@ -364,6 +364,7 @@ void THStack::Add(TH1 *h1, Option_t *option)
       return;
    }
    if (!fHists) fHists = new TList();
+   h1->SetBit(kMustCleanup);
    fHists->Add(h1,option);
    Modified(); //invalidate stack
 }
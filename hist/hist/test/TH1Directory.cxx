@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+
+#include "TH1.h"
+#include "TMemFile.h"
+#include "TROOT.h"
+
+// Histograms in a directory are tracked by the cleanup index of TROOT, their
+// deletion is not broadcast to the list of cleanups.
+TEST(TH1Directory, DeletionNotBroadcast)
+{
+   TMemFile file("TH1Directory.root", "RECREATE");
+   TH1F *hist = new TH1F("hist", "hist", 10, 0., 1.);
+   ASSERT_EQ(&file, hist->GetDirectory());
+   EXPECT_FALSE(hist->TestBit(kMustCleanup));
+   EXPECT_TRUE(hist->TestBit(TObject::kHasCleanupHolders));
+
+   TROOT::SetCleanupStat(kTRUE);
+   Long64_t nremove = gROOT->GetNRecursiveRemove();
+   delete hist;
+   TROOT::SetCleanupStat(kFALSE);
+   EXPECT_EQ(nremove, gROOT->GetNRecursiveRemove());
+   EXPECT_EQ(nullptr, file.GetList()->FindObject("hist"));
+}
+
+TEST(TH1Directory, SetDirectory)
+{
+   TMemFile file("TH1Directory.root", "RECREATE");
+   TH1F hist("hist", "hist", 10, 0., 1.);
+   hist.SetDirectory(nullptr);
+   EXPECT_FALSE(hist.TestBit(TObject::kHasCleanupHolders));
+   EXPECT_EQ(nullptr, file.GetList()->FindObject("hist"));
+   hist.SetDirectory(&file);
+   EXPECT_TRUE(hist.TestBit(TObject::kHasCleanupHolders));
+   EXPECT_EQ(&hist, file.GetList()->FindObject("hist"));
+   hist.SetDirectory(nullptr);
+}
+
+// A histogram appended to a directory other than its own one is removed from
+// it through the index when deleted.
+TEST(TH1Directory, OtherDirectoryNotified)
+{
+   TMemFile file("TH1Directory.root", "RECREATE");
+   TH1F *hist = new TH1F("hist", "hist", 10, 0., 1.);
+   hist->SetDirectory(nullptr);
+   file.Append(hist);
+   ASSERT_EQ(hist, file.GetList()->FindObject("hist"));
+   delete hist;
+   EXPECT_EQ(nullptr, file.GetList()->FindObject("hist"));
+}
+
+// Holders which are in the list of cleanups still see the histogram deletion
+// if they set the kMustCleanup bit.
+TEST(TH1Directory, DrawnOrStackedStillBroadcast)
+{
+   TMemFile file("TH1Directory.root", "RECREATE");
+   TH1F *hist = new TH1F("hist", "hist", 10, 0., 1.);
+   hist->SetBit(kMustCleanup);
+   TROOT::SetCleanupStat(kTRUE);
+   Long64_t nremove = gROOT->GetNRecursiveRemove();
+   delete hist;
+   TROOT::SetCleanupStat(kFALSE);
+   EXPECT_EQ(nremove + 1, gROOT->GetNRecursiveRemove());
+   EXPECT_EQ(nullptr, file.GetList()->FindObject("hist"));
+}
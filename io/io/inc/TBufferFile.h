@@ -57,13 +57,14 @@ protected:
    TExMap         *fClassMap;      ///< Map containing object,class pairs for reading
    TStreamerInfo  *fInfo;          ///< Pointer to TStreamerInfo object writing/reading the buffer
    InfoList_t      fInfoStack;     ///< Stack of pointers to the TStreamerInfos
+   void           *fRecycledObject;///<! Object whose storage can be reused by the next ReadObjectAny
 
    static Int_t    fgMapSize;      ///< Default map size for all TBuffer objects
 
    // Default ctor
    TBufferFile() : TBuffer(), fMapCount(0), fMapSize(0),
                fDisplacement(0),fPidOffset(0), fMap(0), fClassMap(0),
-     fInfo(0), fInfoStack() {}
+     fInfo(0), fInfoStack(), fRecycledObject(0) {}
 
    // TBuffer objects cannot be copied or assigned
    TBufferFile(const TBufferFile &);       ///<  not implemented
@@ -80,6 +81,7 @@ public:
    enum { kStreamedMemberWise = BIT(14) }; //added to version number to know if a collection has been stored member-wise
    enum { kNotDecompressed = BIT(15) };    //indicates a weird buffer, used by TBasket
    enum { kTextBasedStreaming = BIT(18) }; //indicates if buffer used for XML/SQL object streaming
+   enum { kRecycleObjects = BIT(19) };     //objects replaced when reading pointers are reconstructed in place
    enum { kUser1 = BIT(21), kUser2 = BIT(22), kUser3 = BIT(23)}; //free for user
 
    TBufferFile(TBuffer::EMode mode);
@@ -399,9 +399,9 @@ public:
 
    // end of redefined virtual functions
 
-   static    void     SetFloatFormat(const char *fmt = "%e");
+   static    void     SetFloatFormat(const char *fmt = "");
    static const char *GetFloatFormat();
-   static    void     SetDoubleFormat(const char *fmt = "%.14e");
+   static    void     SetDoubleFormat(const char *fmt = "");
    static const char *GetDoubleFormat();
 
    static    void     CompactFloatString(char* buf, unsigned len);
@@ -463,8 +463,8 @@ protected:
    TString                   fArraySepar;    //!  depending from compression level, ", " or ","
    TString                   fNumericLocale; //!  stored value of setlocale(LC_NUMERIC), which should be recovered at the end
 
-   static const char *fgFloatFmt;          //!  printf argument for floats, either "%f" or "%e" or "%10f" and so on
-   static const char *fgDoubleFmt;         //!  printf argument for doubles, either "%f" or "%e" or "%10f" and so on
+   static const char *fgFloatFmt;          //!  printf argument for floats, either "%f" or "%e" or "%10f" and so on, "" - shortest round-trip
+   static const char *fgDoubleFmt;         //!  printf argument for doubles, either "%f" or "%e" or "%10f" and so on, "" - shortest round-trip
 
    ClassDef(TBufferJSON, 1) //a specialized TBuffer to only write objects into JSON format
 };
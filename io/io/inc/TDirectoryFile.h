@@ -24,6 +24,7 @@
 #include "TDirectory.h"
 
 class TList;
+class TCollection;
 class TBrowser;
 class TKey;
 class TFile;
@@ -100,6 +101,7 @@ public:
    virtual TFile      *OpenFile(const char *name, Option_t *option= "",
                             const char *ftitle = "", Int_t compress = 1,
                             Int_t netopt = 0);
+           Int_t       PrefetchKeys(TCollection *keys = 0, Long64_t maxbytes = 0);
    virtual void        Purge(Short_t nkeep=1);
    virtual void        ReadAll(Option_t *option="");
    virtual Int_t       ReadKeys(Bool_t forceRead=kTRUE);
@@ -23,6 +23,8 @@ class TFile;
 
 class TKey : public TNamed {
 
+friend class TDirectoryFile;
+
 private:
    enum EStatusBits {
       kIsDirectoryFile = BIT(14)
@@ -45,6 +47,7 @@ protected:
    TBuffer    *fBufferRef;   ///< Pointer to the TBuffer object
    UShort_t    fPidOffset;   ///<!Offset to be added to the pid index in this key/buffer.  This is actually saved in the high bits of fSeekPdir
    TDirectory *fMotherDir;   ///<!pointer to mother directory
+   char       *fPrefetchBuffer; ///<!Uncompressed key and object filled by TDirectoryFile::PrefetchKeys
 
    virtual Int_t    Read(const char *name) { return TObject::Read(name); }
    virtual void     Create(Int_t nbytes, TFile* f = 0);
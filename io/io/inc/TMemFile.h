@@ -14,8 +14,19 @@
 
 #include "TFile.h"
 
+#include <vector>
+
 class TMemFile : public TFile {
 
+public:
+   /// A contiguous range of memory holding (part of) the content of a file.
+   struct ZeroCopyView_t {
+      const char *fStart;  ///< Beginning of the range
+      Long64_t    fSize;   ///< Number of bytes in the range
+
+      ZeroCopyView_t(const char *start, Long64_t size) : fStart(start), fSize(size) {}
+   };
+
 private:
    struct TMemBlock {
    private:
@@ -38,9 +49,12 @@ private:
    Long64_t     fSysOffset;   ///< Seek offset in file
    TMemBlock   *fBlockSeek;   ///< Pointer to the block we seeked to.
    Long64_t     fBlockOffset; ///< Seek offset within the block
+   Bool_t       fIsOwnedByROOT; ///< False if the memory is an external buffer (read only)
 
    static Long64_t fgDefaultBlockSize;
+   static Long64_t fgMaxBlockSize;
 
+   void     CreateNextBlock();
    Long64_t MemRead(Int_t fd, void *buf, Long64_t len) const;
 
    // Overload TFile interfaces.
@@ -61,11 +75,13 @@ private:
 public:
    TMemFile(const char *name, Option_t *option="", const char *ftitle="", Int_t compress=1);
    TMemFile(const char *name, char *buffer, Long64_t size, Option_t *option="", const char *ftitle="", Int_t compress=1);
+   TMemFile(const char *name, const ZeroCopyView_t &datarange);
    TMemFile(const TMemFile &orig);
    virtual ~TMemFile();
 
    virtual Long64_t CopyTo(void *to, Long64_t maxsize) const;
    virtual void     CopyTo(TBuffer &tobuf) const;
+   std::vector<ZeroCopyView_t> GetContentViews() const;
    virtual Long64_t GetSize() const;
 
    void ResetAfterMerge(TFileMergeInfo *);
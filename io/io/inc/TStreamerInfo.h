@@ -115,6 +115,7 @@ private:
    TStreamerInfoActions::TActionSequence *fWriteText;             ///<! List of write action resulting for text output like JSON or XML.
 
    static std::atomic<Int_t>             fgCount;     ///<Number of TStreamerInfo instances
+   static Bool_t                         fgBlockStreaming; ///<True if runs of numerical members are streamed as one block
 
    template <typename T> static T GetTypedValueAux(Int_t type, void *ladd, int k, Int_t len);
    static void       PrintValueAux(char *ladd, Int_t atype, TStreamerElement * aElement, Int_t aleng, Int_t *count);
@@ -284,6 +285,8 @@ public:
    virtual TClassStreamer *GenExplicitClassStreamer( const ::ROOT::Detail::TCollectionProxyInfo &info, TClass *cl );
 
    static TStreamerElement   *GetCurrentElement();
+   static void                EnableBlockStreaming(Bool_t enable = kTRUE);
+   static Bool_t              IsBlockStreamingEnabled();
 
 public:
    // For access by the StreamerInfoActions.
@@ -129,11 +129,12 @@ namespace TStreamerInfoActions {
 
    typedef std::vector<TConfiguredAction> ActionContainer_t;
    class TActionSequence : public TObject {
-      TActionSequence() {};
+      TActionSequence() : fStreamerInfo(0), fLoopConfig(0), fBlockSequence(0) {};
    public:
-      TActionSequence(TVirtualStreamerInfo *info, UInt_t maxdata) : fStreamerInfo(info), fLoopConfig(0) { fActions.reserve(maxdata); };
+      TActionSequence(TVirtualStreamerInfo *info, UInt_t maxdata) : fStreamerInfo(info), fLoopConfig(0), fBlockSequence(0) { fActions.reserve(maxdata); };
       ~TActionSequence() {
          delete fLoopConfig;
+         delete fBlockSequence;
       }
 
       template <typename action_t>
@@ -147,8 +148,11 @@ namespace TStreamerInfoActions {
       TVirtualStreamerInfo *fStreamerInfo; ///< StreamerInfo used to derive these actions.
       TLoopConfiguration   *fLoopConfig;   ///< If this is a bundle of memberwise streaming action, this configures the looping
       ActionContainer_t     fActions;
+      TActionSequence      *fBlockSequence; ///< Same actions with the runs of numerical data members merged, used by TBufferFile (owned)
 
       void AddToOffset(Int_t delta);
+      void CreateBlockSequence(Bool_t read);
+      void ResetBlockSequence() { delete fBlockSequence; fBlockSequence = 0; }
 
       TActionSequence *CreateCopy();
       static TActionSequence *CreateReadMemberWiseActions(TVirtualStreamerInfo *info, TVirtualCollectionProxy &proxy);
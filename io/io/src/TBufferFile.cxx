@@ -92,7 +92,7 @@ static inline bool Class_Has_StreamerInfo(const TClass* cl)
 TBufferFile::TBufferFile(TBuffer::EMode mode)
             :TBuffer(mode),
              fDisplacement(0),fPidOffset(0), fMap(0), fClassMap(0),
-             fInfo(0), fInfoStack()
+             fInfo(0), fInfoStack(), fRecycledObject(0)
 {
    fMapCount     = 0;
    fMapSize      = fgMapSize;
@@ -109,7 +109,7 @@ TBufferFile::TBufferFile(TBuffer::EMode mode)
 TBufferFile::TBufferFile(TBuffer::EMode mode, Int_t bufsiz)
             :TBuffer(mode,bufsiz),
              fDisplacement(0),fPidOffset(0), fMap(0), fClassMap(0),
-             fInfo(0), fInfoStack()
+             fInfo(0), fInfoStack(), fRecycledObject(0)
 {
    fMapCount = 0;
    fMapSize  = fgMapSize;
@@ -132,7 +132,7 @@ TBufferFile::TBufferFile(TBuffer::EMode mode, Int_t bufsiz)
 TBufferFile::TBufferFile(TBuffer::EMode mode, Int_t bufsiz, void *buf, Bool_t adopt, ReAllocCharFun_t reallocfunc) :
    TBuffer(mode,bufsiz,buf,adopt,reallocfunc),
    fDisplacement(0),fPidOffset(0), fMap(0), fClassMap(0),
-   fInfo(0), fInfoStack()
+   fInfo(0), fInfoStack(), fRecycledObject(0)
 {
    fMapCount = 0;
    fMapSize  = fgMapSize;
@@ -834,8 +834,7 @@ Int_t TBufferFile::ReadArray(Short_t *&h)
    bswapcpy16(h, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   frombuf(fBufCur, h, n);
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -867,8 +866,7 @@ Int_t TBufferFile::ReadArray(Int_t *&ii)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   frombuf(fBufCur, ii, n);
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -922,8 +920,7 @@ Int_t TBufferFile::ReadArray(Long64_t *&ll)
    if (!ll) ll = new Long64_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   frombuf(fBufCur, ll, n);
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -954,8 +951,7 @@ Int_t TBufferFile::ReadArray(Float_t *&f)
    bswapcpy32(f, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   frombuf(fBufCur, f, n);
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -983,8 +979,7 @@ Int_t TBufferFile::ReadArray(Double_t *&d)
    if (!d) d = new Double_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   frombuf(fBufCur, d, n);
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1107,8 +1102,7 @@ Int_t TBufferFile::ReadStaticArray(Short_t *h)
    bswapcpy16(h, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   frombuf(fBufCur, h, n);
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -1139,8 +1133,7 @@ Int_t TBufferFile::ReadStaticArray(Int_t *ii)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   frombuf(fBufCur, ii, n);
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -1192,8 +1185,7 @@ Int_t TBufferFile::ReadStaticArray(Long64_t *ll)
    if (!ll) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   frombuf(fBufCur, ll, n);
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1223,8 +1215,7 @@ Int_t TBufferFile::ReadStaticArray(Float_t *f)
    bswapcpy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   frombuf(fBufCur, f, n);
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -1251,8 +1242,7 @@ Int_t TBufferFile::ReadStaticArray(Double_t *d)
    if (!d) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   frombuf(fBufCur, d, n);
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1373,8 +1363,7 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    bswapcpy16(h, fBufCur, n);
    fBufCur += sizeof(Short_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   frombuf(fBufCur, h, n);
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -1395,8 +1384,7 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   frombuf(fBufCur, ii, n);
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -1429,8 +1417,7 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   frombuf(fBufCur, ll, n);
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1450,8 +1437,7 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    bswapcpy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   frombuf(fBufCur, f, n);
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -1468,8 +1454,7 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   frombuf(fBufCur, d, n);
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1703,9 +1688,13 @@ void TBufferFile::ReadFastArray(void **start, const TClass *cl, Int_t n,
 
    if (!isPreAlloc) {
 
+      // With kRecycleObjects, ReadObjectAny may construct the new object in the
+      // memory of the one it replaces, saving a delete and a new per object.
+      Bool_t recycle = TestBit(kRecycleObjects) && TStreamerInfo::CanDelete();
       for (Int_t j=0; j<n; j++){
          //delete the object or collection
          void *old = start[j];
+         if (recycle) fRecycledObject = old;
          start[j] = ReadObjectAny(cl);
          if (old && old!=start[j] &&
              TStreamerInfo::CanDelete()
@@ -1806,8 +1795,7 @@ void TBufferFile::WriteArray(const Short_t *h, Int_t n)
    bswapcpy16(fBufCur, h, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
+   tobuf(fBufCur, h, n);
 # endif
 #else
    memcpy(fBufCur, h, l);
@@ -1836,8 +1824,7 @@ void TBufferFile::WriteArray(const Int_t *ii, Int_t n)
    bswapcpy32(fBufCur, ii, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
+   tobuf(fBufCur, ii, n);
 # endif
 #else
    memcpy(fBufCur, ii, l);
@@ -1900,8 +1887,7 @@ void TBufferFile::WriteArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   tobuf(fBufCur, ll, n);
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -1929,8 +1915,7 @@ void TBufferFile::WriteArray(const Float_t *f, Int_t n)
    bswapcpy32(fBufCur, f, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
+   tobuf(fBufCur, f, n);
 # endif
 #else
    memcpy(fBufCur, f, l);
@@ -1955,8 +1940,7 @@ void TBufferFile::WriteArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   tobuf(fBufCur, d, n);
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2072,8 +2056,7 @@ void TBufferFile::WriteFastArray(const Short_t *h, Int_t n)
    bswapcpy16(fBufCur, h, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
+   tobuf(fBufCur, h, n);
 # endif
 #else
    memcpy(fBufCur, h, l);
@@ -2096,8 +2079,7 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Int_t n)
    bswapcpy32(fBufCur, ii, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
+   tobuf(fBufCur, ii, n);
 # endif
 #else
    memcpy(fBufCur, ii, l);
@@ -2144,8 +2126,7 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   tobuf(fBufCur, ll, n);
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -2167,8 +2148,7 @@ void TBufferFile::WriteFastArray(const Float_t *f, Int_t n)
    bswapcpy32(fBufCur, f, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
+   tobuf(fBufCur, f, n);
 # endif
 #else
    memcpy(fBufCur, f, l);
@@ -2187,8 +2167,7 @@ void TBufferFile::WriteFastArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   tobuf(fBufCur, d, n);
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2418,6 +2397,10 @@ void *TBufferFile::ReadObjectAny(const TClass *clCast)
 {
    R__ASSERT(IsReading());
 
+   // Storage offered by ReadFastArray, the objects read while streaming this one must not use it.
+   void *recycled = fRecycledObject;
+   fRecycledObject = 0;
+
    // make sure fMap is initialized
    InitMap();
 
@@ -2520,8 +2503,14 @@ void *TBufferFile::ReadObjectAny(const TClass *clCast)
 
    } else {
 
-      // allocate a new object based on the class found
-      obj = (char*)clRef->New();
+      // allocate a new object based on the class found, or reconstruct it in
+      // the storage of the object it replaces if the latter has the same compiled class
+      if (recycled && clRef == clCast && clRef->GetNew() && clRef->GetActualClass(recycled) == clRef) {
+         clRef->Destructor(recycled, kTRUE);
+         obj = (char*)clRef->New(recycled);
+      } else {
+         obj = (char*)clRef->New();
+      }
       if (!obj) {
          Error("ReadObject", "could not create object of class %s",
                clRef->GetName());
@@ -4007,9 +3996,11 @@ Int_t TBufferFile::ApplySequence(const TStreamerInfoActions::TActionSequence &se
       }
 
    } else {
+      // Use the sequence with the runs of numerical data members merged, when available.
+      const TStreamerInfoActions::TActionSequence &actions = sequence.fBlockSequence ? *sequence.fBlockSequence : sequence;
       //loop on all active members
-      TStreamerInfoActions::ActionContainer_t::const_iterator end = sequence.fActions.end();
-      for(TStreamerInfoActions::ActionContainer_t::const_iterator iter = sequence.fActions.begin();
+      TStreamerInfoActions::ActionContainer_t::const_iterator end = actions.fActions.end();
+      for(TStreamerInfoActions::ActionContainer_t::const_iterator iter = actions.fActions.begin();
           iter != end;
           ++iter) {
          (*iter)(*this,obj);
@@ -36,7 +36,9 @@
 #include <typeinfo>
 #include <string>
 #include <string.h>
+#include <stdlib.h>
 #include <locale.h>
+#include <cmath>
 
 #include "Compression.h"
 
@@ -77,8 +79,150 @@
 ClassImp(TBufferJSON);
 
 
-const char *TBufferJSON::fgFloatFmt = "%e";
-const char *TBufferJSON::fgDoubleFmt = "%.14e";
+const char *TBufferJSON::fgFloatFmt = "";
+const char *TBufferJSON::fgDoubleFmt = "";
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes decimal digits of unsigned value, returns pointer after last written char
+/// Much faster than printf-like conversion, important for large arrays
+
+char *JsonUnsignedToChars(char *buf, ULong64_t value)
+{
+   char tmp[24];
+   int len = 0;
+   do {
+      tmp[len++] = '0' + (char)(value % 10);
+      value /= 10;
+   } while (value != 0);
+   while (len > 0) *buf++ = tmp[--len];
+   return buf;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes decimal digits of signed value, returns pointer after last written char
+
+char *JsonSignedToChars(char *buf, Long64_t value)
+{
+   if (value >= 0) return JsonUnsignedToChars(buf, (ULong64_t)value);
+   *buf++ = '-';
+   return JsonUnsignedToChars(buf, 0 - (ULong64_t)value);
+}
+
+inline bool JsonRoundTrip(const char *buf, Float_t value) { return strtof(buf, 0) == value; }
+
+inline bool JsonRoundTrip(const char *buf, Double_t value) { return strtod(buf, 0) == value; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns 10^n for n >= 0, exact up to 10^22
+
+Double_t JsonPow10(int n)
+{
+   static const Double_t exact[23] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+   return n < 23 ? exact[n] : std::pow(10., n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes value mant * 10^pow10 without trailing zeros
+/// Like "%g", exponent form used for very small and very large values: 1.5e-7
+
+char *JsonDecimalToChars(char *buf, bool negative, ULong64_t mant, int pow10, int maxdigits)
+{
+   while ((mant >= 10) && (mant % 10 == 0)) {
+      mant /= 10;
+      pow10++;
+   }
+
+   char digits[24];
+   int nd = JsonUnsignedToChars(digits, mant) - digits;
+   int exp10 = nd - 1 + pow10;
+
+   if (negative) *buf++ = '-';
+
+   if ((exp10 < -4) || (exp10 >= maxdigits)) {
+      *buf++ = digits[0];
+      if (nd > 1) {
+         *buf++ = '.';
+         memcpy(buf, digits + 1, nd - 1);
+         buf += nd - 1;
+      }
+      *buf++ = 'e';
+      return JsonSignedToChars(buf, exp10);
+   }
+
+   if (exp10 < 0) {
+      *buf++ = '0';
+      *buf++ = '.';
+      for (int n = exp10 + 1; n < 0; ++n) *buf++ = '0';
+      memcpy(buf, digits, nd);
+      return buf + nd;
+   }
+
+   for (int n = 0; n <= exp10; ++n) *buf++ = (n < nd) ? digits[n] : '0';
+   if (exp10 + 1 < nd) {
+      *buf++ = '.';
+      memcpy(buf, digits + exp10 + 1, nd - exp10 - 1);
+      buf += nd - exp10 - 1;
+   }
+   return buf;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes shortest representation of floating point value, which is converted
+/// back to exactly the same value. Buffer should have at least 40 bytes.
+/// Integer values written directly. For others number of significant digits is
+/// increased from mindigits until scaled value restores the original one -
+/// any shorter representation is found already with mindigits.
+/// Digits are produced without printf, result is verified once with strtod.
+/// In rare cases when double arithmetic is not precise enough, printf is used.
+/// Returns pointer after last written char
+
+template <typename T>
+char *JsonFloatToChars(char *buf, T value, int mindigits, int maxdigits)
+{
+   // integer values are most common in histograms
+   if ((value == std::floor(value)) && (std::fabs(value) < 1e15)) return JsonSignedToChars(buf, (Long64_t)value);
+
+   Double_t absval = std::fabs((Double_t)value);
+
+   if (std::isfinite(absval) && (absval > 1e-280) && (absval < 1e280)) {
+      int exp10 = (int)std::floor(std::log10(absval));
+      for (int digits = mindigits; digits <= maxdigits; ++digits) {
+         int shift = digits - 1 - exp10;
+         Double_t scaled = shift >= 0 ? absval * JsonPow10(shift) : absval / JsonPow10(-shift);
+         ULong64_t mant = (ULong64_t)std::llround(scaled);
+         Double_t restored = shift >= 0 ? mant / JsonPow10(shift) : mant * JsonPow10(-shift);
+         if ((T)restored != (T)absval) continue;
+         char *end = JsonDecimalToChars(buf, value < 0, mant, -shift, maxdigits);
+         *end = 0;
+         if (JsonRoundTrip(buf, value)) return end;
+         break;
+      }
+   }
+
+   int len = 0;
+   for (int digits = mindigits; digits <= maxdigits; ++digits) {
+      len = snprintf(buf, 40, "%.*g", digits, (Double_t)value);
+      if (!std::isfinite(value) || JsonRoundTrip(buf, value)) break;
+   }
+
+   // remove '+' sign and leading zeros from exponent
+   char *exp = (char *)memchr(buf, 'e', len);
+   if (!exp) return buf + len;
+
+   char *src = ++exp, *end = buf + len;
+   if (*src == '+')
+      src++;
+   else if (*src == '-')
+      *exp++ = *src++;
+   while ((*src == '0') && (src + 1 < end)) src++;
+   while (src < end) *exp++ = *src++;
+   return exp;
+}
+
+} // namespace
 
 // TArrayIndexProducer is used to correctly create
 // JSON array separators for multi-dimensional JSON arrays
@@ -2308,16 +2452,21 @@ void TBufferJSON::ReadFastArray(void ** /*startp*/, const TClass * /*cl*/,
 
 #define TJSONWriteArrayCompress(vname, arrsize, typname)             \
    {                                                                 \
+      /* reserve space once, most values need few chars */           \
+      if ((arrsize > 100) && (fValue.Capacity() < fValue.Length() + 4*arrsize)) \
+         fValue.Capacity(fValue.Length() + 4*arrsize);               \
+      char sbuf[200];                                                \
       if ((fCompact < 10) || (arrsize < 6)) {                        \
          fValue.Append("[");                                         \
          for (Int_t indx=0;indx<arrsize;indx++) {                    \
-            if (indx>0) fValue.Append(fArraySepar.Data());           \
+            if (indx>0) fValue.Append(fArraySepar);                  \
             JsonWriteBasic(vname[indx]);                             \
          }                                                           \
          fValue.Append("]");                                         \
       } else {                                                       \
          fValue.Append("{");                                         \
-         fValue.Append(TString::Format("\"$arr\":\"%s\"%s\"len\":%d",typname,fArraySepar.Data(),arrsize)); \
+         snprintf(sbuf, sizeof(sbuf), "\"$arr\":\"%s\"%s\"len\":%d",typname,fArraySepar.Data(),arrsize); \
+         fValue.Append(sbuf);                                        \
          Int_t aindx(0), bindx(arrsize);                             \
          while ((aindx<arrsize) && (vname[aindx]==0)) aindx++;       \
          while ((aindx<bindx) && (vname[bindx-1]==0)) bindx--;       \
@@ -2341,16 +2490,23 @@ void TBufferJSON::ReadFastArray(void ** /*startp*/, const TClass * /*cl*/,
                }                                                     \
                if (pp<=p0) continue;                                 \
                if (++suffixcnt > 0) suffix.Form("%d",suffixcnt);     \
-               if (p0!=lastp) fValue.Append(TString::Format("%s\"p%s\":%d", fArraySepar.Data(), suffix.Data(), p0)); \
+               if (p0!=lastp) {                                      \
+                  snprintf(sbuf, sizeof(sbuf), "%s\"p%s\":%d", fArraySepar.Data(), suffix.Data(), p0); \
+                  fValue.Append(sbuf);                               \
+               }                                                     \
                lastp = pp; /* remember cursor, it may be the same */ \
-               fValue.Append(TString::Format("%s\"v%s\":", fArraySepar.Data(), suffix.Data())); \
+               snprintf(sbuf, sizeof(sbuf), "%s\"v%s\":", fArraySepar.Data(), suffix.Data()); \
+               fValue.Append(sbuf);                                  \
                if ((nsame > 1) || (pp-p0 == 1)) {                    \
                   JsonWriteBasic(vname[p0]);                         \
-                  if (nsame>1) fValue.Append(TString::Format("%s\"n%s\":%d", fArraySepar.Data(), suffix.Data(), nsame)); \
+                  if (nsame>1) {                                     \
+                     snprintf(sbuf, sizeof(sbuf), "%s\"n%s\":%d", fArraySepar.Data(), suffix.Data(), nsame); \
+                     fValue.Append(sbuf);                            \
+                  }                                                  \
                } else {                                              \
                   fValue.Append("[");                                \
                   for (Int_t indx=p0;indx<pp;indx++) {               \
-                     if (indx>p0) fValue.Append(fArraySepar.Data()); \
+                     if (indx>p0) fValue.Append(fArraySepar);        \
                      JsonWriteBasic(vname[indx]);                    \
                   }                                                  \
                   fValue.Append("]");                                \
@@ -3102,8 +3258,7 @@ void TBufferJSON::WriteCharStar(char *s)
 void TBufferJSON::JsonWriteBasic(Char_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%d", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonSignedToChars(buf, value) - buf);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3112,8 +3267,7 @@ void TBufferJSON::JsonWriteBasic(Char_t value)
 void TBufferJSON::JsonWriteBasic(Short_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%hd", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonSignedToChars(buf, value) - buf);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3122,8 +3276,7 @@ void TBufferJSON::JsonWriteBasic(Short_t value)
 void TBufferJSON::JsonWriteBasic(Int_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%d", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonSignedToChars(buf, value) - buf);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3132,8 +3285,7 @@ void TBufferJSON::JsonWriteBasic(Int_t value)
 void TBufferJSON::JsonWriteBasic(Long_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%ld", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonSignedToChars(buf, value) - buf);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3142,8 +3294,7 @@ void TBufferJSON::JsonWriteBasic(Long_t value)
 void TBufferJSON::JsonWriteBasic(Long64_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), FLong64, value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonSignedToChars(buf, value) - buf);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3232,6 +3383,12 @@ void TBufferJSON::CompactFloatString(char* sbuf, unsigned len)
 void TBufferJSON::JsonWriteBasic(Float_t value)
 {
    char buf[200];
+   if (*fgFloatFmt == 0) {
+      // float has 6 to 9 significant digits
+      fValue.Append(buf, JsonFloatToChars(buf, value, 6, 9) - buf);
+      return;
+   }
+
    if (value == floor(value)) {
       snprintf(buf, sizeof(buf), "%1.0f", value);
    } else {
@@ -3247,6 +3404,12 @@ void TBufferJSON::JsonWriteBasic(Float_t value)
 void TBufferJSON::JsonWriteBasic(Double_t value)
 {
    char buf[200];
+   if (*fgDoubleFmt == 0) {
+      // double has 15 to 17 significant digits
+      fValue.Append(buf, JsonFloatToChars(buf, value, 15, 17) - buf);
+      return;
+   }
+
    if (value == floor(value)) {
       snprintf(buf, sizeof(buf), "%1.0f", value);
    } else {
@@ -3270,8 +3433,7 @@ void TBufferJSON::JsonWriteBasic(Bool_t value)
 void TBufferJSON::JsonWriteBasic(UChar_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%u", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonUnsignedToChars(buf, value) - buf);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3280,8 +3442,7 @@ void TBufferJSON::JsonWriteBasic(UChar_t value)
 void TBufferJSON::JsonWriteBasic(UShort_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%hu", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonUnsignedToChars(buf, value) - buf);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3290,8 +3451,7 @@ void TBufferJSON::JsonWriteBasic(UShort_t value)
 void TBufferJSON::JsonWriteBasic(UInt_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%u", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonUnsignedToChars(buf, value) - buf);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3300,8 +3460,7 @@ void TBufferJSON::JsonWriteBasic(UInt_t value)
 void TBufferJSON::JsonWriteBasic(ULong_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%lu", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonUnsignedToChars(buf, value) - buf);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3310,8 +3469,7 @@ void TBufferJSON::JsonWriteBasic(ULong_t value)
 void TBufferJSON::JsonWriteBasic(ULong64_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), FULong64, value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonUnsignedToChars(buf, value) - buf);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3371,18 +3529,21 @@ void TBufferJSON::JsonWriteConstChar(const char* value, Int_t len)
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// set printf format for float/double members, default "%e"
+/// set printf format for float/double members
+/// Empty string (default) means shortest representation, which is converted back
+/// to exactly the same value. It is also fastest, while integer values are
+/// written without printf. Previous default formats were "%e" and "%.14e".
 /// to change format only for doubles, use SetDoubleFormat
 
 void TBufferJSON::SetFloatFormat(const char *fmt)
 {
-   if (fmt == 0) fmt = "%e";
+   if (fmt == 0) fmt = "";
    fgFloatFmt = fmt;
    fgDoubleFmt = fmt;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// return current printf format for float members, default "%e"
+/// return current printf format for float members, default "" - shortest round-trip
 
 const char *TBufferJSON::GetFloatFormat()
 {
@@ -3390,17 +3551,17 @@ const char *TBufferJSON::GetFloatFormat()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// set printf format for double members, default "%.14e"
+/// set printf format for double members, default "" - shortest round-trip
 /// use it after SetFloatFormat, which also overwrites format for doubles
 
 void TBufferJSON::SetDoubleFormat(const char *fmt)
 {
-   if (fmt == 0) fmt = "%.14e";
+   if (fmt == 0) fmt = "";
    fgDoubleFmt = fmt;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// return current printf format for double members, default "%.14e"
+/// return current printf format for double members, default "" - shortest round-trip
 
 const char *TBufferJSON::GetDoubleFormat()
 {
@@ -86,12 +86,17 @@ void TBufferMerger::WriteOutputFile()
          TDirectory::TContext ctxt;
          {
             R__LOCKGUARD(gROOTMutex);
-            memfile.reset(new TMemFile(fName.c_str(), buffer->Buffer() + buffer->Length(), length, "read"));
+            memfile.reset(new TMemFile(fName.c_str(), TMemFile::ZeroCopyView_t(buffer->Buffer() + buffer->Length(), length)));
             buffer->SetBufferOffset(buffer->Length() + length);
             merger.AddFile(memfile.get(), false);
             merger.PartialMerge();
          }
          merger.Reset();
+         {
+            // The file reads directly from the buffer, delete it first.
+            R__LOCKGUARD(gROOTMutex);
+            memfile.reset();
+         }
       }
    }
 }
@@ -31,10 +31,11 @@ Int_t TBufferMergerFile::Write(const char *name, Int_t opt, Int_t bufsize)
    Int_t nbytes = TMemFile::Write(name, opt, bufsize);
 
    if (nbytes) {
-      TBufferFile *fBuffer = new TBufferFile(TBuffer::kWrite);
+      TBufferFile *fBuffer = new TBufferFile(TBuffer::kWrite, sizeof(Long64_t) + GetEND());
 
       fBuffer->WriteLong64(GetEND());
-      CopyTo(*fBuffer);
+      for (const auto &view : GetContentViews())
+         fBuffer->WriteFastArray(view.fStart, view.fSize);
 
       fMerger.Push(fBuffer);
       ResetAfterMerge(0);
@@ -47,6 +47,15 @@ End_Macro
 #include "TProcessUUID.h"
 #include "TVirtualMutex.h"
 #include "TEmulatedCollectionProxy.h"
+#include "RZip.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
@@ -1257,12 +1266,136 @@ void TDirectoryFile::ReadAll(Option_t* opt)
 
          if ((dir!=0) && (strcmp(opt,"dirs*")==0)) dir->ReadAll("dirs*");
       }
-   else
+   else {
+      // Keys are read ahead by windows of kReadAhead uncompressed bytes, see PrefetchKeys.
+      const Long64_t kReadAhead = 64*1024*1024;
+      Int_t nahead = 0;
       while ((key = (TKey *) next())) {
+         if (nahead == 0) {
+            TList window;
+            Long64_t nbytes = 0;
+            TIter ahead(next);
+            TKey *akey = key;
+            do {
+               window.Add(akey);
+               nbytes += akey->GetObjlen() + akey->GetKeylen();
+               ++nahead;
+            } while (nbytes < kReadAhead && (akey = (TKey *) ahead()));
+            PrefetchKeys(&window);
+         }
+         --nahead;
          TObject *thing = GetList()->FindObject(key->GetName());
          if (thing) { delete thing; }
          key->ReadObj();
       }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read and uncompress ahead of time the records of a set of keys.
+///
+/// The records of the keys in 'keys' (by default all the keys of this
+/// directory) are read from the file with a single vectored call to
+/// TFile::ReadBuffers, in the order of their position in the file, and are
+/// then uncompressed, in parallel on the implicit multi-threading pool when
+/// ROOT::EnableImplicitMT has been called. The uncompressed records are
+/// kept by the keys and the next call to TKey::ReadObj only deserializes
+/// the object, without accessing the file.
+///
+/// Only the keys of classes deriving from TObject (except directories) are
+/// prefetched. If maxbytes is positive, the keys are taken in the order of
+/// the collection until the total uncompressed size would exceed maxbytes.
+/// Returns the number of keys prefetched.
+
+Int_t TDirectoryFile::PrefetchKeys(TCollection *keys, Long64_t maxbytes)
+{
+   TFile *f = GetFile();
+   if (!f) return 0;
+   if (!keys) keys = GetListOfKeys();
+   if (!keys) return 0;
+
+   std::vector<TKey*> selected;
+   Long64_t total = 0;
+   TIter next(keys);
+   TObject *obj;
+   while ((obj = next())) {
+      if (obj->IsA() != TKey::Class()) continue;
+      TKey *key = static_cast<TKey*>(obj);
+      if (key->fPrefetchBuffer || key->fSeekKey <= 0 || key->fNbytes < key->fKeylen) continue;
+      if (key->GetFile() != f) continue;
+      TClass *cl = TClass::GetClass(key->GetClassName());
+      if (!cl || !cl->IsTObject() || cl->InheritsFrom(TDirectoryFile::Class())) continue;
+      Long64_t len = key->fObjlen + key->fKeylen;
+      if (maxbytes > 0 && total + len > maxbytes) break;
+      total += len;
+      selected.push_back(key);
+   }
+   if (selected.empty()) return 0;
+
+   std::sort(selected.begin(), selected.end(),
+             [](const TKey *a, const TKey *b) { return a->fSeekKey < b->fSeekKey; });
+   selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+
+   const UInt_t nkeys = selected.size();
+   std::vector<Long64_t> pos(nkeys);
+   std::vector<Int_t> len(nkeys);
+   std::vector<Long64_t> offset(nkeys);
+   Long64_t nbytes = 0;
+   for (UInt_t i = 0; i < nkeys; ++i) {
+      pos[i] = selected[i]->fSeekKey;
+      len[i] = selected[i]->fNbytes;
+      offset[i] = nbytes;
+      nbytes += len[i];
+   }
+   std::vector<char> records(nbytes);
+   if (f->ReadBuffers(records.data(), pos.data(), len.data(), nkeys)) {
+      Error("PrefetchKeys", "Failed to read the records of %u keys", nkeys);
+      return 0;
+   }
+
+   auto unzip = [&](UInt_t i) {
+      TKey *key = selected[i];
+      const char *src = records.data() + offset[i];
+      Int_t keylen = key->fKeylen;
+      Int_t objlen = key->fObjlen;
+      char *dest = new char[keylen + objlen];
+      memcpy(dest, src, keylen);
+      if (objlen > key->fNbytes - keylen) {
+         UChar_t *bufcur = (UChar_t *)src + keylen;
+         UChar_t *objbuf = (UChar_t *)dest + keylen;
+         Int_t nin, nbuf, nout = 0, noutot = 0;
+         while (noutot < objlen) {
+            if (R__unzip_header(&nin, bufcur, &nbuf) != 0 || nbuf > objlen - noutot) break;
+            R__unzip(&nin, bufcur, &nbuf, objbuf, &nout);
+            if (!nout) break;
+            noutot += nout;
+            bufcur += nin;
+            objbuf += nout;
+         }
+         if (noutot < objlen) {
+            // Leave it to TKey::ReadObj to read the key and report the error.
+            delete [] dest;
+            return;
+         }
+      } else {
+         memcpy(dest + keylen, src + keylen, objlen);
+      }
+      key->fPrefetchBuffer = dest;
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nkeys > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(unzip, ROOT::TSeqU(nkeys));
+   } else
+#endif
+   for (UInt_t i = 0; i < nkeys; ++i) unzip(i);
+
+   Int_t nprefetched = 0;
+   for (auto key : selected) {
+      if (key->fPrefetchBuffer) ++nprefetched;
+   }
+   return nprefetched;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -25,6 +25,7 @@ to be merged, like the standalone hadd program.
 
 #include "TFileMerger.h"
 #include "TDirectory.h"
+#include "TDirectoryFile.h"
 #include "TUrl.h"
 #include "TFile.h"
 #include "TUUID.h"
@@ -418,8 +419,37 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
          TKey *key;
          TString oldkeyname;
 
+         // The keys of the first file are read and uncompressed ahead by windows
+         // of kReadAhead bytes (see TDirectoryFile::PrefetchKeys), skipping the
+         // lower cycles that are not merged. The buffers of the keys of a window
+         // that were skipped are released when moving to the next window.
+         const Long64_t kReadAhead = 256*1024*1024;
+         TDirectoryFile *prefetchdir = current_file ? dynamic_cast<TDirectoryFile*>(current_sourcedir) : 0;
+         TList window;
+         Int_t nahead = 0;
+
          while ( (key = (TKey*)nextkey())) {
 
+            if (prefetchdir && nahead == 0) {
+               TIter prev(&window);
+               while (TKey *pkey = (TKey*)prev()) pkey->DeleteBuffer();
+               window.Clear();
+               Long64_t nbytes = 0;
+               TIter ahead(nextkey);
+               TKey *akey = key;
+               TString aname;
+               do {
+                  if (aname != akey->GetName()) {
+                     window.Add(akey);
+                     nbytes += akey->GetObjlen() + akey->GetKeylen();
+                     aname = akey->GetName();
+                  }
+                  ++nahead;
+               } while (nbytes < kReadAhead && (akey = (TKey*)ahead()));
+               prefetchdir->PrefetchKeys(&window);
+            }
+            if (nahead > 0) --nahead;
+
             // Keep only the highest cycle number for each key for mergeable objects. They are stored
             // in the (hash) list onsecutively and in decreasing order of cycles, so we can continue
             // until the name changes. We flag the case here and we act consequently later.
@@ -757,6 +787,8 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
             }
             info.Reset();
          } // while ( ( TKey *key = (TKey*)nextkey() ) )
+         TIter prev(&window);
+         while (TKey *pkey = (TKey*)prev()) pkey->DeleteBuffer();
       }
       current_file = current_file ? (TFile*)sourcelist->After(current_file) : (TFile*)sourcelist->First();
       if (current_file) {
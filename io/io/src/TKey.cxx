@@ -116,6 +116,7 @@ TKey::TKey(TDirectory* motherDir) : TNamed(), fDatime((UInt_t)0)
 TKey::TKey(TDirectory* motherDir, const TKey &orig, UShort_t pidOffset) : TNamed(), fDatime((UInt_t)0)
 {
    fMotherDir  = motherDir;
+   fPrefetchBuffer = 0;
 
    fPidOffset  = orig.fPidOffset + pidOffset;
    fNbytes     = orig.fNbytes;
@@ -402,6 +403,7 @@ void TKey::Build(TDirectory* motherDir, const char* classname, Long64_t filepos)
    fSeekPdir   = 0;
    fSeekKey    = 0;
    fLeft       = 0;
+   fPrefetchBuffer = 0;
 
    fClassName = classname;
    //the following test required for forward and backward compatibility
@@ -556,6 +558,8 @@ void TKey::DeleteBuffer()
       }
    }
    fBuffer = 0;
+   delete [] fPrefetchBuffer;
+   fPrefetchBuffer = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -739,7 +743,17 @@ TObject *TKey::ReadObj()
       return (TObject*)ReadObjectAny(0);
    }
 
-   fBufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
+   // The key may already have been read and uncompressed by TDirectoryFile::PrefetchKeys,
+   // in which case the buffer is adopted and the file is not accessed.
+   Bool_t compressed = fObjlen > fNbytes-fKeylen;
+   Bool_t prefetched = fPrefetchBuffer != 0;
+   if (prefetched) {
+      fBufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen, fPrefetchBuffer);
+      fPrefetchBuffer = 0;
+      compressed = kFALSE;
+   } else {
+      fBufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
+   }
    if (!fBufferRef) {
       Error("ReadObj", "Cannot allocate buffer: fObjlen = %d", fObjlen);
       return 0;
@@ -748,7 +762,9 @@ TObject *TKey::ReadObj()
    fBufferRef->SetParent(GetFile());
    fBufferRef->SetPidOffset(fPidOffset);
 
-   if (fObjlen > fNbytes-fKeylen) {
+   if (prefetched) {
+      fBuffer = fBufferRef->Buffer();
+   } else if (compressed) {
       fBuffer = new char[fNbytes];
       if( !ReadFile() )                    //Read object structure from file
       {
@@ -794,7 +810,7 @@ TObject *TKey::ReadObj()
    if (kvers > 1)
       fBufferRef->MapObject(pobj,cl);  //register obj in map to handle self reference
 
-   if (fObjlen > fNbytes-fKeylen) {
+   if (compressed) {
       char *objbuf = fBufferRef->Buffer() + fKeylen;
       UChar_t *bufcur = (UChar_t *)&fBuffer[fKeylen];
       Int_t nin, nout = 0, nbuf;
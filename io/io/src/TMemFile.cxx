@@ -28,6 +28,7 @@ only from memory.
 #include <errno.h>
 #include <stdio.h>
 #include <sys/stat.h>
+#include <algorithm>
 
 // The following snippet is used for developer-level debugging
 #define TMemFile_TRACE
@@ -41,6 +42,7 @@ only from memory.
 ClassImp(TMemFile);
 
 Long64_t TMemFile::fgDefaultBlockSize = 2*1024*1024;
+Long64_t TMemFile::fgMaxBlockSize = 128*1024*1024;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor.
@@ -82,7 +84,7 @@ void TMemFile::TMemBlock::CreateNext(Long64_t size)
 TMemFile::TMemFile(const char *path, Option_t *option,
                    const char *ftitle, Int_t compress) :
    TFile(path, "WEB", ftitle, compress),
-   fSize(-1), fSysOffset(0), fBlockSeek(&fBlockList), fBlockOffset(0)
+   fSize(-1), fSysOffset(0), fBlockSeek(&fBlockList), fBlockOffset(0), fIsOwnedByROOT(kTRUE)
 {
    fOption = option;
    fOption.ToUpper();
@@ -135,7 +137,7 @@ zombie:
 TMemFile::TMemFile(const char *path, char *buffer, Long64_t size, Option_t *option,
                    const char *ftitle, Int_t compress):
    TFile(path, "WEB", ftitle, compress), fBlockList(size),
-   fSize(size), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0)
+   fSize(size), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0), fIsOwnedByROOT(kTRUE)
 {
    fOption = option;
    fOption.ToUpper();
@@ -180,13 +182,41 @@ zombie:
    gDirectory = gROOT;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor reading, without copying it, the content of a file held in an
+/// external buffer, for example a memory mapped file or the result of
+/// GetContentViews when it is made of a single range.
+///
+/// The file is open read-only and the memory must remain valid and unchanged
+/// until the TMemFile is deleted.
+
+TMemFile::TMemFile(const char *path, const ZeroCopyView_t &datarange) :
+   TFile(path, "WEB", "", 1),
+   fSize(datarange.fSize), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0), fIsOwnedByROOT(kFALSE)
+{
+   fOption = "READ";
+   if (!datarange.fStart || datarange.fSize <= 0) {
+      Error("TMemFile", "Reading the file %s requires a non empty memory buffer", path);
+      MakeZombie();
+      gDirectory = gROOT;
+      return;
+   }
+   fBlockList.fBuffer = (UChar_t*)const_cast<char*>(datarange.fStart);
+   fBlockList.fSize = datarange.fSize;
+
+   fD = SysOpen(path, O_RDONLY, 0644);
+   fWritable = kFALSE;
+
+   Init(kFALSE);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copying the content of the TMemFile into another TMemFile.
 
 TMemFile::TMemFile(const TMemFile &orig) :
    TFile(orig.GetEndpointUrl()->GetUrl(), "WEB", orig.GetTitle(),
          orig.GetCompressionSettings() ), fBlockList(orig.GetEND()),
-   fSize(orig.GetEND()), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0)
+   fSize(orig.GetEND()), fSysOffset(0), fBlockSeek(&(fBlockList)), fBlockOffset(0), fIsOwnedByROOT(kTRUE)
 {
    fOption = orig.fOption;
 
@@ -217,6 +247,10 @@ TMemFile::~TMemFile()
    // Need to call close, now as it will need both our virtual table
    // and the content of the list of blocks
    Close();
+   if (!fIsOwnedByROOT) {
+      // Do not let TMemBlock delete the external buffer.
+      fBlockList.fBuffer = 0;
+   }
    TRACE("destroy")
 }
 
@@ -257,6 +291,27 @@ void TMemFile::CopyTo(TBuffer &tobuf) const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the ranges of memory holding the content of the file, up to GetEND(),
+/// in order.  This allows to write the file to disk or to a socket (for
+/// example with writev) or to copy it, without an intermediate copy.
+///
+/// The views are valid until the next write to the file.
+
+std::vector<TMemFile::ZeroCopyView_t> TMemFile::GetContentViews() const
+{
+   std::vector<ZeroCopyView_t> views;
+   Long64_t left = GetEND();
+   const TMemBlock *current = &fBlockList;
+   while (current && left > 0) {
+      Long64_t size = std::min(left, current->fSize);
+      views.push_back(ZeroCopyView_t((const char*)current->fBuffer, size));
+      left -= size;
+      current = current->fNext;
+   }
+   return views;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the current size of the memory file
 
@@ -292,6 +347,10 @@ void TMemFile::Print(Option_t *option /* = "" */) const
 
 void TMemFile::ResetAfterMerge(TFileMergeInfo *info)
 {
+   if (!fIsOwnedByROOT) {
+      Error("ResetAfterMerge", "The file %s is a read only view of an external buffer", GetName());
+      return;
+   }
    ResetObjects(this,info);
 
    fNbytesKeys = 0;
@@ -565,6 +624,18 @@ Int_t TMemFile::SysClose(Int_t /* fd */)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Append a block after the last one, fBlockSeek.  The size of the blocks
+/// doubles, starting at fgDefaultBlockSize and up to fgMaxBlockSize, so that
+/// large files are made of few blocks.
+
+void TMemFile::CreateNextBlock()
+{
+   Long64_t size = std::max(fgDefaultBlockSize, std::min(2*fBlockSeek->fSize, fgMaxBlockSize));
+   fBlockSeek->CreateNext(size);
+   fSize += size;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write a buffer into the file.
 
@@ -576,6 +647,10 @@ Int_t TMemFile::SysWriteImpl(Int_t /* fd */, const void *buf, Long64_t len)
       errno = EBADF;
       gSystem->SetErrorStr("The memory file is not open.");
       return 0;
+   } else if (!fIsOwnedByROOT) {
+      errno = EBADF;
+      gSystem->SetErrorStr("The memory file is a read only view of an external buffer.");
+      return 0;
    } else {
       if (fBlockOffset+len <= fBlockSeek->fSize) {
          // 'len' does not go past the end of the current block,
@@ -594,8 +669,7 @@ Int_t TMemFile::SysWriteImpl(Int_t /* fd */, const void *buf, Long64_t len)
          buf = (char*)buf + sublen;
          Int_t len_left = len - sublen;
          if (!fBlockSeek->fNext) {
-            fBlockSeek->CreateNext(fgDefaultBlockSize);
-            fSize += fgDefaultBlockSize;
+            CreateNextBlock();
          }
          fBlockSeek = fBlockSeek->fNext;
 
@@ -607,8 +681,7 @@ Int_t TMemFile::SysWriteImpl(Int_t /* fd */, const void *buf, Long64_t len)
             buf = (char*)buf + fBlockSeek->fSize;
             len_left -= fBlockSeek->fSize;
             if (!fBlockSeek->fNext) {
-               fBlockSeek->CreateNext(fgDefaultBlockSize);
-               fSize += fgDefaultBlockSize;
+               CreateNextBlock();
             }
             fBlockSeek = fBlockSeek->fNext;
          }
@@ -77,6 +77,7 @@ element type.
 #include <array>
 
 std::atomic<Int_t> TStreamerInfo::fgCount{0};
+Bool_t TStreamerInfo::fgBlockStreaming = kTRUE;
 
 const Int_t kMaxLen = 1024;
 
@@ -2531,10 +2532,10 @@ void TStreamerInfo::Clear(Option_t *option)
       ResetIsCompiled();
       ResetBit(kBuildOldUsed);
 
-      if (fReadObjectWise) fReadObjectWise->fActions.clear();
+      if (fReadObjectWise) { fReadObjectWise->fActions.clear(); fReadObjectWise->ResetBlockSequence(); }
       if (fReadMemberWise) fReadMemberWise->fActions.clear();
       if (fReadMemberWiseVecPtr) fReadMemberWiseVecPtr->fActions.clear();
-      if (fWriteObjectWise) fWriteObjectWise->fActions.clear();
+      if (fWriteObjectWise) { fWriteObjectWise->fActions.clear(); fWriteObjectWise->ResetBlockSequence(); }
       if (fWriteMemberWise) fWriteMemberWise->fActions.clear();
       if (fWriteMemberWiseVecPtr) fWriteMemberWiseVecPtr->fActions.clear();
       if (fWriteText) fWriteText->fActions.clear();
@@ -3043,6 +3044,27 @@ void TStreamerInfo::ComputeSize()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// static function: enable or disable the streaming of runs of consecutive
+/// numerical data members (without conversion) as a single block by
+/// TBufferFile. The setting applies to the TStreamerInfo compiled afterwards.
+/// Block streaming is enabled by default; it is also disabled by
+/// TVirtualStreamerInfo::Optimize(kFALSE).
+
+void TStreamerInfo::EnableBlockStreaming(Bool_t enable)
+{
+   fgBlockStreaming = enable;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// static function: return true if block streaming is enabled,
+/// see EnableBlockStreaming.
+
+Bool_t TStreamerInfo::IsBlockStreamingEnabled()
+{
+   return fgBlockStreaming;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Recursively mark streamer infos for writing to a file.
 ///
@@ -227,6 +227,248 @@ namespace TStreamerInfoActions
       return 0;
    }
 
+   class TBasicTypeBlockConfiguration : public TConfiguration {
+      // Configuration of a run of consecutive numerical data members (single
+      // values, fixed size arrays or regrouped members) streamed by one action.
+   public:
+      struct TItem {
+         Int_t fType;    // Basic type (TStreamerInfo::kChar ... TStreamerInfo::kULong64)
+         Int_t fOffset;  // Offset of the data member within the object
+         Int_t fLength;  // Number of values
+      };
+      std::vector<TItem> fItems;
+      Int_t              fSize;  // Number of bytes used by the block in a binary buffer
+
+      TBasicTypeBlockConfiguration(TVirtualStreamerInfo *info, UInt_t id, TCompInfo_t *compinfo) : TConfiguration(info,id,compinfo,0), fSize(0) {};
+
+      static Int_t GetItemSize(Int_t type)
+      {
+         switch (type) {
+            case TStreamerInfo::kBool:    return sizeof(Bool_t);
+            case TStreamerInfo::kChar:
+            case TStreamerInfo::kUChar:   return 1;
+            case TStreamerInfo::kShort:
+            case TStreamerInfo::kUShort:  return 2;
+            case TStreamerInfo::kInt:
+            case TStreamerInfo::kUInt:
+            case TStreamerInfo::kFloat:   return 4;
+            case TStreamerInfo::kLong64:
+            case TStreamerInfo::kULong64:
+            case TStreamerInfo::kDouble:  return 8;
+         }
+         return 0;
+      }
+
+      void AddItem(Int_t type, Int_t offset, Int_t length)
+      {
+         if (!fItems.empty()) {
+            // Merge with the previous item when contiguous in memory.
+            TItem &last = fItems.back();
+            if (last.fType == type && last.fOffset + last.fLength * GetItemSize(type) == offset) {
+               last.fLength += length;
+               fSize += length * GetItemSize(type);
+               return;
+            }
+         }
+         fItems.push_back(TItem{type, offset, length});
+         fSize += length * GetItemSize(type);
+      }
+
+      void AddToOffset(Int_t delta)
+      {
+         // Add the (potentially negative) delta to all the configuration's offset.  This is used by
+         // TBranchElement in the case of split sub-object.
+
+         fOffset += delta;
+         for (auto &item : fItems)
+            item.fOffset += delta;
+      }
+
+      void Print() const
+      {
+         TStreamerInfo *info = (TStreamerInfo*)fInfo;
+         printf("StreamerInfoAction, class:%s, block of %d numerical members starting at %s, %d bytes\n",
+                info->GetClass()->GetName(), (Int_t)fItems.size(), fCompInfo->fElem->GetName(), fSize);
+      }
+
+      void PrintDebug(TBuffer &buf, void *addr) const
+      {
+         if (gDebug > 1) {
+            TStreamerInfo *info = (TStreamerInfo*)fInfo;
+            printf("StreamerInfoAction, class:%s, block of %d numerical members starting at %s,"
+                   " bufpos=%d, arr=%p, %d bytes\n",
+                   info->GetClass()->GetName(), (Int_t)fItems.size(), fCompInfo->fElem->GetName(),
+                   buf.Length(), addr, fSize);
+         }
+      }
+
+      virtual TConfiguration *Copy() { return new TBasicTypeBlockConfiguration(*this); }
+   };
+
+   template <typename T>
+   struct BasicTypeArray {
+      // Decode (encode) n consecutive values of a numerical type from (into)
+      // the raw bytes of a binary buffer. The types with an array overload
+      // in Bytes.h are converted with the vectorized byte swap.
+
+      enum { kVectorized = kFALSE };
+
+      static INLINE_TEMPLATE_ARGS void Read(char *&cur, T *x, Int_t n)
+      {
+         for (Int_t j = 0; j < n; ++j)
+            frombuf(cur, x + j);
+      }
+
+      static INLINE_TEMPLATE_ARGS void Write(char *&cur, const T *x, Int_t n)
+      {
+         for (Int_t j = 0; j < n; ++j)
+            tobuf(cur, x[j]);
+      }
+   };
+
+#define R__BASICTYPEARRAY(type)                                                          \
+   template <>                                                                           \
+   struct BasicTypeArray<type> {                                                         \
+      enum { kVectorized = kTRUE };                                                      \
+      static INLINE_TEMPLATE_ARGS void Read(char *&cur, type *x, Int_t n) { frombuf(cur, x, n); } \
+      static INLINE_TEMPLATE_ARGS void Write(char *&cur, const type *x, Int_t n) { tobuf(cur, x, n); } \
+   };
+
+   R__BASICTYPEARRAY(Short_t)
+   R__BASICTYPEARRAY(UShort_t)
+   R__BASICTYPEARRAY(Int_t)
+   R__BASICTYPEARRAY(UInt_t)
+   R__BASICTYPEARRAY(Float_t)
+   R__BASICTYPEARRAY(Long64_t)
+   R__BASICTYPEARRAY(ULong64_t)
+   R__BASICTYPEARRAY(Double_t)
+
+#undef R__BASICTYPEARRAY
+
+   template <typename T>
+   INLINE_TEMPLATE_ARGS void ReadBlockItem(char *&cur, char *addr, Int_t length)
+   {
+      BasicTypeArray<T>::Read(cur, (T*)addr, length);
+   }
+
+   template <typename T>
+   INLINE_TEMPLATE_ARGS void WriteBlockItem(char *&cur, const char *addr, Int_t length)
+   {
+      BasicTypeArray<T>::Write(cur, (const T*)addr, length);
+   }
+
+   template <typename T>
+   INLINE_TEMPLATE_ARGS void ReadBlockItem(TBuffer &buf, char *addr, Int_t length)
+   {
+      if (length == 1) buf >> *(T*)addr;
+      else buf.ReadFastArray((T*)addr, length);
+   }
+
+   template <typename T>
+   INLINE_TEMPLATE_ARGS void WriteBlockItem(TBuffer &buf, char *addr, Int_t length)
+   {
+      if (length == 1) buf << *(T*)addr;
+      else buf.WriteFastArray((T*)addr, length);
+   }
+
+   Int_t ReadBasicTypeBlock(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      // Read a block of numerical data members. For a plain TBufferFile the
+      // values are decoded directly from the buffer with a single bound check
+      // instead of one virtual call per data member.
+
+      const TBasicTypeBlockConfiguration *conf = (const TBasicTypeBlockConfiguration*)config;
+      char *obj = (char*)addr;
+      if (typeid(buf) == typeid(TBufferFile) && buf.Length() + conf->fSize <= buf.BufferSize()) {
+         char *cur = buf.Buffer() + buf.Length();
+         for (const auto &item : conf->fItems) {
+            char *x = obj + item.fOffset;
+            switch (item.fType) {
+               case TStreamerInfo::kBool:    ReadBlockItem<Bool_t>(cur, x, item.fLength);    break;
+               case TStreamerInfo::kChar:    ReadBlockItem<Char_t>(cur, x, item.fLength);    break;
+               case TStreamerInfo::kShort:   ReadBlockItem<Short_t>(cur, x, item.fLength);   break;
+               case TStreamerInfo::kInt:     ReadBlockItem<Int_t>(cur, x, item.fLength);     break;
+               case TStreamerInfo::kLong64:  ReadBlockItem<Long64_t>(cur, x, item.fLength);  break;
+               case TStreamerInfo::kFloat:   ReadBlockItem<Float_t>(cur, x, item.fLength);   break;
+               case TStreamerInfo::kDouble:  ReadBlockItem<Double_t>(cur, x, item.fLength);  break;
+               case TStreamerInfo::kUChar:   ReadBlockItem<UChar_t>(cur, x, item.fLength);   break;
+               case TStreamerInfo::kUShort:  ReadBlockItem<UShort_t>(cur, x, item.fLength);  break;
+               case TStreamerInfo::kUInt:    ReadBlockItem<UInt_t>(cur, x, item.fLength);    break;
+               case TStreamerInfo::kULong64: ReadBlockItem<ULong64_t>(cur, x, item.fLength); break;
+            }
+         }
+         buf.SetBufferOffset(cur - buf.Buffer());
+         return 0;
+      }
+      // Derived buffers may encode the basic types differently (and the
+      // buffer could be truncated): go through the TBuffer interface.
+      for (const auto &item : conf->fItems) {
+         char *x = obj + item.fOffset;
+         switch (item.fType) {
+            case TStreamerInfo::kBool:    ReadBlockItem<Bool_t>(buf, x, item.fLength);    break;
+            case TStreamerInfo::kChar:    ReadBlockItem<Char_t>(buf, x, item.fLength);    break;
+            case TStreamerInfo::kShort:   ReadBlockItem<Short_t>(buf, x, item.fLength);   break;
+            case TStreamerInfo::kInt:     ReadBlockItem<Int_t>(buf, x, item.fLength);     break;
+            case TStreamerInfo::kLong64:  ReadBlockItem<Long64_t>(buf, x, item.fLength);  break;
+            case TStreamerInfo::kFloat:   ReadBlockItem<Float_t>(buf, x, item.fLength);   break;
+            case TStreamerInfo::kDouble:  ReadBlockItem<Double_t>(buf, x, item.fLength);  break;
+            case TStreamerInfo::kUChar:   ReadBlockItem<UChar_t>(buf, x, item.fLength);   break;
+            case TStreamerInfo::kUShort:  ReadBlockItem<UShort_t>(buf, x, item.fLength);  break;
+            case TStreamerInfo::kUInt:    ReadBlockItem<UInt_t>(buf, x, item.fLength);    break;
+            case TStreamerInfo::kULong64: ReadBlockItem<ULong64_t>(buf, x, item.fLength); break;
+         }
+      }
+      return 0;
+   }
+
+   Int_t WriteBasicTypeBlock(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      // Write a block of numerical data members, see ReadBasicTypeBlock.
+
+      const TBasicTypeBlockConfiguration *conf = (const TBasicTypeBlockConfiguration*)config;
+      char *obj = (char*)addr;
+      if (typeid(buf) == typeid(TBufferFile)) {
+         if (buf.Length() + conf->fSize > buf.BufferSize())
+            buf.AutoExpand(buf.Length() + conf->fSize);
+         char *cur = buf.Buffer() + buf.Length();
+         for (const auto &item : conf->fItems) {
+            const char *x = obj + item.fOffset;
+            switch (item.fType) {
+               case TStreamerInfo::kBool:    WriteBlockItem<Bool_t>(cur, x, item.fLength);    break;
+               case TStreamerInfo::kChar:    WriteBlockItem<Char_t>(cur, x, item.fLength);    break;
+               case TStreamerInfo::kShort:   WriteBlockItem<Short_t>(cur, x, item.fLength);   break;
+               case TStreamerInfo::kInt:     WriteBlockItem<Int_t>(cur, x, item.fLength);     break;
+               case TStreamerInfo::kLong64:  WriteBlockItem<Long64_t>(cur, x, item.fLength);  break;
+               case TStreamerInfo::kFloat:   WriteBlockItem<Float_t>(cur, x, item.fLength);   break;
+               case TStreamerInfo::kDouble:  WriteBlockItem<Double_t>(cur, x, item.fLength);  break;
+               case TStreamerInfo::kUChar:   WriteBlockItem<UChar_t>(cur, x, item.fLength);   break;
+               case TStreamerInfo::kUShort:  WriteBlockItem<UShort_t>(cur, x, item.fLength);  break;
+               case TStreamerInfo::kUInt:    WriteBlockItem<UInt_t>(cur, x, item.fLength);    break;
+               case TStreamerInfo::kULong64: WriteBlockItem<ULong64_t>(cur, x, item.fLength); break;
+            }
+         }
+         buf.SetBufferOffset(cur - buf.Buffer());
+         return 0;
+      }
+      for (const auto &item : conf->fItems) {
+         char *x = obj + item.fOffset;
+         switch (item.fType) {
+            case TStreamerInfo::kBool:    WriteBlockItem<Bool_t>(buf, x, item.fLength);    break;
+            case TStreamerInfo::kChar:    WriteBlockItem<Char_t>(buf, x, item.fLength);    break;
+            case TStreamerInfo::kShort:   WriteBlockItem<Short_t>(buf, x, item.fLength);   break;
+            case TStreamerInfo::kInt:     WriteBlockItem<Int_t>(buf, x, item.fLength);     break;
+            case TStreamerInfo::kLong64:  WriteBlockItem<Long64_t>(buf, x, item.fLength);  break;
+            case TStreamerInfo::kFloat:   WriteBlockItem<Float_t>(buf, x, item.fLength);   break;
+            case TStreamerInfo::kDouble:  WriteBlockItem<Double_t>(buf, x, item.fLength);  break;
+            case TStreamerInfo::kUChar:   WriteBlockItem<UChar_t>(buf, x, item.fLength);   break;
+            case TStreamerInfo::kUShort:  WriteBlockItem<UShort_t>(buf, x, item.fLength);  break;
+            case TStreamerInfo::kUInt:    WriteBlockItem<UInt_t>(buf, x, item.fLength);    break;
+            case TStreamerInfo::kULong64: WriteBlockItem<ULong64_t>(buf, x, item.fLength); break;
+         }
+      }
+      return 0;
+   }
+
    INLINE_TEMPLATE_ARGS Int_t WriteTextTNamed(TBuffer &buf, void *addr, const TConfiguration *config)
    {
       void *x = (void*)( ((char*)addr) + config->fOffset );
@@ -1562,11 +1804,32 @@ namespace TStreamerInfoActions
 
    struct VectorPtrLooper {
 
+      enum { kGatherChunk = 256 }; // number of values converted at once by the gather/scatter loops
+
       template <typename T>
       static INLINE_TEMPLATE_ARGS Int_t ReadBasicType(TBuffer &buf, void *iter, const void *end, const TConfiguration *config)
       {
          const Int_t offset = config->fOffset;
 
+         const Int_t n = ((char*)end - (char*)iter) / sizeof(void*);
+         if (BasicTypeArray<T>::kVectorized && typeid(buf) == typeid(TBufferFile)
+             && buf.Length() + n * (Int_t)sizeof(T) <= buf.BufferSize()) {
+            // Member-wise streaming stores the n values of this data member
+            // contiguously: decode them in chunks with the vectorized byte
+            // swap and scatter them into the objects.
+            T values[kGatherChunk];
+            char *cur = buf.Buffer() + buf.Length();
+            while (iter != end) {
+               Int_t nchunk = ((char*)end - (char*)iter) / sizeof(void*);
+               if (nchunk > kGatherChunk) nchunk = kGatherChunk;
+               BasicTypeArray<T>::Read(cur, values, nchunk);
+               for (Int_t j = 0; j < nchunk; ++j, iter = (char*)iter + sizeof(void*))
+                  *(T*)( ((char*) (*(void**)iter) ) + offset ) = values[j];
+            }
+            buf.SetBufferOffset(cur - buf.Buffer());
+            return 0;
+         }
+
          for(; iter != end; iter = (char*)iter + sizeof(void*) ) {
             T *x = (T*)( ((char*) (*(void**)iter) ) + offset );
             buf >> *x;
@@ -1650,6 +1913,25 @@ namespace TStreamerInfoActions
       {
          const Int_t offset = config->fOffset;
 
+         const Int_t n = ((char*)end - (char*)iter) / sizeof(void*);
+         if (BasicTypeArray<T>::kVectorized && typeid(buf) == typeid(TBufferFile)) {
+            // Gather the values from the objects and encode them in chunks,
+            // see ReadBasicType.
+            if (buf.Length() + n * (Int_t)sizeof(T) > buf.BufferSize())
+               buf.AutoExpand(buf.Length() + n * sizeof(T));
+            T values[kGatherChunk];
+            char *cur = buf.Buffer() + buf.Length();
+            while (iter != end) {
+               Int_t nchunk = ((char*)end - (char*)iter) / sizeof(void*);
+               if (nchunk > kGatherChunk) nchunk = kGatherChunk;
+               for (Int_t j = 0; j < nchunk; ++j, iter = (char*)iter + sizeof(void*))
+                  values[j] = *(T*)( ((char*) (*(void**)iter) ) + offset );
+               BasicTypeArray<T>::Write(cur, values, nchunk);
+            }
+            buf.SetBufferOffset(cur - buf.Buffer());
+            return 0;
+         }
+
          for(; iter != end; iter = (char*)iter + sizeof(void*) ) {
             T *x = (T*)( ((char*) (*(void**)iter) ) + offset );
             buf << *x;
@@ -2496,10 +2778,10 @@ void TStreamerInfo::Compile()
    Int_t ndata = fElements->GetEntries();
 
 
-   if (fReadObjectWise) fReadObjectWise->fActions.clear();
+   if (fReadObjectWise) { fReadObjectWise->fActions.clear(); fReadObjectWise->ResetBlockSequence(); }
    else fReadObjectWise = new TStreamerInfoActions::TActionSequence(this,ndata);
 
-   if (fWriteObjectWise) fWriteObjectWise->fActions.clear();
+   if (fWriteObjectWise) { fWriteObjectWise->fActions.clear(); fWriteObjectWise->ResetBlockSequence(); }
    else fWriteObjectWise = new TStreamerInfoActions::TActionSequence(this,ndata);
 
    if (fReadMemberWise) fReadMemberWise->fActions.clear();
@@ -2679,6 +2961,10 @@ void TStreamerInfo::Compile()
       AddReadAction(fReadObjectWise, i, fCompOpt[i]);
       AddWriteAction(fWriteObjectWise, i, fCompOpt[i]);
    }
+   if (fgBlockStreaming && !TestBit(kCannotOptimize)) {
+      fReadObjectWise->CreateBlockSequence(kTRUE);
+      fWriteObjectWise->CreateBlockSequence(kFALSE);
+   }
    for (i = 0; i < fNfulldata; ++i) {
       if (!fCompFull[i]->fElem || fCompFull[i]->fElem->GetType()< 0) {
          continue;
@@ -3532,6 +3818,8 @@ void TStreamerInfoActions::TActionSequence::AddToOffset(Int_t delta)
    // Add the (potentially negative) delta to all the configuration's offset.  This is used by
    // TBranchElement in the case of split sub-object.
 
+   if (fBlockSequence) fBlockSequence->AddToOffset(delta);
+
    TStreamerInfoActions::ActionContainer_t::iterator end = fActions.end();
    for(TStreamerInfoActions::ActionContainer_t::iterator iter = fActions.begin();
        iter != end;
@@ -3558,9 +3846,101 @@ TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::Cr
       TConfiguration *conf = iter->fConfiguration->Copy();
       sequence->AddAction( iter->fAction, conf );
    }
+   if (fBlockSequence) sequence->fBlockSequence = fBlockSequence->CreateCopy();
    return sequence;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the basic type streamed by the action if it can be part of a block
+/// of numerical data members (see CreateBlockSequence), -1 otherwise.
+/// 'offset' and 'length' are set to the location and number of values.
+
+static Int_t R__GetBlockItem(const TStreamerInfoActions::TConfiguredAction &action, Bool_t read, Int_t &offset, Int_t &length)
+{
+   using namespace TStreamerInfoActions;
+
+   const TConfiguration *conf = action.fConfiguration;
+   TStreamerInfoAction_t func = action.fAction;
+   if (!conf->fCompInfo || !conf->fCompInfo->fElem || conf->fCompInfo->fElem->TestBit(TStreamerElement::kCache))
+      return -1; // The value is taken from (or stored in) the data cache of a schema rule.
+   offset = conf->fOffset;
+   length = 1;
+   if (read) {
+      if (func == ReadBasicType<Bool_t>)    return TStreamerInfo::kBool;
+      if (func == ReadBasicType<Char_t>)    return TStreamerInfo::kChar;
+      if (func == ReadBasicType<Short_t>)   return TStreamerInfo::kShort;
+      if (func == ReadBasicType<Int_t>)     return TStreamerInfo::kInt;
+      if (func == ReadBasicType<Long64_t>)  return TStreamerInfo::kLong64;
+      if (func == ReadBasicType<Float_t>)   return TStreamerInfo::kFloat;
+      if (func == ReadBasicType<Double_t>)  return TStreamerInfo::kDouble;
+      if (func == ReadBasicType<UChar_t>)   return TStreamerInfo::kUChar;
+      if (func == ReadBasicType<UShort_t>)  return TStreamerInfo::kUShort;
+      if (func == ReadBasicType<UInt_t>)    return TStreamerInfo::kUInt;
+      if (func == ReadBasicType<ULong64_t>) return TStreamerInfo::kULong64;
+      if (func != GenericReadAction) return -1;
+   } else {
+      if (func == WriteBasicType<Bool_t>)    return TStreamerInfo::kBool;
+      if (func == WriteBasicType<Char_t>)    return TStreamerInfo::kChar;
+      if (func == WriteBasicType<Short_t>)   return TStreamerInfo::kShort;
+      if (func == WriteBasicType<Int_t>)     return TStreamerInfo::kInt;
+      if (func == WriteBasicType<Long64_t>)  return TStreamerInfo::kLong64;
+      if (func == WriteBasicType<Float_t>)   return TStreamerInfo::kFloat;
+      if (func == WriteBasicType<Double_t>)  return TStreamerInfo::kDouble;
+      if (func == WriteBasicType<UChar_t>)   return TStreamerInfo::kUChar;
+      if (func == WriteBasicType<UShort_t>)  return TStreamerInfo::kUShort;
+      if (func == WriteBasicType<UInt_t>)    return TStreamerInfo::kUInt;
+      if (func == WriteBasicType<ULong64_t>) return TStreamerInfo::kULong64;
+      if (func != GenericWriteAction) return -1;
+   }
+   // Fixed size arrays and regrouped members handled by the legacy code.
+   Int_t type = conf->fCompInfo->fType - TStreamerInfo::kOffsetL;
+   if (!TBasicTypeBlockConfiguration::GetItemSize(type) || conf->fCompInfo->fLength <= 0)
+      return -1;
+   offset = conf->fCompInfo->fOffset + conf->fOffset;
+   length = conf->fCompInfo->fLength;
+   return type;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create fBlockSequence, a version of this sequence where each run of
+/// consecutive actions streaming numerical data members without conversion
+/// (no schema evolution, Double32_t or Float16_t) is replaced by one action.
+/// TBufferFile::ApplySequence uses it when available; the text based buffers
+/// continue to use the per element actions.
+
+void TStreamerInfoActions::TActionSequence::CreateBlockSequence(Bool_t read)
+{
+   delete fBlockSequence;
+   fBlockSequence = 0;
+
+   TActionSequence *sequence = new TActionSequence(fStreamerInfo, fActions.size());
+   TBasicTypeBlockConfiguration *block = 0;
+   Int_t nmerged = 0;
+   for (auto &action : fActions) {
+      Int_t offset, length;
+      Int_t type = R__GetBlockItem(action, read, offset, length);
+      if (type < 0) {
+         block = 0;
+         sequence->AddAction(action.fAction, action.fConfiguration->Copy());
+         continue;
+      }
+      if (!block) {
+         block = new TBasicTypeBlockConfiguration(action.fConfiguration->fInfo, action.fConfiguration->fElemId, action.fConfiguration->fCompInfo);
+         if (read) sequence->AddAction(ReadBasicTypeBlock, block);
+         else      sequence->AddAction(WriteBasicTypeBlock, block);
+      } else {
+         ++nmerged;
+      }
+      block->AddItem(type, offset, length);
+   }
+   if (!nmerged) {
+      // Nothing gained compared to the original sequence.
+      delete sequence;
+      return;
+   }
+   fBlockSequence = sequence;
+}
+
 TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::CreateSubSequence(const std::vector<Int_t> &element_ids, size_t offset)
 {
    // Create a sequence containing the subset of the action corresponding to the SteamerElement whose ids is contained in the vector.
@@ -0,0 +1,57 @@
+#include "TBufferFile.h"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// The array streamers byteswap several values at once: check that they
+// produce the same bytes as the one-value-at-a-time encoding, for all the
+// lengths around the vector width.
+template <typename T>
+void CheckArrays(T first, T step)
+{
+   for (Int_t n = 0; n < 40; ++n) {
+      std::vector<T> values(n);
+      for (Int_t i = 0; i < n; ++i)
+         values[i] = first + step * i;
+
+      TBufferFile warray(TBuffer::kWrite);
+      TBufferFile wscalar(TBuffer::kWrite);
+      warray.WriteFastArray(values.data(), n);
+      for (Int_t i = 0; i < n; ++i)
+         wscalar << values[i];
+      ASSERT_EQ(warray.Length(), wscalar.Length());
+      EXPECT_EQ(0, memcmp(warray.Buffer(), wscalar.Buffer(), warray.Length()));
+
+      std::vector<T> result(n);
+      TBufferFile rarray(TBuffer::kRead, warray.Length(), warray.Buffer(), kFALSE);
+      rarray.ReadFastArray(result.data(), n);
+      EXPECT_EQ(warray.Length(), rarray.Length());
+      EXPECT_EQ(values, result);
+   }
+}
+
+TEST(BufferArrays, Short)
+{
+   CheckArrays<Short_t>(-300, 17);
+   CheckArrays<UShort_t>(1, 1031);
+}
+
+TEST(BufferArrays, Int)
+{
+   CheckArrays<Int_t>(-100000, 65537);
+   CheckArrays<UInt_t>(7, 16777259);
+}
+
+TEST(BufferArrays, Long64)
+{
+   CheckArrays<Long64_t>(-(1LL << 40), (1LL << 33) + 3);
+   CheckArrays<ULong64_t>(5, (1ULL << 35) + 11);
+}
+
+TEST(BufferArrays, Floating)
+{
+   CheckArrays<Float_t>(-1.5f, 0.123f);
+   CheckArrays<Double_t>(-2.5e10, 1.0e9 / 3);
+}
@@ -0,0 +1,118 @@
+#include "TBufferJSON.h"
+#include "TClass.h"
+#include "TH1.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// Parses comma-separated numbers of the JSON array, which starts after pos
+std::vector<Double_t> ParseArray(const TString &json, Ssiz_t pos = 0)
+{
+   std::vector<Double_t> res;
+   const char *p = strchr(json.Data() + pos, '[');
+   EXPECT_NE(p, nullptr);
+   if (!p) return res;
+   ++p;
+   while (true) {
+      while (*p == ' ' || *p == '\n') ++p;
+      if (*p == ']') break;
+      char *end = nullptr;
+      res.push_back(strtod(p, &end));
+      EXPECT_NE(end, p) << "not a number at: " << p;
+      if (end == p) break;
+      p = end;
+      while (*p == ' ' || *p == '\n') ++p;
+      if (*p == ',') ++p;
+      else EXPECT_EQ(*p, ']') << "unexpected after number: " << p;
+   }
+   return res;
+}
+
+// Parses numeric value of member "name" in JSON object
+Double_t ParseMember(const TString &json, const char *name)
+{
+   TString key = TString::Format("\"%s\"", name);
+   Ssiz_t pos = json.Index(key);
+   EXPECT_NE(pos, kNPOS) << name;
+   if (pos == kNPOS) return 0.;
+   const char *p = strchr(json.Data() + pos + key.Length(), ':');
+   char *end = nullptr;
+   Double_t res = strtod(p + 1, &end);
+   while (*end == ' ') ++end;
+   EXPECT_TRUE(*end == ',' || *end == '\n' || *end == '}') << name << " followed by: " << end;
+   return res;
+}
+
+std::vector<Double_t> Values()
+{
+   return {0., 1., -1., 7., 100., 123456789., 1e15, 1e16, -1e20, 0.1, -0.5, 1. / 3., 3.14159, 2.5e-7, 1e-300, 1.7e308};
+}
+
+TEST(TBufferJSON, Doubles)
+{
+   std::vector<Double_t> values = Values();
+   TString json = TBufferJSON::ConvertToJSON(&values, TClass::GetClass("vector<double>"));
+   EXPECT_EQ(ParseArray(json), values) << json;
+   // integral values are written as integers, not duplicated or followed by garbage
+   EXPECT_TRUE(json.Contains("[0, 1, -1, 7, 100, 123456789, ")) << json;
+   EXPECT_TRUE(json.Contains(", 0.1, -0.5, ")) << json;
+}
+
+TEST(TBufferJSON, Floats)
+{
+   std::vector<Float_t> values;
+   for (auto v : Values())
+      if (v < 1e38 && v > -1e38) values.push_back(v);
+   TString json = TBufferJSON::ConvertToJSON(&values, TClass::GetClass("vector<float>"));
+   std::vector<Double_t> parsed = ParseArray(json);
+   ASSERT_EQ(parsed.size(), values.size()) << json;
+   for (size_t n = 0; n < values.size(); ++n)
+      EXPECT_EQ((Float_t)parsed[n], values[n]) << json;
+   EXPECT_TRUE(json.Contains(", 0.1, -0.5, ")) << json;
+}
+
+template <typename HIST, typename T>
+void CheckHistogram()
+{
+   HIST h("h", "json round-trip", 20, -1., 1.);
+   h.SetDirectory(nullptr);
+   std::vector<Double_t> values = Values();
+   for (size_t n = 0; n < values.size(); ++n)
+      if (values[n] < 1e38 && values[n] > -1e38) h.SetBinContent(n + 1, values[n]);
+   for (Int_t n = 0; n < 100; ++n)
+      h.Fill(-1. + n / 50., n % 3 ? 1. : 0.37);
+
+   TString json = TBufferJSON::ConvertToJSON(&h);
+
+   std::vector<Double_t> parsed = ParseArray(json, json.Index("\"fArray\""));
+   ASSERT_EQ(parsed.size(), (size_t)h.GetNcells()) << json;
+   for (Int_t n = 0; n < h.GetNcells(); ++n)
+      EXPECT_EQ((T)parsed[n], (T)h.GetBinContent(n)) << "bin " << n;
+
+   Double_t stats[4];
+   h.GetStats(stats);
+   EXPECT_EQ(ParseMember(json, "fTsumw"), stats[0]);
+   EXPECT_EQ(ParseMember(json, "fTsumw2"), stats[1]);
+   EXPECT_EQ(ParseMember(json, "fTsumwx"), stats[2]);
+   EXPECT_EQ(ParseMember(json, "fTsumwx2"), stats[3]);
+   EXPECT_EQ(ParseMember(json, "fEntries"), h.GetEntries());
+   EXPECT_EQ(ParseMember(json, "fMaximum"), -1111.);
+}
+
+TEST(TBufferJSON, Histograms)
+{
+   CheckHistogram<TH1F, Float_t>();
+   CheckHistogram<TH1D, Double_t>();
+}
+
+TEST(TBufferJSON, ExplicitFormat)
+{
+   std::vector<Double_t> values = {7., 0.5, 0.126};
+   TBufferJSON::SetDoubleFormat("%.2f");
+   TString json = TBufferJSON::ConvertToJSON(&values, TClass::GetClass("vector<double>"));
+   TBufferJSON::SetDoubleFormat();
+   EXPECT_TRUE(json.Contains("[7, 0.5, 0.13]")) << json;
+}
@@ -0,0 +1,77 @@
+#include "TFile.h"
+#include "TKey.h"
+#include "TList.h"
+#include "TNamed.h"
+#include "TSystem.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace {
+const char *kFileName = "testPrefetchKeys.root";
+const Int_t kNobjects = 50;
+
+TString MakeTitle(Int_t i)
+{
+   // Long enough for most of the objects to be compressed, short for the first ones.
+   TString title;
+   for (Int_t j = 0; j < i * 20; ++j)
+      title += TString::Format("%d-%d ", i, j % 7);
+   return title;
+}
+
+void WriteObjects()
+{
+   TFile f(kFileName, "RECREATE");
+   for (Int_t i = 0; i < kNobjects; ++i) {
+      TNamed obj(TString::Format("obj%d", i), MakeTitle(i));
+      obj.Write();
+   }
+   f.mkdir("subdir");
+   f.Close();
+}
+}
+
+TEST(PrefetchKeys, ReadObj)
+{
+   WriteObjects();
+   std::unique_ptr<TFile> f(TFile::Open(kFileName));
+   ASSERT_TRUE(f && !f->IsZombie());
+
+   // Directories are not prefetched.
+   EXPECT_EQ(kNobjects, f->PrefetchKeys());
+   // Already prefetched keys are not read again.
+   EXPECT_EQ(0, f->PrefetchKeys());
+
+   TIter next(f->GetListOfKeys());
+   TKey *key;
+   Int_t nobjects = 0;
+   while ((key = (TKey *)next())) {
+      std::unique_ptr<TObject> obj(key->ReadObj());
+      ASSERT_TRUE(obj.get() != nullptr);
+      if (obj->InheritsFrom(TDirectory::Class())) {
+         obj.release();
+         continue;
+      }
+      Int_t i = TString(obj->GetName() + 3).Atoi();
+      EXPECT_EQ(MakeTitle(i), obj->GetTitle());
+      ++nobjects;
+   }
+   EXPECT_EQ(kNobjects, nobjects);
+   gSystem->Unlink(kFileName);
+}
+
+TEST(PrefetchKeys, MaxBytes)
+{
+   WriteObjects();
+   std::unique_ptr<TFile> f(TFile::Open(kFileName));
+   ASSERT_TRUE(f && !f->IsZombie());
+
+   TList keys;
+   keys.Add(f->GetListOfKeys()->FindObject("obj0"));
+   keys.Add(f->GetListOfKeys()->FindObject("obj49"));
+   EXPECT_EQ(0, f->PrefetchKeys(&keys, 1));
+   EXPECT_EQ(2, f->PrefetchKeys(&keys));
+   gSystem->Unlink(kFileName);
+}
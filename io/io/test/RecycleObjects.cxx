@@ -0,0 +1,49 @@
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TNamed.h"
+#include "TObjString.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+void WritePointer(TBufferFile &b, TObject *obj)
+{
+   void *ptr = obj;
+   b.WriteFastArray(&ptr, obj->IsA(), 1, kFALSE);
+}
+}
+
+// With kRecycleObjects, the object replaced by ReadFastArray is reconstructed
+// in place when the object read has the same class, and deleted otherwise.
+TEST(RecycleObjects, ReadFastArray)
+{
+   TNamed first("first", "the first object");
+   TBufferFile w(TBuffer::kWrite);
+   WritePointer(w, &first);
+
+   for (Bool_t recycle : {kFALSE, kTRUE}) {
+      void *ptr = new TNamed("old", "to be replaced");
+      TBufferFile r(TBuffer::kRead, w.Length(), w.Buffer(), kFALSE);
+      r.SetBit(TBufferFile::kRecycleObjects, recycle);
+      void *old = ptr;
+      r.ReadFastArray(&ptr, TNamed::Class(), 1, kFALSE);
+      ASSERT_TRUE(ptr != nullptr);
+      if (recycle)
+         EXPECT_EQ(old, ptr);
+      TNamed *named = static_cast<TNamed *>(ptr);
+      EXPECT_STREQ("first", named->GetName());
+      EXPECT_STREQ("the first object", named->GetTitle());
+      delete named;
+   }
+
+   TObjString other("other");
+   TBufferFile w2(TBuffer::kWrite);
+   WritePointer(w2, &other);
+   void *ptr = new TObjString("old");
+   TBufferFile r(TBuffer::kRead, w2.Length(), w2.Buffer(), kFALSE);
+   r.SetBit(TBufferFile::kRecycleObjects);
+   r.ReadFastArray(&ptr, TObject::Class(), 1, kFALSE);
+   ASSERT_TRUE(ptr != nullptr);
+   EXPECT_STREQ("other", static_cast<TObjString *>(ptr)->GetName());
+   delete static_cast<TObjString *>(ptr);
+}
@@ -0,0 +1,103 @@
+#include "TBufferFile.h"
+#include "TStreamerInfo.h"
+#include "TStreamerInfoActions.h"
+#include "TAttLine.h"
+#include "TAttMarker.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+// A buffer with the same encoding as TBufferFile, but for which the blocks of
+// numerical data members are streamed through the TBuffer interface.
+class TDerivedBuffer : public TBufferFile {
+public:
+   TDerivedBuffer(TBuffer::EMode mode) : TBufferFile(mode) {}
+   TDerivedBuffer(TBuffer::EMode mode, Int_t bufsiz, void *buf) : TBufferFile(mode, bufsiz, buf, kFALSE) {}
+};
+
+TEST(StreamerInfoBlocks, SameEncoding)
+{
+   ASSERT_TRUE(TStreamerInfo::IsBlockStreamingEnabled());
+
+   TAttMarker marker(2, 21, 1.5);
+   TAttLine line(4, 2, 3);
+
+   TBufferFile wfile(TBuffer::kWrite);
+   TDerivedBuffer wderived(TBuffer::kWrite);
+   for (int n = 0; n < 1000; ++n) {
+      marker.Streamer(wfile);
+      line.Streamer(wfile);
+      marker.Streamer(wderived);
+      line.Streamer(wderived);
+   }
+   ASSERT_EQ(wfile.Length(), wderived.Length());
+   EXPECT_EQ(0, memcmp(wfile.Buffer(), wderived.Buffer(), wfile.Length()));
+
+   TBufferFile rfile(TBuffer::kRead, wfile.Length(), wfile.Buffer(), kFALSE);
+   TDerivedBuffer rderived(TBuffer::kRead, wfile.Length(), wfile.Buffer());
+   for (int n = 0; n < 1000; ++n) {
+      TAttMarker m1, m2;
+      TAttLine l1, l2;
+      m1.Streamer(rfile);
+      l1.Streamer(rfile);
+      m2.Streamer(rderived);
+      l2.Streamer(rderived);
+      EXPECT_EQ(2, m1.GetMarkerColor());
+      EXPECT_EQ(21, m1.GetMarkerStyle());
+      EXPECT_FLOAT_EQ(1.5, m1.GetMarkerSize());
+      EXPECT_EQ(4, l1.GetLineColor());
+      EXPECT_EQ(2, l1.GetLineStyle());
+      EXPECT_EQ(3, l1.GetLineWidth());
+      EXPECT_EQ(m1.GetMarkerColor(), m2.GetMarkerColor());
+      EXPECT_EQ(m1.GetMarkerStyle(), m2.GetMarkerStyle());
+      EXPECT_EQ(m1.GetMarkerSize(), m2.GetMarkerSize());
+      EXPECT_EQ(l1.GetLineWidth(), l2.GetLineWidth());
+   }
+   EXPECT_EQ(wfile.Length(), rfile.Length());
+   EXPECT_EQ(wfile.Length(), rderived.Length());
+}
+
+// Write the same objects as in SameEncoding with the current streamer actions
+void WriteAttributes(TBufferFile &buf)
+{
+   TAttMarker marker(2, 21, 1.5);
+   TAttLine line(4, 2, 3);
+   for (int n = 0; n < 100; ++n) {
+      marker.Streamer(buf);
+      line.Streamer(buf);
+   }
+}
+
+TEST(StreamerInfoBlocks, MergedActions)
+{
+   ASSERT_TRUE(TStreamerInfo::IsBlockStreamingEnabled());
+
+   TBufferFile wblocks(TBuffer::kWrite);
+   WriteAttributes(wblocks);
+
+   // All data members of TAttMarker are numerical, they are streamed by a single block action
+   TStreamerInfo *info = (TStreamerInfo *)TAttMarker::Class()->GetStreamerInfo();
+   ASSERT_NE(nullptr, info);
+   for (auto sequence : {info->GetReadObjectWiseActions(), info->GetWriteObjectWiseActions()}) {
+      ASSERT_NE(nullptr, sequence);
+      ASSERT_NE(nullptr, sequence->fBlockSequence);
+      EXPECT_GT(sequence->fActions.size(), sequence->fBlockSequence->fActions.size());
+      EXPECT_EQ(1u, sequence->fBlockSequence->fActions.size());
+   }
+
+   // Without block streaming the per element actions are used, with the same encoding
+   TStreamerInfo::EnableBlockStreaming(kFALSE);
+   info->Compile();
+   EXPECT_EQ(nullptr, info->GetReadObjectWiseActions()->fBlockSequence);
+   EXPECT_EQ(nullptr, info->GetWriteObjectWiseActions()->fBlockSequence);
+
+   TBufferFile wplain(TBuffer::kWrite);
+   WriteAttributes(wplain);
+   ASSERT_EQ(wblocks.Length(), wplain.Length());
+   EXPECT_EQ(0, memcmp(wblocks.Buffer(), wplain.Buffer(), wblocks.Length()));
+
+   TStreamerInfo::EnableBlockStreaming(kTRUE);
+   info->Compile();
+   EXPECT_NE(nullptr, info->GetReadObjectWiseActions()->fBlockSequence);
+}
@@ -0,0 +1,41 @@
+#include "TMemFile.h"
+#include "TNamed.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// The content views cover the file up to GetEND() and allow to read it again,
+// without copying, from a single contiguous buffer.
+TEST(TMemFile, ContentViews)
+{
+   // Large enough to need several blocks, not compressed.
+   TString title('x', 9 * 1024 * 1024);
+   TMemFile f("views.root", "RECREATE", "", 0);
+   TNamed obj("big", title.Data());
+   obj.Write();
+   f.Write();
+
+   std::vector<TMemFile::ZeroCopyView_t> views = f.GetContentViews();
+   // The blocks grow geometrically (2MB, 4MB, 8MB, ...).
+   EXPECT_EQ(3u, views.size());
+
+   std::vector<char> content;
+   for (const auto &view : views)
+      content.insert(content.end(), view.fStart, view.fStart + view.fSize);
+   ASSERT_EQ(f.GetEND(), (Long64_t)content.size());
+
+   std::vector<char> copy(f.GetSize());
+   f.CopyTo(copy.data(), copy.size());
+   EXPECT_TRUE(std::equal(content.begin(), content.end(), copy.begin()));
+
+   TMemFile readback("views.root", TMemFile::ZeroCopyView_t(content.data(), content.size()));
+   ASSERT_FALSE(readback.IsZombie());
+   EXPECT_FALSE(readback.IsWritable());
+   TNamed *read = nullptr;
+   readback.GetObject("big", read);
+   ASSERT_TRUE(read != nullptr);
+   EXPECT_EQ(title, read->GetTitle());
+   delete read;
+}
@@ -16,6 +16,9 @@
 #ifndef ROOT_ROOTCLINGIO_H_H
 #define ROOT_ROOTCLINGIO_H_H
 
+#include <string>
+#include <vector>
+
 extern "C" {
    void InitializeStreamerInfoROOTFile(const char *filename);
    void AddStreamerInfoToROOTFile(const char *normName);
@@ -23,6 +26,7 @@ extern "C" {
    void AddEnumToROOTFile(const char *tdname);
    void AddAncestorPCMROOTFile(const char *pcmName);
    bool CloseStreamerInfoROOTFile(bool writeEmptyRootPCM);
+   bool GetProtoClassNamesROOTFile(std::vector<std::string> &protoClassNames, bool &hasTypes);
 }
 
 #endif //ROOT_ROOTCLINGIO_H_H
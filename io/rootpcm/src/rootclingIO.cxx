@@ -16,6 +16,7 @@
 #include "TEnum.h"
 #include "TError.h"
 #include "TFile.h"
+#include "TObjString.h"
 #include "TProtoClass.h"
 #include "TROOT.h"
 #include "TStreamerInfo.h"
@@ -27,6 +28,9 @@ std::vector<std::string> gClassesToStore;
 std::vector<std::string> gTypedefsToStore;
 std::vector<std::string> gEnumsToStore;
 std::vector<std::string> gAncestorPCMNames;
+std::vector<std::string> gProtoClassNamesStored;
+bool gPCMHasTypes = false;
+bool gPCMWritten = false;
 
 extern "C"
 void InitializeStreamerInfoROOTFile(const char *filename)
@@ -149,6 +153,7 @@ bool CloseStreamerInfoROOTFile(bool writeEmptyRootPCM)
    if (writeEmptyRootPCM) {
       TObject obj;
       obj.Write("EMPTY");
+      gPCMWritten = true;
       return true;
    };
 
@@ -248,12 +253,39 @@ bool CloseStreamerInfoROOTFile(bool writeEmptyRootPCM)
       return false;
 // Instead of plugins:
    protoClasses.Write("__ProtoClasses", TObject::kSingleKey);
+   // Index of the proto classes, one name per line, allowing TCling to read
+   // __ProtoClasses only when one of these classes is used.
+   TObjString protoClassNames;
+   for (auto proto : protoClasses) {
+      protoClassNames.String() += proto->GetName();
+      protoClassNames.String() += '\n';
+   }
+   protoClassNames.Write("__ProtoClassNames");
+   for (auto proto : protoClasses)
+      gProtoClassNamesStored.emplace_back(proto->GetName());
    protoClasses.Delete();
    typedefs.Write("__Typedefs", TObject::kSingleKey);
    enums.Write("__Enums", TObject::kSingleKey);
+   gPCMHasTypes = !typedefs.IsEmpty() || !enums.IsEmpty();
 
    dictFile.WriteObjectAny(&gAncestorPCMNames, "std::vector<std::string>", "__AncestorPCMNames");
 
+   gPCMWritten = true;
+
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the names of the proto classes written in the ROOT PCM, and whether
+/// it also stores typedefs or enums, for the index in the rootmap file.
+/// Returns false if no ROOT PCM was written.
 
+extern "C"
+bool GetProtoClassNamesROOTFile(std::vector<std::string> &protoClassNames, bool &hasTypes)
+{
+   if (!gPCMWritten)
+      return false;
+   protoClassNames = gProtoClassNamesStored;
+   hasTypes = gPCMHasTypes;
    return true;
 }
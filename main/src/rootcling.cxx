@@ -42,6 +42,7 @@ int main(int argc, char **argv)
    config.fAddEnumToROOTFile = &AddEnumToROOTFile;
    config.fAddAncestorPCMROOTFile = &AddAncestorPCMROOTFile;
    config.fCloseStreamerInfoROOTFile = &CloseStreamerInfoROOTFile;
+   config.fGetProtoClassNamesROOTFile = &GetProtoClassNamesROOTFile;
 
    return ROOT_rootcling_Driver(argc, argv, config);
 }
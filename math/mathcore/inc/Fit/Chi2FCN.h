@@ -26,6 +26,7 @@
 #include "Fit/FitUtil.h"
 
 #include <memory>
+#include <chrono>
 
 /**
 @defgroup FitMethodFunc Fit Method Classes
@@ -145,10 +146,14 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
+      auto start = std::chrono::steady_clock::now();
+      double chi2 = 0;
       if (BaseFCN::Data().HaveCoordErrors() || BaseFCN::Data().HaveAsymErrors())
-         return FitUtil::Evaluate<T>::EvalChi2Effective(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
+         chi2 = FitUtil::Evaluate<T>::EvalChi2Effective(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
       else
-         return FitUtil::Evaluate<T>::EvalChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints, fExecutionPolicy);
+         chi2 = FitUtil::Evaluate<T>::EvalChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints, fExecutionPolicy);
+      this->UpdateEvalTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      return chi2;
    }
 
    // for derivatives
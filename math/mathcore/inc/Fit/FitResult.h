@@ -126,6 +126,13 @@ public:
    ///Expected distance from minimum
    double Edm() const { return fEdm; }
 
+   /// wall time (in seconds) spent in the minimization
+   double MinimizationTime() const { return fMinimTime; }
+
+   /// wall time (in seconds) spent in evaluating the objective function during the minimization
+   /// (available only when fitting with the ROOT::Fit fit method functions)
+   double FcnTime() const { return fFcnTime; }
+
    ///   get total number of parameters
    unsigned int NTotalParameters() const { return fParams.size(); }
    /// total number of parameters (abbreviation)
@@ -343,6 +350,8 @@ protected:
    double fVal;             // minimum function value
    double fEdm;             // expected distance from mimimum
    double fChi2;            // fit chi2 value (different than fval in case of chi2 fits)
+   double fMinimTime;       //! wall time spent in the minimization
+   double fFcnTime;         //! wall time spent in the objective function evaluations
    std::shared_ptr<ROOT::Math::Minimizer> fMinimizer; //! minimizer object used for fitting
    std::shared_ptr<ROOT::Math::IMultiGenFunction> fObjFunc; //! objective function used for fitting
    std::shared_ptr<IModelFunction> fFitFunc; //! model function resulting  from the fit. 
@@ -18,6 +18,8 @@
 
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
+#include <chrono>
+#include <memory>
 #endif
 
 // #include "ROOT/TProcessExecutor.hxx"
@@ -335,8 +337,70 @@ namespace FitUtil {
    */
    double EvaluatePoissonBinPdf(const IModelFunction & func, const BinData & data, const double * x, unsigned int ipoint, double * g = 0);
 
+   /**
+      return a default number of chunks for a multi-threaded evaluation over nEvents points,
+      used when no measurement of the evaluation cost is available
+   */
    unsigned setAutomaticChunking(unsigned nEvents);
 
+#ifdef R__USE_IMT
+   /**
+      Class managing the thread executor used in the multi-threaded evaluation of the fit method functions.
+      All the evaluations performed in the same thread while the outermost scope is alive use the executor
+      of that scope. The Fitter owns an executor for its whole lifetime and keeps a scope using it alive
+      during the minimization and the error calculation, so that the executor is not re-created at each
+      function call and nested fits use the executor of the enclosing one.
+      The scope also measures the time spent in each evaluation and uses the obtained per-point cost to tune
+      the number of chunks, when this is not given explicitly.
+   */
+   class ThreadExecutorScope {
+
+   public:
+
+      /// scope owning its executor, created at first use and deleted with the scope
+      ThreadExecutorScope();
+
+      /// scope using the executor held by the caller, created at first use if the holder is empty
+      explicit ThreadExecutorScope(std::shared_ptr<ROOT::TThreadExecutor> & executor);
+
+      ~ThreadExecutorScope();
+
+      ThreadExecutorScope(const ThreadExecutorScope &) = delete;
+      ThreadExecutorScope & operator=(const ThreadExecutorScope &) = delete;
+
+      /// return the executor (created at first use)
+      ROOT::TThreadExecutor & Executor();
+
+      /// return the number of chunks for evaluating nEvents points, using the measured evaluation cost
+      unsigned NChunks(unsigned nEvents) const;
+
+      /// update the measured evaluation cost from the wall time (in seconds) for evaluating nEvents points in nChunks
+      void UpdateCost(unsigned nEvents, unsigned nChunks, double time);
+
+      /// measured cost (wall time in seconds per point and per thread), 0 if not yet measured
+      double CostPerPoint() const;
+
+      /// map func on the points [0, nEvents) and reduce the result using redfunc.
+      /// If nChunks is zero the number of chunks is chosen automatically
+      template<class F, class R>
+      auto MapReduce(F func, unsigned nEvents, R redfunc, unsigned nChunks) -> typename std::result_of<F(unsigned)>::type
+      {
+         unsigned chunks = (nChunks != 0) ? nChunks : NChunks(nEvents);
+         auto start = std::chrono::steady_clock::now();
+         auto res = Executor().MapReduce(func, ROOT::TSeq<unsigned>(0, nEvents), redfunc, chunks);
+         UpdateCost(nEvents, chunks, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+         return res;
+      }
+
+   private:
+
+      ThreadExecutorScope * fOuter;                          // enclosing scope in the same thread (if any)
+      std::shared_ptr<ROOT::TThreadExecutor> fOwnExecutor;   // executor owned by the scope (if no holder is given)
+      std::shared_ptr<ROOT::TThreadExecutor> & fExecutor;    // holder of the executor used by the scope
+      double fCostPerPoint;                                  // measured cost per point and thread
+   };
+#endif
+
    template<class T>
    struct Evaluate {
 #ifdef R__HAS_VECCORE
@@ -427,9 +491,7 @@ namespace FitUtil {
 
 #ifdef R__USE_IMT
          } else if (executionPolicy == ROOT::Fit::kMultithread) {
-            auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(data.Size() / vecSize);
-            ROOT::TThreadExecutor pool;
-            res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, data.Size() / vecSize), redFunction, chunks);
+            res = ThreadExecutorScope().MapReduce(mapFunction, data.Size() / vecSize, redFunction, nChunks);
 #endif
             // } else if(executionPolicy == ROOT::Fit::kMultitProcess){
             //   ROOT::TProcessExecutor pool;
@@ -565,9 +627,7 @@ namespace FitUtil {
             }
 #ifdef R__USE_IMT
          } else if (executionPolicy == ROOT::Fit::kMultithread) {
-            auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(data.Size() / vecSize);
-            ROOT::TThreadExecutor pool;
-            auto resArray = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, data.Size() / vecSize), redFunction, chunks);
+            auto resArray = ThreadExecutorScope().MapReduce(mapFunction, data.Size() / vecSize, redFunction, nChunks);
             logl_v = resArray.logvalue;
             sumW_v = resArray.weight;
             sumW2_v = resArray.weight2;
@@ -757,9 +817,7 @@ namespace FitUtil {
             }
 #ifdef R__USE_IMT
          } else if (executionPolicy == ROOT::Fit::kMultithread) {
-            auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(data.Size() / vecSize);
-            ROOT::TThreadExecutor pool;
-            res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, data.Size() / vecSize), redFunction, chunks);
+            res = ThreadExecutorScope().MapReduce(mapFunction, data.Size() / vecSize, redFunction, nChunks);
 #endif
             // } else if(executionPolicy == ROOT::Fit::kMultitProcess){
             //   ROOT::TProcessExecutor pool;
@@ -32,6 +32,7 @@ Classes used for fitting (regression analysis) and estimation of parameter value
 
 namespace ROOT {
 
+   class TThreadExecutor;
 
    namespace Math {
       class Minimizer;
@@ -449,6 +450,8 @@ protected:
    void DoUpdateFitConfig();
    // get function calls from the FCN
    int GetNCallsFromFCN();
+   // get time spent in the function evaluations from the FCN
+   double GetEvalTimeFromFCN();
 
 
    //set data for the fit
@@ -505,6 +508,8 @@ private:
 
    std::shared_ptr<ROOT::Math::IMultiGenFunction>  fObjFunction;  //! pointer to used objective function
 
+   std::shared_ptr<ROOT::TThreadExecutor>  fExecutor;  //! thread executor of the multi-threaded evaluations (created at first use)
+
 };
 
 
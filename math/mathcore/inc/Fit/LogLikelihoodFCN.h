@@ -22,6 +22,7 @@
 #include "Fit/FitUtil.h"
 
 #include <memory>
+#include <chrono>
 
 namespace ROOT {
 
@@ -154,7 +155,10 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
-      return FitUtil::Evaluate<T>::EvalLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints, fExecutionPolicy);
+      auto start = std::chrono::steady_clock::now();
+      double logl = FitUtil::Evaluate<T>::EvalLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints, fExecutionPolicy);
+      this->UpdateEvalTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      return logl;
    }
 
    // for derivatives
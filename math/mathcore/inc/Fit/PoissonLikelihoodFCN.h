@@ -23,6 +23,7 @@
 
 
 #include <memory>
+#include <chrono>
 
 //#define PARALLEL
 // #ifdef PARALLEL
@@ -161,8 +162,11 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
-      return FitUtil::Evaluate<T>::EvalPoissonLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended,
-                                                   fNEffPoints, fExecutionPolicy);
+      auto start = std::chrono::steady_clock::now();
+      double logl = FitUtil::Evaluate<T>::EvalPoissonLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended,
+                                                          fNEffPoints, fExecutionPolicy);
+      this->UpdateEvalTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      return logl;
    }
 
    // for derivatives
@@ -15,6 +15,8 @@
 
 #include "Math/IFunction.h"
 
+#include <atomic>
+
 // #ifndef ROOT_Math_IParamFunctionfwd
 // #include "Math/IParamFunctionfwd.h"
 // #endif
@@ -47,9 +49,28 @@ public:
    BasicFitMethodFunction(int dim, int npoint) :
       fNDim(dim),
       fNPoints(npoint),
-      fNCalls(0)
+      fNCalls(0),
+      fEvalTime(0)
+   {}
+
+   BasicFitMethodFunction(const BasicFitMethodFunction &rhs) :
+      FunctionType(rhs),
+      fNDim(rhs.fNDim),
+      fNPoints(rhs.fNPoints),
+      fNCalls(rhs.fNCalls),
+      fEvalTime(rhs.fEvalTime.load())
    {}
 
+   BasicFitMethodFunction &operator=(const BasicFitMethodFunction &rhs) {
+      if (this == &rhs) return *this;
+      FunctionType::operator=(rhs);
+      fNDim = rhs.fNDim;
+      fNPoints = rhs.fNPoints;
+      fNCalls = rhs.fNCalls;
+      fEvalTime = rhs.fEvalTime.load();
+      return *this;
+   }
+
    /**
       Virtual Destructor (no operations)
    */
@@ -94,6 +115,25 @@ public:
     */
    virtual void ResetNCalls() { fNCalls = 0; }
 
+   /**
+      return the total wall time (in seconds) spent in the function evaluations
+    */
+   virtual double EvalTime() const { return fEvalTime; }
+
+   /**
+      add the wall time (in seconds) spent in a function evaluation
+      (thread safe, evaluations may run concurrently in the pool threads)
+    */
+   virtual void UpdateEvalTime(double time) const {
+      double old = fEvalTime.load(std::memory_order_relaxed);
+      while (!fEvalTime.compare_exchange_weak(old, old + time, std::memory_order_relaxed)) {}
+   }
+
+   /**
+      reset the time spent in the function evaluations
+    */
+   virtual void ResetEvalTime() { fEvalTime = 0; }
+
 
 
 public:
@@ -107,6 +147,7 @@ private:
    unsigned int fNDim;      // function dimension
    unsigned int fNPoints;   // size of the data
    mutable unsigned int fNCalls; // number of function calls
+   mutable std::atomic<double> fEvalTime; //! total time spent in the function evaluations
 
 
 };
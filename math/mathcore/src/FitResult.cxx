@@ -44,7 +44,7 @@ const int gInitialResultStatus = -99; // use this special convention to flag it
 
 FitResult::FitResult() :
    fValid(false), fNormalized(false), fNFree(0), fNdf(0), fNCalls(0),
-   fStatus(-1), fCovStatus(0), fVal(0), fEdm(-1), fChi2(-1)
+   fStatus(-1), fCovStatus(0), fVal(0), fEdm(-1), fChi2(-1), fMinimTime(0), fFcnTime(0)
 {
    // Default constructor implementation.
 }
@@ -60,6 +60,8 @@ FitResult::FitResult(const FitConfig & fconfig) :
    fVal(0),
    fEdm(-1),
    fChi2(-1),
+   fMinimTime(0),
+   fFcnTime(0),
    fFitFunc(0),
    fParams(std::vector<double>( fconfig.NPar() ) ),
    fErrors(std::vector<double>( fconfig.NPar() ) ),
@@ -268,6 +270,8 @@ FitResult & FitResult::operator = (const FitResult &rhs) {
    fVal = rhs.fVal;
    fEdm = rhs.fEdm;
    fChi2 = rhs.fChi2;
+   fMinimTime = rhs.fMinimTime;
+   fFcnTime = rhs.fFcnTime;
    fMinimizer = rhs.fMinimizer;
    fObjFunc = rhs.fObjFunc;
    fFitFunc = rhs.fFitFunc; 
@@ -26,6 +26,10 @@
 #include "Math/Error.h"
 #include "Math/Util.h"  // for safe log(x)
 
+#ifdef R__USE_IMT
+#include "ThreadLocalStorage.h"
+#endif
+
 #include <limits>
 #include <cmath>
 #include <cassert>
@@ -364,9 +368,7 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
     }
 #ifdef R__USE_IMT
   } else if(executionPolicy == ROOT::Fit::kMultithread) {
-    auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    ROOT::TThreadExecutor pool;
-    res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    res = ThreadExecutorScope().MapReduce(mapFunction, n, redFunction, nChunks);
 #endif
 //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
     // ROOT::TProcessExecutor pool;
@@ -911,9 +913,7 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double>  & func, const Un
     }
 #ifdef R__USE_IMT
   } else if(executionPolicy == ROOT::Fit::kMultithread) {
-    auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    ROOT::TThreadExecutor pool;
-    auto resArray = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    auto resArray = ThreadExecutorScope().MapReduce(mapFunction, n, redFunction, nChunks);
     logl=resArray.logvalue;
     sumW=resArray.weight;
     sumW2=resArray.weight2;
@@ -1319,9 +1319,7 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
       }
 #ifdef R__USE_IMT
    } else if (executionPolicy == ROOT::Fit::kMultithread) {
-      auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(data.Size());
-      ROOT::TThreadExecutor pool;
-      res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+      res = ThreadExecutorScope().MapReduce(mapFunction, n, redFunction, nChunks);
 #endif
       //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
       // ROOT::TProcessExecutor pool;
@@ -1422,12 +1420,98 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinDat
 }
 
 unsigned FitUtil::setAutomaticChunking(unsigned nEvents){
-      SysInfo_t s;
-      gSystem->GetSysInfo(&s);
-      auto ncpu  = s.fCpus;
-      return ((nEvents/ncpu + 1) % 1000) *40 ; //arbitrary formula
+   // use a few chunks per core to balance the load between the threads
+   SysInfo_t s;
+   gSystem->GetSysInfo(&s);
+   unsigned ncpu = (s.fCpus > 0) ? s.fCpus : 1;
+   return std::max(1u, std::min(nEvents, 4 * ncpu));
+}
+
+#ifdef R__USE_IMT
+
+namespace {
+
+   // innermost executor scope active in the current thread
+   FitUtil::ThreadExecutorScope *&GetCurrentExecutorScope() {
+      TTHREAD_TLS(FitUtil::ThreadExecutorScope *) gScope = nullptr;
+      return gScope;
+   }
+
+   // target wall time for evaluating a single chunk: long enough to make the scheduling overhead
+   // negligible, short enough to balance the load between the threads
+   const double kChunkTime = 5.E-5;
+
+   // maximum number of chunks per thread
+   const unsigned kMaxChunksPerThread = 8;
+
+   unsigned GetExecutorPoolSize() {
+      unsigned n = ROOT::Internal::TPoolManager::GetPoolSize();
+      return (n > 0) ? n : 1;
+   }
+
+}
+
+FitUtil::ThreadExecutorScope::ThreadExecutorScope() :
+   fOuter(GetCurrentExecutorScope()),
+   fExecutor(fOwnExecutor),
+   fCostPerPoint(0)
+{
+   GetCurrentExecutorScope() = this;
 }
 
+FitUtil::ThreadExecutorScope::ThreadExecutorScope(std::shared_ptr<ROOT::TThreadExecutor> & executor) :
+   fOuter(GetCurrentExecutorScope()),
+   fExecutor(executor),
+   fCostPerPoint(0)
+{
+   GetCurrentExecutorScope() = this;
+}
+
+FitUtil::ThreadExecutorScope::~ThreadExecutorScope()
+{
+   GetCurrentExecutorScope() = fOuter;
+}
+
+ROOT::TThreadExecutor & FitUtil::ThreadExecutorScope::Executor()
+{
+   // return the executor of the outermost scope, creating it in its holder if needed
+   if (fOuter) return fOuter->Executor();
+   if (!fExecutor) fExecutor = std::make_shared<ROOT::TThreadExecutor>();
+   return *fExecutor;
+}
+
+unsigned FitUtil::ThreadExecutorScope::NChunks(unsigned nEvents) const
+{
+   // compute number of chunks from the total work (measured cost times the number of points)
+   // split in chunks of kChunkTime, bounded by the number of points and the number of threads
+   if (fOuter) return fOuter->NChunks(nEvents);
+   if (fCostPerPoint <= 0) return setAutomaticChunking(nEvents);
+   double nchunks = nEvents * fCostPerPoint / kChunkTime;
+   unsigned maxChunks = std::min(nEvents, kMaxChunksPerThread * GetExecutorPoolSize());
+   if (nchunks >= maxChunks) return std::max(1u, maxChunks);
+   return std::max(1u, static_cast<unsigned>(nchunks));
+}
+
+void FitUtil::ThreadExecutorScope::UpdateCost(unsigned nEvents, unsigned nChunks, double time)
+{
+   // update the measured cost per point as running average of the latest evaluations
+   if (fOuter) {
+      fOuter->UpdateCost(nEvents, nChunks, time);
+      return;
+   }
+   if (nEvents == 0 || nChunks == 0) return;
+   unsigned nthreads = std::min(nChunks, GetExecutorPoolSize());
+   double cost = time * nthreads / nEvents;
+   fCostPerPoint = (fCostPerPoint > 0) ? 0.5 * (fCostPerPoint + cost) : cost;
+}
+
+double FitUtil::ThreadExecutorScope::CostPerPoint() const
+{
+   return (fOuter) ? fOuter->CostPerPoint() : fCostPerPoint;
+}
+
+#endif
+
 }
 
 } // end namespace ROOT
@@ -28,6 +28,7 @@
 #include "TF1.h"
 
 #include <memory>
+#include <chrono>
 
 #include "Math/IParamFunction.h"
 
@@ -607,6 +608,10 @@ bool Fitter::CalculateHessErrors() {
    }
 
    //run Hesse
+#ifdef R__USE_IMT
+   // re-use the executor of the fitter for all the function evaluations
+   FitUtil::ThreadExecutorScope executorScope(fExecutor);
+#endif
    bool ret = fMinimizer->Hesse();
    if (!ret) MATH_WARN_MSG("Fitter::CalculateHessErrors","Error when calculating Hessian");
 
@@ -659,6 +664,11 @@ bool Fitter::CalculateMinosErrors() {
    fConfig.SetMinosErrors(false);
 
 
+#ifdef R__USE_IMT
+   // re-use the executor of the fitter for all the function evaluations
+   FitUtil::ThreadExecutorScope executorScope(fExecutor);
+#endif
+
    const std::vector<unsigned int> & ipars = fConfig.MinosParams();
    unsigned int n = (ipars.size() > 0) ? ipars.size() : fResult->Parameters().size();
    bool ok = false;
@@ -745,8 +755,20 @@ bool Fitter::DoMinimization(const ROOT::Math::IMultiGenFunction * chi2func) {
 
    assert(fMinimizer );
 
+#ifdef R__USE_IMT
+   // use the executor owned by the fitter for the whole minimization, so that it is created only once
+   // and the chunking of the multi-threaded evaluations is tuned across the function calls
+   FitUtil::ThreadExecutorScope executorScope(fExecutor);
+#endif
+
+   double fcnTime = GetEvalTimeFromFCN();
+   auto start = std::chrono::steady_clock::now();
+
    bool ret = fMinimizer->Minimize();
 
+   double minimTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   fcnTime = GetEvalTimeFromFCN() - fcnTime;
+
    // unsigned int ncalls =  ObjFuncTrait<ObjFunc>::NCalls(*fcn);
    // int fitType =  ObjFuncTrait<ObjFunc>::Type(objFunc);
 
@@ -758,6 +780,10 @@ bool Fitter::DoMinimization(const ROOT::Math::IMultiGenFunction * chi2func) {
       fResult->fNCalls = GetNCallsFromFCN();
    }
 
+   // set the time spent in the minimization and in the objective function evaluations
+   fResult->fMinimTime = minimTime;
+   fResult->fFcnTime = fcnTime;
+
    // fill information in fit result
    fResult->fObjFunc = fObjFunction;
    fResult->fFitData = fData;
@@ -812,6 +838,21 @@ int Fitter::GetNCallsFromFCN() {
    return ncalls;
 }
 
+double Fitter::GetEvalTimeFromFCN() {
+   // retrieve the time spent in the function evaluations from the fit method functions
+   // (return zero for a generic objective function)
+   double time = 0;
+   if (!fUseGradient) {
+      const ROOT::Math::FitMethodFunction * fcn = dynamic_cast<const ROOT::Math::FitMethodFunction *>(fObjFunction.get());
+      if (fcn) time = fcn->EvalTime();
+   }
+   else {
+      const ROOT::Math::FitMethodGradFunction * fcn = dynamic_cast<const ROOT::Math::FitMethodGradFunction*>(fObjFunction.get());
+      if (fcn) time = fcn->EvalTime();
+   }
+   return time;
+}
+
 
 bool Fitter::ApplyWeightCorrection(const ROOT::Math::IMultiGenFunction & loglw2, bool minimizeW2L) {
    // apply correction for weight square
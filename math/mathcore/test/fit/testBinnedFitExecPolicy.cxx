@@ -57,6 +57,12 @@ int main()
    } else {
       compareResult(r2->MinFcnValue(), r1->MinFcnValue(), "Mutithreaded Chi2 Fit: ");
    }
+   // time spent in the objective function must be recorded and be part of the minimization time
+   if (r2->FcnTime() <= 0 || r2->FcnTime() > r2->MinimizationTime()) {
+      Error("testBinnedFitExecPolicy", "Wrong timing of the Multithreaded Chi2 Fit: fcn time %f, minimization time %f",
+            r2->FcnTime(), r2->MinimizationTime());
+      return -1;
+   }
 
    std::cout << "\n **FIT: Multithreaded Binned Likelihood **\n\n";
    f->SetParameters(1, 1000, 7.5, 1.5);
@@ -113,6 +113,15 @@ public:
    */
    virtual void SetErrorDef(double ) {};
 
+   /**
+      Return true if the function can be evaluated concurrently from different threads.
+      In that case, when ROOT implicit multi-threading is enabled, Minuit2 computes the numerical
+      derivatives (gradient and Hessian) of the different parameters in parallel.
+      The result of operator() must depend only on the given parameter values.
+      Re-implement this function if the FCN satisfies this contract.
+   */
+   virtual bool IsThreadSafe() const { return false; }
+
 };
 
   }  // namespace Minuit2
@@ -14,6 +14,7 @@
 #include "Minuit2/MnMatrix.h"
 
 #include <vector>
+#include <atomic>
 
 namespace ROOT {
 
@@ -56,7 +57,7 @@ private:
 
 protected:
 
-  mutable int fNumCall;
+  mutable std::atomic<int> fNumCall;  // atomic since the function can be called from different threads
 };
 
   }  // namespace Minuit2
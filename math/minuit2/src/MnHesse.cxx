@@ -30,6 +30,13 @@
 
 #include "Minuit2/MPIProcess.h"
 
+#ifdef USE_ROOT_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#include <algorithm>
+#include <vector>
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -130,9 +137,12 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
 #endif
 
 
-   for(unsigned int i = 0; i < n; i++) {
+   // compute the second derivative for the i-th parameter, using xv as work vector (restored at the end).
+   // Only the i-th components of g2, grd, gst, dirin and yy are modified.
+   // Return false if the second derivative is zero
+   auto diagonal = [&](unsigned int i, MnAlgebraicVector & xv) {
 
-      double xtf = x(i);
+      double xtf = xv(i);
       double dmin = 8.*prec.Eps2()*(fabs(xtf) + prec.Eps2());
       double d = fabs(gst(i));
       if(d < dmin) d = dmin;
@@ -147,11 +157,11 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
          double fs1 = 0.;
          double fs2 = 0.;
          for(unsigned int multpy = 0; multpy < 5; multpy++) {
-            x(i) = xtf + d;
-            fs1 = mfcn(x);
-            x(i) = xtf - d;
-            fs2 = mfcn(x);
-            x(i) = xtf;
+            xv(i) = xtf + d;
+            fs1 = mfcn(xv);
+            xv(i) = xtf - d;
+            fs2 = mfcn(xv);
+            xv(i) = xtf;
             sag = 0.5*(fs1+fs2-2.*amin);
 
 #ifdef DEBUG
@@ -179,13 +189,7 @@ L26:
             MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
          }
 #endif
-
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+         return false;
 
 L30:
             double g2bfor = g2(i);
@@ -211,23 +215,58 @@ L30:
          d = std::min(d, 10.*dlast);
          d = std::max(d, 0.1*dlast);
       }
-      vhmat(i,i) = g2(i);
-      if(mfcn.NumOfCalls()  > maxcalls) {
+      return true;
+   };
 
-#ifdef WARNINGMSG
-         //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
-         MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
-         MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+   // state with the diagonal matrix from the second derivatives, returned in case of failure
+   auto failedState = [&]() {
+      for(unsigned int j = 0; j < n; j++) {
+         double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
+         vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
+      }
+      return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+   };
+
+#ifdef USE_ROOT_IMT
+   // with a thread-safe FCN and implicit multi-threading enabled, compute the second derivatives
+   // and the off-diagonal elements in parallel using the ROOT thread pool.
+   // Each task uses its own copy of the parameter vector and sets only its own elements,
+   // therefore the result does not depend on the number of threads
+   bool useThreads = (n > 1 && mfcn.Fcn().IsThreadSafe() && ROOT::IsImplicitMTEnabled());
+
+   if (useThreads) {
+      // the maximum number of calls is checked after having computed all the diagonal elements
+      std::vector<char> ok(n);
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int i) {
+         MnAlgebraicVector xv = x;
+         ok[i] = diagonal(i, xv);
+      }, ROOT::TSeq<unsigned int>(0, n));
+
+      if (std::find(ok.begin(), ok.end(), 0) != ok.end()) return failedState();
+      for(unsigned int i = 0; i < n; i++) vhmat(i,i) = g2(i);
+   }
+   else
 #endif
+   {
+      for(unsigned int i = 0; i < n; i++) {
 
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
+         if (!diagonal(i, x)) return failedState();
 
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+         vhmat(i,i) = g2(i);
+         if(mfcn.NumOfCalls()  > maxcalls) break;
       }
+   }
+
+   if(mfcn.NumOfCalls()  > maxcalls) {
+
+#ifdef WARNINGMSG
+      //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
+      MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
+      MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+#endif
 
+      return failedState();
    }
 
 #ifdef DEBUG
@@ -244,39 +283,63 @@ L30:
    }
 
    //off-diagonal Elements
-   // initial starting values
-   MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
-   unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
-   unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
+#ifdef USE_ROOT_IMT
+   if (useThreads) {
+      // compute each element (i,j), i < j, in a separate task
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int in) {
+         // find the row i and column j of the in-th element of the upper triangle
+         unsigned int i = 0;
+         unsigned int first = 0;
+         while (in >= first + (n-1-i)) {
+            first += n-1-i;
+            ++i;
+         }
+         unsigned int j = i + 1 + (in - first);
+         MnAlgebraicVector xv = x;
+         xv(i) += dirin(i);
+         xv(j) += dirin(j);
+         double fs1 = mfcn(xv);
+         vhmat(i,j) = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+      }, ROOT::TSeq<unsigned int>(0, n*(n-1)/2));
+   }
+   else
+#endif
+   {
+      // initial starting values
+      MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
+      unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
+      unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
 
-   unsigned int offsetVect = 0;
-   for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
-      if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
+      unsigned int offsetVect = 0;
+      for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
+         if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
 
-   for (unsigned int in = startParIndexOffDiagonal;
-        in<endParIndexOffDiagonal; in++) {
+      for (unsigned int in = startParIndexOffDiagonal;
+           in<endParIndexOffDiagonal; in++) {
 
-      int i = (in+offsetVect)/(n-1);
-      if ((in+offsetVect)%(n-1)==0) offsetVect += i;
-      int j = (in+offsetVect)%(n-1)+1;
+         int i = (in+offsetVect)/(n-1);
+         if ((in+offsetVect)%(n-1)==0) offsetVect += i;
+         int j = (in+offsetVect)%(n-1)+1;
 
-      if ((i+1)==j || in==startParIndexOffDiagonal)
-         x(i) += dirin(i);
+         if ((i+1)==j || in==startParIndexOffDiagonal)
+            x(i) += dirin(i);
 
-      x(j) += dirin(j);
+         x(j) += dirin(j);
 
-      double fs1 = mfcn(x);
-      double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
-      vhmat(i,j) = elem;
+         double fs1 = mfcn(x);
+         double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+         vhmat(i,j) = elem;
 
-      x(j) -= dirin(j);
+         x(j) -= dirin(j);
 
-      if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
-         x(i) -= dirin(i);
+         if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
+            x(i) -= dirin(i);
 
-   }
+      }
 
-   mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
+      mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
+   }
 
    //verify if matrix pos-def (still 2nd derivative)
 
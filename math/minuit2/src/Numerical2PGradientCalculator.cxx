@@ -33,6 +33,12 @@
 
 #include "Minuit2/MPIProcess.h"
 
+#ifdef USE_ROOT_IMT
+#include "Minuit2/FCNBase.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -111,36 +117,9 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    std::cout.precision(pr);
 #endif
 
-#ifndef _OPENMP
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
- // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-//#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for(int i = 0; i < int(n); i++) {
-
-#endif
-
-#ifdef DEBUG_MP
-      int ith = omp_get_thread_num();
-      //std::cout << "Thread number " << ith << "  " << i << std::endl;
-#endif
-
-#ifdef _OPENMP
-       // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
+   // compute the derivative for the i-th parameter, using x as work vector (x is restored at the end)
+   // Only the i-th components of grd, g2 and gstep are modified
+   auto derivative = [&](unsigned int i, MnAlgebraicVector & x) {
 
       double xtf = x(i);
       double epspri = eps2 + fabs(grd(i)*eps2);
@@ -183,10 +162,10 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
          g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
 
 #ifdef DEBUG
-         pr = std::cout.precision(13);
+         int prc = std::cout.precision(13);
          std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
                    << " grd " << grd(i) << " g2 " << g2(i) << std::endl;
-         std::cout.precision(pr);
+         std::cout.precision(prc);
 #endif
 
          if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
@@ -198,6 +177,62 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
          }
       }
 
+#ifdef DEBUG
+      int prc = std::cout.precision(13);
+      int iext = Trafo().ExtOfInt(i);
+      std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
+      std::cout.precision(prc);
+#endif
+   };
+
+#ifdef USE_ROOT_IMT
+   // with a thread-safe FCN and implicit multi-threading enabled, compute the derivatives of the
+   // parameters in parallel using the ROOT thread pool. Each task works on its own copy of the
+   // parameter vector and sets only its own components, therefore the result does not depend
+   // on the number of threads
+   if (n > 1 && Fcn().Fcn().IsThreadSafe() && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int i) {
+         MnAlgebraicVector x = par.Vec();
+         derivative(i, x);
+      }, ROOT::TSeq<unsigned int>(0, n));
+
+      return FunctionGradient(grd, g2, gstep);
+   }
+#endif
+
+#ifndef _OPENMP
+   // for serial execution this can be outside the loop
+   MnAlgebraicVector x = par.Vec();
+
+   unsigned int startElementIndex = mpiproc.StartElementIndex();
+   unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
+
+#else
+
+ // parallelize this loop using OpenMP
+//#define N_PARALLEL_PAR 5
+#pragma omp parallel
+#pragma omp for
+//#pragma omp for schedule (static, N_PARALLEL_PAR)
+
+   for(int i = 0; i < int(n); i++) {
+
+#endif
+
+#ifdef DEBUG_MP
+      int ith = omp_get_thread_num();
+      //std::cout << "Thread number " << ith << "  " << i << std::endl;
+#endif
+
+#ifdef _OPENMP
+       // create in loop since each thread will use its own copy
+      MnAlgebraicVector x = par.Vec();
+#endif
+
+      derivative(i, x);
 
 #ifdef DEBUG_MP
 #pragma omp critical
@@ -209,14 +244,6 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
       //     vgrd(i) = grd;
       //     vgrd2(i) = g2;
       //     vgstp(i) = gstep;
-
-
-#ifdef DEBUG
-      pr = std::cout.precision(13);
-      int iext = Trafo().ExtOfInt(i);
-      std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
-      std::cout.precision(pr);
-#endif
    }
 
 #ifndef _OPENMP
@@ -20,6 +20,10 @@
 #include <cmath>
 #include <iostream>
 
+#ifdef USE_ROOT_IMT
+#include "TROOT.h"
+#endif
+
 // example of a multi dimensional fit where parallelization can be used
 // to speed up the result
 // define the environment variable OMP_NUM_THREADS to the number of desired threads
@@ -27,6 +31,8 @@
 // The default number of dimension is 20 (fit in 40 parameters) on 1000 data events.
 // One can change the dimension and the number of events by doing:
 // ./test_Minuit2_Parallel    ndim  nevents
+// When ROOT is built with implicit multi-threading, the derivatives are computed in parallel
+// using the ROOT thread pool, since the FCN is declared thread safe
 
 using namespace ROOT::Minuit2;
 
@@ -67,6 +73,8 @@ struct LogLikeFCN  : public FCNBase {
       return logl;
    }
    double Up() const { return 0.5; }
+   // operator() depends only on the parameters and can be called concurrently
+   bool IsThreadSafe() const { return true; }
    const Data & fData;
 };
 
@@ -153,6 +161,9 @@ int main(int argc, char **argv) {
    if (argc > 2) {
       ndata = atoi(argv[2] );
    }
+#ifdef USE_ROOT_IMT
+   ROOT::EnableImplicitMT();
+#endif
    std::cout << "do fit of " << ndim << " dimensional data on " << ndata << " events " << std::endl;
    doFit(ndim,ndata);
 }
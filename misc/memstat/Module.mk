@@ -21,11 +21,13 @@ MEMSTATDH     := $(MEMSTATDS:.cxx=.h)
 MEMSTATH      := $(MODDIRI)/TMemStatHelpers.h \
                  $(MODDIRI)/TMemStat.h $(MODDIRI)/TMemStatBacktrace.h \
                  $(MODDIRI)/TMemStatDef.h \
-		 $(MODDIRI)/TMemStatMng.h $(MODDIRI)/TMemStatHook.h
+		 $(MODDIRI)/TMemStatMng.h $(MODDIRI)/TMemStatHook.h \
+		 $(MODDIRI)/TMemStatSampler.h
 
 MEMSTATS      := $(MODDIRS)/TMemStat.cxx $(MODDIRS)/TMemStatMng.cxx \
 		 $(MODDIRS)/TMemStatBacktrace.cxx \
-		 $(MODDIRS)/TMemStatHelpers.cxx $(MODDIRS)/TMemStatHook.cxx
+		 $(MODDIRS)/TMemStatHelpers.cxx $(MODDIRS)/TMemStatHook.cxx \
+		 $(MODDIRS)/TMemStatSampler.cxx
 MEMSTATO      := $(call stripsrc,$(MEMSTATS:.cxx=.o))
 
 MEMSTATDEP    := $(MEMSTATO:.o=.d) $(MEMSTATDO:.o=.d)
@@ -16,6 +16,7 @@
 class TMemStat: public TObject {
 private:
    Bool_t fIsActive;    // is object attached to MemStat
+   Bool_t fIsSampling;  // allocations are sampled (TMemStatSampler) instead of all recorded
 
 public:
    TMemStat(Option_t* option = "read", Int_t buffersize=10000, Int_t maxcalls=5000000);
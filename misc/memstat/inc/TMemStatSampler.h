@@ -0,0 +1,36 @@
+// @(#)root/memstat:$Id$
+
+/*************************************************************************
+* Copyright (C) 1995-2010, Rene Brun and Fons Rademakers.               *
+* All rights reserved.                                                  *
+*                                                                       *
+* For the licensing terms see $ROOTSYS/LICENSE.                         *
+* For the list of contributors see $ROOTSYS/README/CREDITS.             *
+*************************************************************************/
+#ifndef ROOT_TMemStatSampler
+#define ROOT_TMemStatSampler
+
+// ROOT
+#include "Rtypes.h"
+
+namespace Memstat {
+
+   class TMemStatSampler {
+   private:
+      TMemStatSampler();   // not implemented, only static interface
+
+   public:
+      static void     Enable();                        //install the sampling hooks
+      static void     Disable();                       //remove the hooks, keep the collected samples
+      static void     Close(const char *filename = 0); //disable and write the report
+      static Long64_t GetInterval();
+      static Bool_t   IsActive();                      //a sampling session is open
+      static void     SetInterval(Long64_t interval);
+      static void     SetUseGNUBuiltinBacktrace(Bool_t newVal);
+
+      static const Long64_t kDefaultInterval = 512 * 1024;   // mean number of bytes between two samples
+   };
+
+}
+
+#endif
@@ -78,6 +78,17 @@
 // You can restrict the address range to be analyzed via TMemStatShow::SetAddressRange
 // You can restrict the entry range to be analyzed via TMemStatShow::SetEntryRange
 //
+// To profile long jobs at a low cost, use the option "sampling": instead
+// of recording every call, the allocations are sampled on average once every
+// 512 kbytes (or the value given as "sampling=<bytes>") and the sampled call
+// stacks are aggregated by class and call stack in memory, see TMemStatSampler.
+// The report, written to memstat_sampled_ProcessID.root when TMemStat is
+// closed, contains the estimated number of allocations and bytes per call
+// stack and per class. Frees are not recorded in this mode.
+//    TMemStat mm("gnubuiltin sampling");
+// The sampling interval can also be set in $ROOTSYS/etc/system.rootrc
+//    Root.TMemStat.sampling    524288
+//
 //___________________________________________________________________________
 
 #include "TROOT.h"
@@ -86,6 +97,7 @@
 #include "TMemStatBacktrace.h"
 #include "TMemStatMng.h"
 #include "TMemStatHelpers.h"
+#include "TMemStatSampler.h"
 
 #if defined(__GNUC__) && !defined(__clang__)
 #if __GNUC__ > 5
@@ -104,10 +116,13 @@ _INIT_TOP_STACK;
 /// Supported options:
 ///    "gnubuiltin" - if declared, then MemStat will use gcc build-in function,
 ///                      otherwise glibc backtrace will be used
+///    "sampling[=<bytes>]" - sample the allocations, on average one every
+///                      <bytes> bytes (default 512 kbytes), see TMemStatSampler.
+///                      buffersize and maxcalls are then ignored.
 ///
 /// Note: Currently MemStat uses a hard-coded output file name (for writing) = "memstat.root";
 
-TMemStat::TMemStat(Option_t* option, Int_t buffersize, Int_t maxcalls): fIsActive(kFALSE)
+TMemStat::TMemStat(Option_t* option, Int_t buffersize, Int_t maxcalls): fIsActive(kFALSE), fIsSampling(kFALSE)
 {
    // It marks the highest used stack address.
    _GET_CALLER_FRAME_ADDR;
@@ -116,6 +131,7 @@ TMemStat::TMemStat(Option_t* option, Int_t buffersize, Int_t maxcalls): fIsActiv
    TDirectory::TContext context;
 
    Bool_t useBuiltin = kTRUE;
+   Long64_t interval = 0;
    // Define string in a scope, so that the deletion of it will be not recorded by YAMS
    {
       string opt(option);
@@ -123,6 +139,21 @@ TMemStat::TMemStat(Option_t* option, Int_t buffersize, Int_t maxcalls): fIsActiv
                 Memstat::ToLower_t());
 
       useBuiltin = (opt.find("gnubuiltin") != string::npos) ? kTRUE : kFALSE;
+      string::size_type pos = opt.find("sampling");
+      if (pos != string::npos) {
+         fIsSampling = kTRUE;
+         pos += 8;
+         if (pos < opt.size() && opt[pos] == '=')
+            interval = atoll(opt.c_str() + pos + 1);
+      }
+   }
+
+   if (fIsSampling) {
+      TMemStatSampler::SetUseGNUBuiltinBacktrace(useBuiltin);
+      TMemStatSampler::SetInterval(interval);
+      TMemStatSampler::Enable();
+      fIsActive = kTRUE;
+      return;
    }
 
    TMemStatMng::GetInstance()->SetUseGNUBuiltinBacktrace(useBuiltin);
@@ -140,6 +171,10 @@ TMemStat::TMemStat(Option_t* option, Int_t buffersize, Int_t maxcalls): fIsActiv
 TMemStat::~TMemStat()
 {
    if (fIsActive) {
+      if (fIsSampling) {
+         TMemStatSampler::Close();
+         return;
+      }
       TMemStatMng::GetInstance()->Disable();
       TMemStatMng::GetInstance()->Close();
    }
@@ -150,7 +185,10 @@ TMemStat::~TMemStat()
 
 void TMemStat::Close()
 {
-   TMemStatMng::Close();
+   if (TMemStatSampler::IsActive())
+      TMemStatSampler::Close();
+   else
+      TMemStatMng::Close();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -158,7 +196,10 @@ void TMemStat::Close()
 
 void TMemStat::Disable()
 {
-   TMemStatMng::GetInstance()->Disable();
+   if (fIsSampling)
+      TMemStatSampler::Disable();
+   else
+      TMemStatMng::GetInstance()->Disable();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -166,7 +207,10 @@ void TMemStat::Disable()
 
 void TMemStat::Enable()
 {
-   TMemStatMng::GetInstance()->Enable();
+   if (fIsSampling)
+      TMemStatSampler::Enable();
+   else
+      TMemStatMng::GetInstance()->Enable();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
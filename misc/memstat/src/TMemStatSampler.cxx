@@ -0,0 +1,494 @@
+// @(#)root/memstat:$Id$
+
+/*************************************************************************
+* Copyright (C) 1995-2010, Rene Brun and Fons Rademakers.               *
+* All rights reserved.                                                  *
+*                                                                       *
+* For the licensing terms see $ROOTSYS/LICENSE.                         *
+* For the list of contributors see $ROOTSYS/README/CREDITS.             *
+*************************************************************************/
+
+//___________________________________________________________________________
+// TMemStatSampler is a low overhead alternative to the full recording of
+// TMemStatMng: instead of tracing every call to malloc and free, it samples
+// the allocations, on average one every GetInterval() bytes (512 kB by
+// default). The distance in bytes between two samples is drawn from an
+// exponential distribution, so that the probability to sample an allocation
+// of s bytes is 1-exp(-s/interval), independently of how the allocations
+// are split. Each sample is weighted by the inverse of this probability to
+// obtain unbiased estimates of the number of allocations and of the bytes
+// allocated. Allocations that are not sampled only cost a decrement of a
+// thread local counter, so the sampler can be left on for production jobs.
+//
+// Each thread records its samples (size, call stack and the class being
+// created by TClass::New, see TClass::GetClassInNew) in its own buffer
+// without any locking; full buffers are aggregated by class and call stack
+// under a mutex, as well as the buffer of a thread when it exits, which is
+// then reused by the next thread. Close() writes the report to memstat_sampled_<pid>.root:
+//   - "stacks", a TTree with one entry per class and call stack with the
+//     number of samples and the estimated number of allocations and bytes,
+//     sorted by decreasing number of bytes;
+//   - "bytesbyclass" and "allocsbyclass", histograms with one labeled bin
+//     per class;
+//   - "interval", the sampling interval used.
+//
+// Frees are not tracked: the report is an allocation profile (who allocates
+// how much), not a leak report.
+//
+// The sampler is activated with the "sampling" option of TMemStat, e.g.
+//     TMemStat mm("gnubuiltin sampling=1048576");
+// or via $ROOTSYS/etc/system.rootrc
+//     Root.TMemStat:            1
+//     Root.TMemStat.sampling:   524288
+//___________________________________________________________________________
+
+// STD
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+// ROOT
+#include "RConfig.h"
+#include "TClass.h"
+#include "TDirectory.h"
+#include "TError.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TParameter.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "ThreadLocalStorage.h"
+// Memstat
+#include "TMemStatBacktrace.h"
+#include "TMemStatHook.h"
+#include "TMemStatSampler.h"
+
+#if defined(R__GNU) && (defined(R__LINUX) || defined(__APPLE__))
+#define SUPPORTS_MEMSTAT
+#endif
+
+#if defined(SUPPORTS_MEMSTAT) && !defined(__APPLE__)
+// The glibc allocator entry points, which do not go through the hooks.
+extern "C" {
+   void *__libc_malloc(size_t size);
+   void __libc_free(void *ptr);
+}
+#endif
+
+using namespace Memstat;
+
+namespace {
+
+   const Int_t kSampleStackDepth = 32;    // number of frames kept per sample
+   const Int_t kSamplesPerBuffer = 256;   // samples kept by a thread before aggregation
+
+   struct TSample {
+      Long64_t      fSize;                        // bytes requested
+      Double_t      fWeight;                      // estimated number of allocations represented
+      const TClass *fClass;                       // class created by TClass::New, if any
+      Int_t         fNframes;                     // number of frames in fFrames
+      void         *fFrames[kSampleStackDepth];   // return addresses
+   };
+
+   // Written without locking by its thread only. fN is the number of valid
+   // samples; the ones before fFlushed were already aggregated (by Close()
+   // while the thread was still running). When the thread exits, its samples
+   // are aggregated and the buffer is kept for the next thread.
+   struct TSampleBuffer {
+      std::atomic<Int_t> fN;
+      Int_t              fFlushed;
+      TSample            fSamples[kSamplesPerBuffer];
+
+      TSampleBuffer() : fN(0), fFlushed(0) {}
+   };
+
+   // Per thread state, zero initialized.
+   struct TSamplerState {
+      Long64_t       fBytesLeft;   // bytes still to be allocated before the next sample
+      ULong64_t      fRandom;      // state of the random generator, 0 until seeded
+      Bool_t         fInSampler;   // set while recording, our own allocations are not sampled
+      TSampleBuffer *fBuffer;      // taken from gFreeBuffers or allocated on first use
+   };
+
+   struct TSampleSum {
+      Long64_t fNsamples;   // number of samples
+      Double_t fNallocs;    // estimated number of allocations
+      Double_t fNbytes;     // estimated number of bytes
+
+      TSampleSum() : fNsamples(0), fNallocs(0), fNbytes(0) {}
+      void Add(const TSample &sample) {
+         ++fNsamples;
+         fNallocs += sample.fWeight;
+         fNbytes += sample.fWeight * sample.fSize;
+      }
+   };
+
+   typedef std::pair<const TClass*, std::vector<void*> > StackKey_t;
+   typedef std::map<StackKey_t, TSampleSum> StackSums_t;
+   typedef std::map<const TClass*, TSampleSum> ClassSums_t;
+
+   Long64_t gInterval = TMemStatSampler::kDefaultInterval;
+   Bool_t   gUseGNUBuiltinBacktrace = kFALSE;
+   Bool_t   gEnabled = kFALSE;
+   Bool_t   gActive = kFALSE;
+
+   // Protects the following, allocated once and never deleted since the
+   // threads keep pointers to their buffer.
+   std::mutex gMutex;
+   std::vector<TSampleBuffer*> *gBuffers = 0;       // buffers of the running threads
+   std::vector<TSampleBuffer*> *gFreeBuffers = 0;   // buffers of the threads which exited
+   StackSums_t *gByStack = 0;
+   ClassSums_t *gByClass = 0;
+
+#if defined(SUPPORTS_MEMSTAT) && !defined(__APPLE__)
+   TMemStatHook::MallocHookFunc_t gPreviousMallocHook = 0;
+   TMemStatHook::FreeHookFunc_t   gPreviousFreeHook = 0;
+#endif
+
+   TSamplerState &GetThreadState() {
+      TTHREAD_TLS(TSamplerState) state;
+      return state;
+   }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Draw the number of bytes until the next sample from an exponential
+/// distribution of mean gInterval (xorshift64* generator).
+
+   Long64_t NextSampleDistance(TSamplerState &state)
+   {
+      if (!state.fRandom)
+         state.fRandom = (ULong64_t(&state) * 0x9E3779B97F4A7C15ULL) | 1;
+      state.fRandom ^= state.fRandom >> 12;
+      state.fRandom ^= state.fRandom << 25;
+      state.fRandom ^= state.fRandom >> 27;
+      ULong64_t r = state.fRandom * 0x2545F4914F6CDD1DULL;
+      Double_t u = ((r >> 11) + 0.5) / 9007199254740992.;   // in ]0,1[
+      return Long64_t(-std::log(u) * gInterval) + 1;
+   }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Aggregate n samples by class and call stack. gMutex must be held.
+
+   void AddSamples(const TSample *samples, Int_t n)
+   {
+      for (Int_t i = 0; i < n; ++i) {
+         const TSample &sample = samples[i];
+         StackKey_t key(sample.fClass, std::vector<void*>(sample.fFrames, sample.fFrames + sample.fNframes));
+         (*gByStack)[key].Add(sample);
+         (*gByClass)[sample.fClass].Add(sample);
+      }
+   }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called at the exit of a thread which recorded samples: aggregate its
+/// samples and keep its buffer for the next thread.
+
+   void ReleaseBuffer(TSampleBuffer *buffer)
+   {
+      // The thread does not sample anymore, the remaining allocations
+      // (other thread local destructors) are ignored.
+      TSamplerState &state = GetThreadState();
+      state.fInSampler = kTRUE;
+      state.fBuffer = 0;
+
+      std::lock_guard<std::mutex> lock(gMutex);
+      Int_t n = buffer->fN.load(std::memory_order_acquire);
+      AddSamples(buffer->fSamples + buffer->fFlushed, n - buffer->fFlushed);
+      buffer->fFlushed = 0;
+      buffer->fN.store(0, std::memory_order_relaxed);
+      gBuffers->erase(std::find(gBuffers->begin(), gBuffers->end(), buffer));
+      gFreeBuffers->push_back(buffer);
+   }
+
+   // Thread local, releases the buffer of the thread when it exits.
+   struct TBufferRelease {
+      TSampleBuffer *fBuffer;
+
+      TBufferRelease() : fBuffer(0) {}
+      ~TBufferRelease() { if (fBuffer) ReleaseBuffer(fBuffer); }
+   };
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a buffer for the calling thread, reusing the buffer of a thread
+/// which exited if possible.
+
+   TSampleBuffer *AcquireBuffer()
+   {
+      TTHREAD_TLS_DECL(TBufferRelease, release);
+
+      TSampleBuffer *buffer = 0;
+      std::lock_guard<std::mutex> lock(gMutex);
+      if (!gFreeBuffers->empty()) {
+         buffer = gFreeBuffers->back();
+         gFreeBuffers->pop_back();
+      } else {
+         buffer = new TSampleBuffer;
+      }
+      gBuffers->push_back(buffer);
+      release.fBuffer = buffer;
+      return buffer;
+   }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the allocation of size bytes which crossed the sampling point.
+
+   void RecordSample(TSamplerState &state, size_t size)
+   {
+      state.fInSampler = kTRUE;
+      // The very first call of a thread only seeds its generator.
+      if (state.fRandom) {
+         if (!state.fBuffer)
+            state.fBuffer = AcquireBuffer();
+         TSampleBuffer *buffer = state.fBuffer;
+         Int_t n = buffer->fN.load(std::memory_order_relaxed);
+         if (n == kSamplesPerBuffer) {
+            std::lock_guard<std::mutex> lock(gMutex);
+            AddSamples(buffer->fSamples + buffer->fFlushed, n - buffer->fFlushed);
+            buffer->fFlushed = 0;
+            buffer->fN.store(0, std::memory_order_relaxed);
+            n = 0;
+         }
+         TSample &sample = buffer->fSamples[n];
+         sample.fSize = size;
+         sample.fWeight = 1. / (1. - std::exp(-Double_t(size) / gInterval));
+         sample.fClass = TClass::GetClassInNew();
+         sample.fNframes = getBacktrace(sample.fFrames, kSampleStackDepth, gUseGNUBuiltinBacktrace);
+         buffer->fN.store(n + 1, std::memory_order_release);
+      }
+      state.fBytesLeft = NextSampleDistance(state);
+      state.fInSampler = kFALSE;
+   }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fast path run for every allocation.
+
+   inline void CountAllocation(size_t size)
+   {
+      TSamplerState &state = GetThreadState();
+      if (state.fInSampler)
+         return;
+      state.fBytesLeft -= size;
+      if (state.fBytesLeft <= 0)
+         RecordSample(state, size);
+   }
+
+#if defined(__APPLE__)
+   void SamplingMacAllocHook(void * /*ptr*/, size_t size)
+   {
+      CountAllocation(size);
+   }
+
+   void SamplingMacFreeHook(void * /*ptr*/)
+   {
+   }
+#elif defined(SUPPORTS_MEMSTAT)
+   // Contrary to TMemStatMng::AllocHook the hooks stay installed: the real
+   // allocator is called directly.
+   void *SamplingMallocHook(size_t size, const void * /*caller*/)
+   {
+      void *result = __libc_malloc(size);
+      CountAllocation(size);
+      return result;
+   }
+
+   void SamplingFreeHook(void *ptr, const void * /*caller*/)
+   {
+      __libc_free(ptr);
+   }
+#endif
+
+   template <typename Iter_t>
+   bool MoreBytes(const Iter_t &a, const Iter_t &b)
+   {
+      return a->second.fNbytes > b->second.fNbytes;
+   }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the aggregated samples to filename. gMutex must be held.
+
+   void WriteReport(const char *filename)
+   {
+      TString name = filename ? TString(filename) : TString::Format("memstat_sampled_%d.root", gSystem->GetPid());
+
+      //preserve context. When exiting will restore the current directory
+      TDirectory::TContext context;
+      TFile file(name, "recreate");
+      if (file.IsZombie()) {
+         ::Error("TMemStatSampler::Close", "cannot create the report file %s", name.Data());
+         return;
+      }
+
+      std::vector<StackSums_t::const_iterator> stacks;
+      for (StackSums_t::const_iterator it = gByStack->begin(); it != gByStack->end(); ++it)
+         stacks.push_back(it);
+      std::sort(stacks.begin(), stacks.end(), MoreBytes<StackSums_t::const_iterator>);
+
+      Long64_t nsamples = 0;
+      Double_t nallocs = 0, nbytes = 0;
+      std::string classname, stack;
+      TTree *tree = new TTree("stacks", "Sampled allocations by class and call stack");
+      tree->Branch("nsamples", &nsamples, "nsamples/L");
+      tree->Branch("nallocs", &nallocs, "nallocs/D");
+      tree->Branch("nbytes", &nbytes, "nbytes/D");
+      tree->Branch("class", &classname);
+      tree->Branch("stack", &stack);
+
+      std::map<void*, TString> symbols;
+      Double_t totalbytes = 0;
+      for (size_t i = 0; i < stacks.size(); ++i) {
+         const StackKey_t &key = stacks[i]->first;
+         nsamples = stacks[i]->second.fNsamples;
+         nallocs = stacks[i]->second.fNallocs;
+         nbytes = stacks[i]->second.fNbytes;
+         totalbytes += nbytes;
+         classname = key.first ? key.first->GetName() : "";
+         stack.clear();
+         for (size_t f = 0; f < key.second.size(); ++f) {
+            TString &symbol = symbols[key.second[f]];
+            if (symbol.IsNull())
+               getSymbolFullInfo(key.second[f], &symbol);
+            if (f)
+               stack += '\n';
+            stack += symbol.Data();
+         }
+         tree->Fill();
+      }
+
+      std::vector<ClassSums_t::const_iterator> classes;
+      for (ClassSums_t::const_iterator it = gByClass->begin(); it != gByClass->end(); ++it)
+         classes.push_back(it);
+      std::sort(classes.begin(), classes.end(), MoreBytes<ClassSums_t::const_iterator>);
+
+      Int_t nclasses = classes.size();
+      TH1D *hbytes = new TH1D("bytesbyclass", "Estimated bytes allocated by class", nclasses, 0, nclasses);
+      TH1D *hallocs = new TH1D("allocsbyclass", "Estimated number of allocations by class", nclasses, 0, nclasses);
+      for (Int_t i = 0; i < nclasses; ++i) {
+         const TClass *cl = classes[i]->first;
+         const char *label = cl ? cl->GetName() : "(no class)";
+         hbytes->GetXaxis()->SetBinLabel(i + 1, label);
+         hbytes->SetBinContent(i + 1, classes[i]->second.fNbytes);
+         hallocs->GetXaxis()->SetBinLabel(i + 1, label);
+         hallocs->SetBinContent(i + 1, classes[i]->second.fNallocs);
+      }
+
+      TParameter<Long64_t> interval("interval", gInterval);
+      interval.Write();
+      file.Write();
+      file.Close();
+
+      ::Info("TMemStatSampler::Close", "%lld call stacks, %.4g bytes allocated (estimated), report written to %s",
+             (Long64_t)stacks.size(), totalbytes, name.Data());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Install the sampling hooks, opening a new session if needed.
+
+void TMemStatSampler::Enable()
+{
+   if (gEnabled)
+      return;
+#if defined(SUPPORTS_MEMSTAT)
+   if (!gActive) {
+      std::lock_guard<std::mutex> lock(gMutex);
+      if (!gBuffers) {
+         gBuffers = new std::vector<TSampleBuffer*>;
+         gFreeBuffers = new std::vector<TSampleBuffer*>;
+         gByStack = new StackSums_t;
+         gByClass = new ClassSums_t;
+      }
+      gActive = kTRUE;
+   }
+   gEnabled = kTRUE;
+#if defined(__APPLE__)
+   TMemStatHook::trackZoneMalloc(SamplingMacAllocHook, SamplingMacFreeHook);
+#else
+   gPreviousMallocHook = TMemStatHook::GetMallocHook();
+   gPreviousFreeHook = TMemStatHook::GetFreeHook();
+   TMemStatHook::SetMallocHook(SamplingMallocHook);
+   TMemStatHook::SetFreeHook(SamplingFreeHook);
+#endif
+#else
+   ::Warning("TMemStatSampler::Enable", "sampling of the allocations is not supported on this platform");
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the sampling hooks. The samples collected so far are kept until
+/// Close().
+
+void TMemStatSampler::Disable()
+{
+   if (!gEnabled)
+      return;
+#if defined(__APPLE__)
+   TMemStatHook::untrackZoneMalloc();
+#elif defined(SUPPORTS_MEMSTAT)
+   TMemStatHook::SetMallocHook(gPreviousMallocHook);
+   TMemStatHook::SetFreeHook(gPreviousFreeHook);
+#endif
+   gEnabled = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Disable the sampling, aggregate the samples of all threads and write the
+/// report to filename (by default memstat_sampled_<pid>.root).
+
+void TMemStatSampler::Close(const char *filename)
+{
+   if (!gActive)
+      return;
+   Disable();
+
+   std::lock_guard<std::mutex> lock(gMutex);
+   for (size_t i = 0; i < gBuffers->size(); ++i) {
+      TSampleBuffer *buffer = (*gBuffers)[i];
+      Int_t n = buffer->fN.load(std::memory_order_acquire);
+      AddSamples(buffer->fSamples + buffer->fFlushed, n - buffer->fFlushed);
+      buffer->fFlushed = n;
+   }
+   WriteReport(filename);
+   gByStack->clear();
+   gByClass->clear();
+   gActive = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the mean number of bytes allocated between two samples.
+
+Long64_t TMemStatSampler::GetInterval()
+{
+   return gInterval;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if a sampling session was enabled and not closed yet.
+
+Bool_t TMemStatSampler::IsActive()
+{
+   return gActive;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the mean number of bytes allocated between two samples. Smaller
+/// values give more precise estimates at a higher cost.
+
+void TMemStatSampler::SetInterval(Long64_t interval)
+{
+   if (interval > 0)
+      gInterval = interval;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// If true, use the gcc builtin to unwind the stack (faster, requires
+/// -fno-omit-frame-pointer), otherwise the glibc backtrace.
+
+void TMemStatSampler::SetUseGNUBuiltinBacktrace(Bool_t newVal)
+{
+   gUseGNUBuiltinBacktrace = newVal;
+}
@@ -143,6 +143,13 @@ public:
    /** mark reply as 404 error - page/request not exists or refused */
    void Set404() { SetContentType("_404_"); }
 
+   /** mark reply as 304 - content was not changed since last request */
+   void SetNotModified()
+   {
+      SetContentType("_304_");
+      SetBinData(0, 0);
+   }
+
    /** mark reply as postponed - submitting thread will not be inform */
    void SetPostponed() { SetContentType("_postponed_"); }
 
@@ -177,6 +184,10 @@ public:
 
    Bool_t CompressWithGzip();
 
+   Bool_t CompressWithDeflate();
+
+   Bool_t CompressWithEncoding(const char *accept_encoding);
+
    /** Set kind of content zipping
      * 0 - none
      * 1 - only when supported in request header
@@ -198,6 +209,7 @@ public:
    Bool_t IsContentType(const char *typ) const { return fContentType == typ; }
    Bool_t Is404() const { return IsContentType("_404_"); }
    Bool_t IsFile() const { return IsContentType("_file_"); }
+   Bool_t IsNotModified() const { return IsContentType("_304_"); }
    Bool_t IsPostponed() const { return IsContentType("_postponed_"); }
    const char *GetContentType() const { return fContentType.Data(); }
 
@@ -21,10 +21,15 @@
 #include "THttpCallArg.h"
 
 #include <mutex>
+#include <map>
+#include <memory>
+#include <string>
 
 class THttpEngine;
 class THttpTimer;
+class THttpSnapshot;
 class TRootSniffer;
+class TH1;
 
 class THttpServer : public TNamed {
 
@@ -49,11 +54,26 @@ protected:
    std::mutex fMutex; ///<! mutex to protect list with arguments
    TList fCallArgs;   ///<! submitted arguments
 
+   Bool_t fConcurrent;       ///<! serve requests to thread-safe items directly from engine threads
+   Long_t fSnapshotInterval; ///<! minimal interval between two snapshots of a thread-safe item, ms
+   std::mutex fSnapMutex;    ///<! mutex to protect map of snapshots
+   std::map<std::string, std::shared_ptr<THttpSnapshot>> fSnapshots; ///<! snapshots of thread-safe items
+   std::mutex fStatMutex;    ///<! mutex to protect latency histogram
+   TH1 *fLatency;            ///<! histogram of requests latency, ms
+
    /** Function called for every processed request */
    virtual void ProcessRequest(THttpCallArg *arg);
 
    static Bool_t VerifyFilePath(const char *fname);
 
+   std::shared_ptr<THttpSnapshot> MakeSnapshot(const char *path);
+
+   Bool_t ProcessConcurrent(THttpCallArg *arg);
+
+   void UpdateSnapshots();
+
+   void FillLatency(Double_t ms);
+
    /** adds CORS to ProcessRequests() responses */
    void SetCors(const char *cor) { fCors = cor; }
 
@@ -93,6 +113,19 @@ public:
 
    void SetTimer(Long_t milliSec = 100, Bool_t mode = kTRUE);
 
+   void SetConcurrent(Bool_t on = kTRUE);
+
+   /** returns kTRUE if requests to thread-safe items are served from engine threads */
+   Bool_t IsConcurrent() const { return fConcurrent; }
+
+   /** set minimal interval between two snapshots of a thread-safe item */
+   void SetSnapshotInterval(Long_t milliSec) { fSnapshotInterval = milliSec; }
+
+   Bool_t SetThreadSafe(const char *fullname, Bool_t on = kTRUE);
+
+   /** returns histogram of requests latency, created in concurrent mode */
+   TH1 *GetLatencyHist() const { return fLatency; }
+
    /** Check if file is requested, thread safe */
    Bool_t IsFileRequested(const char *uri, TString &res) const;
 
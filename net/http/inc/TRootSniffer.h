@@ -16,6 +16,9 @@
 
 #include "TList.h"
 
+#include <map>
+#include <string>
+
 class TFolder;
 class TMemFile;
 class TBufferFile;
@@ -110,6 +113,17 @@ public:
 
 //_______________________________________________________________________
 
+/** State of requested item, used to detect changes of the object content */
+struct TRootSnifferItemState {
+   ULong_t fChecksum = 0;   ///< crc32 of binary representation
+   Long_t fLength = 0;      ///< length of binary representation
+   UInt_t fVersion = 0;     ///< change counter, incremented every time object content changes
+   Int_t fJsonCompact = -1; ///< compact parameter of cached JSON
+   TString fJson;           ///< cached JSON representation of current version
+};
+
+//_______________________________________________________________________
+
 class TRootSniffer : public TNamed {
    enum {
       kItemField = BIT(21) // item property stored as TNamed
@@ -126,6 +140,8 @@ protected:
    TString fCurrentAllowedMethods; ///<! list of allowed methods, extracted when analyzed object restrictions
    TList fRestrictions;            ///<! list of restrictions for different locations
    TString fAutoLoad;              ///<! scripts names, which are add as _autoload parameter to h.json request
+   Bool_t fTrackVersions;          ///<! when enabled, changes of requested objects are tracked and JSON is cached
+   std::map<std::string, TRootSnifferItemState> fItemStates; ///<! states of requested items
 
    void ScanObjectMembers(TRootSnifferScanRec &rec, TClass *cl, char *ptr);
 
@@ -156,6 +172,8 @@ protected:
 
    Int_t WithCurrentUserName(const char *option);
 
+   TRootSnifferItemState *UpdateItemState(const char *path, const char *buf, Long_t len);
+
 public:
    TRootSniffer(const char *name, const char *objpath = "Objects");
    virtual ~TRootSniffer();
@@ -216,6 +234,15 @@ public:
 
    ULong_t GetItemHash(const char *itemname);
 
+   void SetTrackVersions(Bool_t on = kTRUE);
+
+   /** Returns kTRUE when changes of requested objects are tracked */
+   Bool_t IsTrackVersions() const { return fTrackVersions; }
+
+   UInt_t GetItemVersion(const char *path) const;
+
+   TString GetItemETag(const char *path) const;
+
    Bool_t ProduceJson(const char *path, const char *options, TString &res);
 
    Bool_t ProduceXml(const char *path, const char *options, TString &res);
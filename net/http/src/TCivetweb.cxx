@@ -254,29 +254,25 @@ static int begin_request_handler(struct mg_connection *conn, void *)
       mg_send_file(conn, (const char *)arg.GetContent());
    } else {
 
-      Bool_t dozip = arg.GetZipping() > 0;
+      TString encoding; // encodings, accepted by the client
       switch (arg.GetZipping()) {
       case 2:
-         if (arg.GetContentLength() < 10000) {
-            dozip = kFALSE;
-            break;
-         }
+         if (arg.GetContentLength() < 10000) break;
       case 1:
          // check if request header has Accept-Encoding
-         dozip = kFALSE;
          for (int n = 0; n < request_info->num_headers; n++) {
             TString name = request_info->http_headers[n].name;
             if (name.Index("Accept-Encoding", 0, TString::kIgnoreCase) != 0) continue;
-            TString value = request_info->http_headers[n].value;
-            dozip = (value.Index("gzip", 0, TString::kIgnoreCase) != kNPOS);
+            encoding = request_info->http_headers[n].value;
             break;
          }
 
          break;
-      case 3: dozip = kTRUE; break;
+      case 3: encoding = "gzip"; break;
       }
 
-      if (dozip) arg.CompressWithGzip();
+      // gzip or deflate, depending from accepted encodings
+      arg.CompressWithEncoding(encoding.Data());
 
       TString hdr;
       arg.FillHttpHeader(hdr, "HTTP/1.1");
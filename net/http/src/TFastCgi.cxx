@@ -273,8 +273,16 @@ void *TFastCgi::run_func(void *args)
          FCGX_ROOT_send_file(&request, (const char *)arg.GetContent());
       } else {
 
-         // TODO: check in request header that gzip encoding is supported
-         if (arg.GetZipping() > 0) arg.CompressWithGzip();
+         TString encoding; // encodings, accepted by the client
+         switch (arg.GetZipping()) {
+         case 2:
+            if (arg.GetContentLength() < 10000) break;
+         case 1: encoding = arg.GetRequestHeader("HTTP_ACCEPT_ENCODING"); break;
+         case 3: encoding = "gzip"; break;
+         }
+
+         // gzip or deflate, depending from accepted encodings
+         arg.CompressWithEncoding(encoding.Data());
 
          arg.FillHttpHeader(hdr, "Status:");
          FCGX_FPrintF(request.out, hdr.Data());
@@ -13,6 +13,7 @@
 
 #include <string.h>
 #include "RZip.h"
+#include "zlib.h"
 #include "TNamed.h"
 
 //////////////////////////////////////////////////////////////////////////
@@ -242,6 +243,12 @@ void THttpCallArg::FillHttpHeader(TString &hdr, const char *kind)
                "Content-Length: 0\r\n"
                "Connection: close\r\n\r\n",
                kind);
+   } else if (IsNotModified()) {
+      hdr.Form("%s 304 Not Modified\r\n"
+               "Connection: keep-alive\r\n"
+               "Content-Length: 0\r\n"
+               "%s\r\n",
+               kind, fHeader.Data());
    } else {
       hdr.Form("%s 200 OK\r\n"
                "Content-Type: %s\r\n"
@@ -313,6 +320,52 @@ Bool_t THttpCallArg::CompressWithGzip()
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// compress reply data with deflate compression
+/// Produced data has zlib format (RFC 1950), which is expected by browsers for
+/// "deflate" content encoding. It is 8 bytes shorter than gzip format.
+
+Bool_t THttpCallArg::CompressWithDeflate()
+{
+   const Bytef *objbuf = (const Bytef *)GetContent();
+   uLong objlen = GetContentLength();
+
+   // compress2() writes zlib header, compressed data and ADLER32 checksum
+   uLongf buflen = compressBound(objlen);
+
+   void *buffer = malloc(buflen);
+
+   if (compress2((Bytef *)buffer, &buflen, objbuf, objlen, Z_DEFAULT_COMPRESSION) != Z_OK) {
+      free(buffer);
+      return kFALSE;
+   }
+
+   SetBinData(buffer, buflen);
+
+   SetEncoding("deflate");
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// compress reply data with encoding, supported by the client
+/// accept_encoding is value of Accept-Encoding field from request header
+/// gzip is preferred, deflate used when gzip is not accepted
+/// Returns kFALSE when data was not compressed
+
+Bool_t THttpCallArg::CompressWithEncoding(const char *accept_encoding)
+{
+   if (!accept_encoding || IsNotModified() || (GetContentLength() <= 0)) return kFALSE;
+
+   TString value = accept_encoding;
+
+   if (value.Index("gzip", 0, TString::kIgnoreCase) != kNPOS) return CompressWithGzip();
+
+   if (value.Index("deflate", 0, TString::kIgnoreCase) != kNPOS) return CompressWithDeflate();
+
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// method used to notify condition which waiting when operation will complete
 /// Condition notified only if not-postponed state is set
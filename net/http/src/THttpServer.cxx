@@ -23,6 +23,9 @@
 #include "RVersion.h"
 #include "RConfigure.h"
 #include "TRegexp.h"
+#include "TH1F.h"
+#include "TMath.h"
+#include "TBufferJSON.h"
 
 #include "THttpEngine.h"
 #include "TRootSniffer.h"
@@ -33,6 +36,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <fstream>
+#include <atomic>
+#include <chrono>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -157,6 +163,77 @@ public:
    }
 };
 
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// THttpSnapshot                                                        //
+//                                                                      //
+// Copy of a thread-safe item, produced in the main thread              //
+// Used to serve root.json and root.bin requests from engine threads    //
+// without touching objects which can be modified by the application    //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class THttpSnapshot {
+public:
+   std::unique_ptr<TObject> fObject; ///< copy of the object, used for JSON conversion
+   std::string fBinary;              ///< binary data for root.bin requests
+   TString fClassName;               ///< class name of the object
+   ULong_t fHash;                    ///< streamer info hash at the moment of snapshot
+   Long64_t fTime;                   ///< time of the snapshot, ms
+   TString fETag;                    ///< ETag of the object content
+   std::atomic<bool> fRequested;     ///< set when snapshot was used by a request
+
+   THttpSnapshot() : fObject(), fBinary(), fClassName(), fHash(0), fTime(0), fETag(), fRequested(false) {}
+};
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Monotonic time in milliseconds
+
+Long64_t SnapshotClock()
+{
+   return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Milliseconds elapsed since start
+
+Double_t ElapsedMs(const std::chrono::steady_clock::time_point &start)
+{
+   return std::chrono::duration<Double_t, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set caching headers of the reply
+/// Reply with ETag may be kept by the client, but must be revalidated with every request.
+/// If request contains If-None-Match field with the same ETag,
+/// reply converted into "304 Not Modified" without content.
+
+void SetCachingHeaders(THttpCallArg *arg)
+{
+   TString etag = arg->GetHeader("ETag");
+   if (etag.Length() == 0) {
+      // try to avoid caching on the browser
+      arg->AddHeader("Cache-Control",
+                     "private, no-cache, no-store, must-revalidate, max-age=0, proxy-revalidate, s-maxage=0");
+      return;
+   }
+
+   arg->AddHeader("Cache-Control", "private, no-cache, must-revalidate, max-age=0");
+
+   // FastCGI provides request fields as environment variables
+   TString match = arg->GetRequestHeader("If-None-Match");
+   if (match.Length() == 0) match = arg->GetRequestHeader("HTTP_IF_NONE_MATCH");
+
+   if ((match.Length() > 0) && (match.Index(etag) != kNPOS)) arg->SetNotModified();
+}
+
+} // namespace
+
 // =======================================================
 
 ClassImp(THttpServer)
@@ -198,6 +275,18 @@ ClassImp(THttpServer)
 // enable monitoring flag in the browser - than objects view            //
 // will be regularly updated.                                           //
 //                                                                      //
+// Concurrent mode                                                      //
+//                                                                      //
+// By default all requests are processed in the main thread. With       //
+//    serv->SetConcurrent();                                            //
+//    serv->SetThreadSafe("graphs/subfolder/gr1");                      //
+// root.json and root.bin requests to the declared items are served     //
+// directly from the engine (civetweb/fastcgi) threads, using snapshots //
+// of the objects. Snapshots are produced in the main thread, not more  //
+// often than specified with SetSnapshotInterval(), and only for items  //
+// which were requested since the previous snapshot. Latency of all     //
+// requests is accumulated in the Server/RequestLatency histogram.      //
+//                                                                      //
 // More information: https://root.cern/root/htmldoc/guides/HttpServer/HttpServer.html  //
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
@@ -222,7 +311,7 @@ ClassImp(THttpServer)
 THttpServer::THttpServer(const char *engine) : TNamed("http", "ROOT http server"),
    fEngines(), fTimer(0), fSniffer(0), fMainThrdId(0), fJSROOTSYS(),
    fTopName("ROOT"), fJSROOT(), fLocations(), fDefaultPage(), fDefaultPageCont(),
-   fDrawPage(), fDrawPageCont(), fCallArgs()
+   fDrawPage(), fDrawPageCont(), fCallArgs(), fConcurrent(kFALSE), fSnapshotInterval(500), fSnapshots(), fLatency(0)
 {
    fLocations.SetOwner(kTRUE);
 
@@ -272,6 +361,8 @@ THttpServer::THttpServer(const char *engine) : TNamed("http", "ROOT http server"
             GetSniffer()->SetScanGlobalDir(kTRUE);
          } else if (strcmp(opt, "noglobal") == 0) {
             GetSniffer()->SetScanGlobalDir(kFALSE);
+         } else if (strcmp(opt, "concurrent") == 0) {
+            SetConcurrent(kTRUE);
          } else
             CreateEngine(opt);
       }
@@ -298,6 +389,13 @@ THttpServer::~THttpServer()
 {
    fEngines.Delete();
 
+   fSnapshots.clear();
+   if (fLatency) {
+      fSniffer->UnregisterObject(fLatency);
+      delete fLatency;
+      fLatency = 0;
+   }
+
    SetSniffer(0);
 
    SetTimer(0);
@@ -544,19 +642,33 @@ Bool_t THttpServer::IsFileRequested(const char *uri, TString &res) const
 
 Bool_t THttpServer::ExecuteHttp(THttpCallArg *arg)
 {
+   auto start = std::chrono::steady_clock::now();
+
    if ((fMainThrdId != 0) && (fMainThrdId == TThread::SelfId())) {
       // should not happen, but one could process requests directly without any signaling
 
       ProcessRequest(arg);
 
+      FillLatency(ElapsedMs(start));
+
       return kTRUE;
    }
 
-   // add call arg to the list
-   std::unique_lock<std::mutex> lk(fMutex);
-   fCallArgs.Add(arg);
-   // and now wait until request is processed
-   arg->fCond.wait(lk);
+   // requests to thread-safe items served directly in the calling thread
+   if (fConcurrent && ProcessConcurrent(arg)) {
+      FillLatency(ElapsedMs(start));
+      return kTRUE;
+   }
+
+   {
+      // add call arg to the list
+      std::unique_lock<std::mutex> lk(fMutex);
+      fCallArgs.Add(arg);
+      // and now wait until request is processed
+      arg->fCond.wait(lk);
+   }
+
+   FillLatency(ElapsedMs(start));
 
    return kTRUE;
 }
@@ -599,6 +711,9 @@ void THttpServer::ProcessRequests()
       return;
    }
 
+   // refresh snapshots of thread-safe items, used by concurrent requests
+   if (fConcurrent) UpdateSnapshots();
+
    std::unique_lock<std::mutex> lk(fMutex, std::defer_lock);
    while (true) {
       THttpCallArg *arg = 0;
@@ -638,6 +753,9 @@ void THttpServer::ProcessRequests()
 
 void THttpServer::ProcessRequest(THttpCallArg *arg)
 {
+   // latency histogram is filled from engine threads, see FillLatency()
+   std::unique_lock<std::mutex> statlk(fStatMutex, std::defer_lock);
+   if (fLatency && arg->fPathName.Contains(fLatency->GetName())) statlk.lock();
 
    if (arg->fFileName.IsNull() || (arg->fFileName == "index.htm")) {
 
@@ -856,7 +974,11 @@ void THttpServer::ProcessRequest(THttpCallArg *arg)
 
    if (arg->Is404()) return;
 
-   if (iszip) arg->SetZipping(3);
+   if (iszip)
+      arg->SetZipping(3);
+   else if ((filename.EndsWith(".json") || filename.EndsWith(".bin") || filename.EndsWith(".xml")) &&
+            (arg->fQuery.Index("nozip") == kNPOS))
+      arg->SetZipping(2);
 
    if (filename == "root.bin") {
       // only for binary data master version is important
@@ -865,15 +987,237 @@ void THttpServer::ProcessRequest(THttpCallArg *arg)
       arg->AddHeader(parname, Form("%u", (unsigned)fSniffer->GetStreamerInfoHash()));
    }
 
-   // try to avoid caching on the browser
-   arg->AddHeader("Cache-Control",
-                  "private, no-cache, no-store, must-revalidate, max-age=0, proxy-revalidate, s-maxage=0");
+   SetCachingHeaders(arg);
 
    // potentially add cors header
    if (IsCors()) arg->AddHeader("Access-Control-Allow-Origin", GetCors());
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable concurrent processing of requests
+///
+/// In concurrent mode root.json and root.bin requests to items, declared
+/// with SetThreadSafe(), are served directly from the engine threads
+/// without waiting for the main ROOT thread. All other requests are
+/// still processed in the main thread.
+/// In addition, "Server/RequestLatency" histogram is created, which
+/// accumulates processing time of all requests in milliseconds.
+/// Concurrent mode also can be enabled with "concurrent" option in constructor:
+///
+///     new THttpServer("http:8080;concurrent");
+
+void THttpServer::SetConcurrent(Bool_t on)
+{
+   if (on) ROOT::EnableThreadSafety();
+
+   if (on && !fLatency) {
+      std::vector<Double_t> bins(61);
+      for (Int_t n = 0; n <= 60; ++n) bins[n] = TMath::Power(10., -3. + 7. * n / 60.);
+
+      TH1 *hist = new TH1F("RequestLatency", "Latency of http requests;time, ms;counts", 60, bins.data());
+      hist->SetDirectory(nullptr);
+
+      {
+         std::lock_guard<std::mutex> grd(fStatMutex);
+         fLatency = hist;
+      }
+
+      fSniffer->RegisterObject("/Server", fLatency);
+   }
+
+   fConcurrent = on;
+
+   if (on) SetThreadSafe("Server/RequestLatency");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare item as thread-safe
+///
+/// Snapshot of the object is created in the main thread and used to
+/// serve root.json and root.bin requests in concurrent mode (see SetConcurrent()).
+/// Snapshot is refreshed during ProcessRequests() if item was requested
+/// and snapshot is older than interval configured with SetSnapshotInterval().
+/// Therefore client may get data which is up to that interval old.
+/// Requests to a snapshot older than that interval are processed in the main thread.
+/// Items with access restrictions cannot be declared thread-safe,
+/// requests to them always processed in the main thread.
+/// Method should be called from main thread.
+
+Bool_t THttpServer::SetThreadSafe(const char *fullname, Bool_t on)
+{
+   if (!fullname || !*fullname) return kFALSE;
+
+   std::string path = (*fullname == '/') ? fullname + 1 : fullname;
+
+   if (!on) {
+      std::lock_guard<std::mutex> grd(fSnapMutex);
+      return fSnapshots.erase(path) > 0;
+   }
+
+   if (fSniffer->HasRestriction(path.c_str())) {
+      Error("SetThreadSafe", "Item %s has access restrictions, cannot be served concurrently", path.c_str());
+      return kFALSE;
+   }
+
+   auto snap = MakeSnapshot(path.c_str());
+   if (!snap) {
+      Error("SetThreadSafe", "Cannot create snapshot of item %s", path.c_str());
+      return kFALSE;
+   }
+
+   std::lock_guard<std::mutex> grd(fSnapMutex);
+   fSnapshots[path] = snap;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Creates snapshot of the object, found in the hierarchy
+/// Should be called from main thread
+
+std::shared_ptr<THttpSnapshot> THttpServer::MakeSnapshot(const char *path)
+{
+   TObject *obj = fSniffer->FindTObjectInHierarchy(path);
+   if (!obj) return nullptr;
+
+   std::shared_ptr<THttpSnapshot> snap = std::make_shared<THttpSnapshot>();
+
+   // latency histogram can be filled from other threads,
+   // keep it locked until both copy and binary data are produced
+   std::unique_lock<std::mutex> lk(fStatMutex, std::defer_lock);
+   if (obj == fLatency) lk.lock();
+
+   snap->fObject.reset(obj->Clone());
+
+   if (!snap->fObject) return nullptr;
+
+   if (snap->fObject->InheritsFrom(TH1::Class())) ((TH1 *)snap->fObject.get())->SetDirectory(nullptr);
+
+   void *bindata(0);
+   Long_t bindatalen(0);
+   if (fSniffer->ProduceBinary(path, "", bindata, bindatalen) && bindata) {
+      snap->fBinary.assign((const char *)bindata, bindatalen);
+      free(bindata);
+   }
+
+   snap->fClassName = obj->ClassName();
+   snap->fHash = fSniffer->GetStreamerInfoHash();
+   snap->fTime = SnapshotClock();
+   snap->fETag = fSniffer->GetItemETag(path);
+
+   return snap;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Refresh snapshots of thread-safe items, which were requested since last update
+/// Invoked from ProcessRequests() in main thread
+
+void THttpServer::UpdateSnapshots()
+{
+   std::vector<std::string> paths;
+   Long64_t now = SnapshotClock();
+
+   {
+      std::lock_guard<std::mutex> grd(fSnapMutex);
+      for (auto &entry : fSnapshots)
+         if (entry.second->fRequested && (now - entry.second->fTime >= fSnapshotInterval))
+            paths.push_back(entry.first);
+   }
+
+   for (auto &path : paths) {
+      auto snap = MakeSnapshot(path.c_str());
+
+      std::lock_guard<std::mutex> grd(fSnapMutex);
+      // object disappeared from the hierarchy, requests will go to main thread
+      if (!snap)
+         fSnapshots.erase(path);
+      else
+         fSnapshots[path] = snap;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process request in the calling thread, using snapshot of thread-safe item
+/// Only root.json and root.bin requests are supported
+/// Returns kFALSE if request should be processed in the main thread
+
+Bool_t THttpServer::ProcessConcurrent(THttpCallArg *arg)
+{
+   TString filename = arg->fFileName;
+   Bool_t iszip = kFALSE;
+   if (filename.EndsWith(".gz")) {
+      filename.Resize(filename.Length() - 3);
+      iszip = kTRUE;
+   }
+
+   Bool_t isjson = (filename == "root.json");
+   if (!isjson && (filename != "root.bin")) return kFALSE;
+
+   std::string path = arg->fPathName.Data();
+   if (!path.empty() && (path[0] == '/')) path.erase(0, 1);
+
+   std::shared_ptr<THttpSnapshot> snap;
+   {
+      std::lock_guard<std::mutex> grd(fSnapMutex);
+      auto iter = fSnapshots.find(path);
+      if (iter != fSnapshots.end()) snap = iter->second;
+   }
+   if (!snap) return kFALSE;
+
+   snap->fRequested = true;
+
+   // snapshot is not refreshed in time when main thread is busy or does not
+   // call ProcessRequests(), such request is processed in the main thread
+   if (SnapshotClock() - snap->fTime > fSnapshotInterval) return kFALSE;
+
+   if (!isjson && snap->fBinary.empty()) return kFALSE;
+
+   arg->SetContentType(GetMimeType(filename.Data()));
+
+   if (iszip)
+      arg->SetZipping(3);
+   else if (arg->fQuery.Index("nozip") == kNPOS)
+      arg->SetZipping(2);
+
+   if (snap->fETag.Length() > 0) arg->AddHeader("ETag", snap->fETag.Data());
+
+   SetCachingHeaders(arg);
+
+   // potentially add cors header
+   if (IsCors()) arg->AddHeader("Access-Control-Allow-Origin", GetCors());
+
+   // nothing to produce when client already has this version of the object
+   if (arg->IsNotModified()) return kTRUE;
+
+   if (isjson) {
+      TUrl url;
+      url.SetOptions(arg->fQuery);
+      url.ParseOptions();
+      Int_t compact = 0;
+      if (url.GetValueFromOptions("compact")) compact = url.GetIntValueFromOptions("compact");
+      arg->fContent = TBufferJSON::ConvertToJSON(snap->fObject.get(), compact);
+   } else {
+      void *bindata = malloc(snap->fBinary.length());
+      memcpy(bindata, snap->fBinary.data(), snap->fBinary.length());
+      arg->SetBinData(bindata, snap->fBinary.length());
+      arg->AddHeader("RootClassName", snap->fClassName.Data());
+      arg->AddHeader("MVersion", TString::Format("%u", (unsigned)snap->fHash).Data());
+   }
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Accumulate request latency in the histogram, thread safe
+
+void THttpServer::FillLatency(Double_t ms)
+{
+   if (!fLatency) return;
+
+   std::lock_guard<std::mutex> grd(fStatMutex);
+   fLatency->Fill(ms);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Register object in folders hierarchy
 ///
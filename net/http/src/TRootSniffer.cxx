@@ -401,7 +401,8 @@ ClassImp(TRootSniffer);
 
    TRootSniffer::TRootSniffer(const char *name, const char *objpath)
    : TNamed(name, "sniffer of root objects"), fObjectsPath(objpath), fMemFile(0), fSinfo(0), fReadOnly(kTRUE),
-     fScanGlobalDir(kTRUE), fCurrentArg(0), fCurrentRestrict(0), fCurrentAllowedMethods(0), fRestrictions(), fAutoLoad()
+     fScanGlobalDir(kTRUE), fCurrentArg(0), fCurrentRestrict(0), fCurrentAllowedMethods(0), fRestrictions(), fAutoLoad(),
+     fTrackVersions(kTRUE), fItemStates()
 {
    fRestrictions.SetOwner(kTRUE);
 }
@@ -1034,6 +1035,80 @@ ULong_t TRootSniffer::GetItemHash(const char *itemname)
    return obj == 0 ? 0 : TString::Hash(obj, obj->IsA()->Size());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable tracking of objects versions
+///
+/// When enabled (default), checksum of binary representation is calculated for
+/// every root.bin request and for root.json requests of histograms, graphs and
+/// canvases (see IsDrawableClass()). When checksum changes, item version is
+/// incremented. Reply gets "ETag" header and client, sending it back in
+/// "If-None-Match" header, gets "304 Not Modified" reply if object was not changed.
+/// Also JSON representation of last version is kept and reused while object is not changed.
+/// Disabling tracking also release all cached data.
+
+void TRootSniffer::SetTrackVersions(Bool_t on)
+{
+   fTrackVersions = on;
+   fItemStates.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns version of the item - number of detected changes of object content
+/// Returns 0 if item was never requested or versions are not tracked
+
+UInt_t TRootSniffer::GetItemVersion(const char *path) const
+{
+   if (!path) return 0;
+   if (*path == '/') path++;
+
+   auto iter = fItemStates.find(path);
+   return iter == fItemStates.end() ? 0 : iter->second.fVersion;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns ETag value, which identifies current content of the item
+/// Returns empty string if item was never requested or versions are not tracked
+
+TString TRootSniffer::GetItemETag(const char *path) const
+{
+   if (!path) return TString();
+   if (*path == '/') path++;
+
+   auto iter = fItemStates.find(path);
+   if (iter == fItemStates.end()) return TString();
+
+   return TString::Format("\"%u-%lx\"", iter->second.fVersion, iter->second.fChecksum);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Update state of the item with binary representation of the object
+/// If content differs from previous request, item version is incremented
+/// and cached JSON is cleared. ETag header is set for current http request.
+
+TRootSnifferItemState *TRootSniffer::UpdateItemState(const char *path, const char *buf, Long_t len)
+{
+   // many items can be accessed once, avoid unlimited grow of the map
+   if ((fItemStates.size() >= 1000) && (fItemStates.find(path) == fItemStates.end())) fItemStates.clear();
+
+   TRootSnifferItemState &state = fItemStates[path];
+
+   ULong_t crc = R__crc32(0, NULL, 0);
+   crc = R__crc32(crc, (const unsigned char *)buf, len);
+
+   if ((state.fVersion == 0) || (state.fChecksum != crc) || (state.fLength != len)) {
+      state.fVersion++;
+      state.fChecksum = crc;
+      state.fLength = len;
+      state.fJson.Clear();
+      state.fJsonCompact = -1;
+   }
+
+   if (fCurrentArg)
+      fCurrentArg->SetExtraHeader("ETag", TString::Format("\"%u-%lx\"", state.fVersion, state.fChecksum).Data());
+
+   return &state;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Method verifies if object can be drawn
 
@@ -1126,8 +1201,31 @@ Bool_t TRootSniffer::ProduceJson(const char *path, const char *options, TString
    void *obj_ptr = FindInHierarchy(path, &obj_cl, &member);
    if ((obj_ptr == 0) || ((obj_cl == 0) && (member == 0))) return kFALSE;
 
+   TRootSnifferItemState *state = 0;
+
+   // tracking only for objects like histograms, which are typically polled by clients
+   if (fTrackVersions && !member && IsDrawableClass(obj_cl) && (obj_cl->GetBaseClassOffset(TObject::Class()) == 0)) {
+      // binary streaming is much faster than JSON conversion,
+      // use it to detect if object was changed since last request
+      TBufferFile sbuf(TBuffer::kWrite, 100000);
+      sbuf.MapObject((TObject *)obj_ptr);
+      ((TObject *)obj_ptr)->Streamer(sbuf);
+
+      state = UpdateItemState(path, sbuf.Buffer(), sbuf.Length());
+
+      if ((state->fJsonCompact == compact) && (state->fJson.Length() > 0)) {
+         res = state->fJson;
+         return kTRUE;
+      }
+   }
+
    res = TBufferJSON::ConvertToJSON(obj_ptr, obj_cl, compact >= 0 ? compact : 0, member ? member->GetName() : 0);
 
+   if (state && (res.Length() > 0)) {
+      state->fJson = res;
+      state->fJsonCompact = compact;
+   }
+
    return res.Length() > 0;
 }
 
@@ -1711,6 +1809,9 @@ Bool_t TRootSniffer::ProduceMulti(const char *path, const char *options, void *&
 
    for (unsigned n = 0; n < mem.size(); n++) free(mem[n]);
 
+   // ETag of the single items cannot be used for complete reply
+   fCurrentArg->SetExtraHeader("ETag", 0);
+
    return kTRUE;
 }
 
@@ -1767,6 +1868,8 @@ Bool_t TRootSniffer::ProduceBinary(const char *path, const char * /*query*/, voi
    gDirectory = olddir;
    gFile = oldfile;
 
+   if (fTrackVersions) UpdateItemState(path, sbuf->Buffer(), sbuf->Length());
+
    ptr = malloc(sbuf->Length());
    memcpy(ptr, sbuf->Buffer(), sbuf->Length());
    length = sbuf->Length();
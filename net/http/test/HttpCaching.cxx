@@ -0,0 +1,120 @@
+#include "THttpCallArg.h"
+#include "THttpServer.h"
+#include "TH1.h"
+
+#include "gtest/gtest.h"
+
+#include "zlib.h"
+
+#include <string>
+
+// Process request directly in the main thread of the server
+void Request(THttpServer &serv, THttpCallArg &arg, const char *path, const char *header = nullptr)
+{
+   arg.SetPathAndFileName(path);
+   if (header)
+      arg.SetRequestHeader(header);
+   EXPECT_TRUE(serv.ExecuteHttp(&arg));
+}
+
+// Inflate zlib (window_bits = MAX_WBITS) or gzip (window_bits = 16 + MAX_WBITS) data
+std::string Inflate(const void *data, Long_t len, int window_bits)
+{
+   z_stream stream = {};
+   stream.next_in = (Bytef *)data;
+   stream.avail_in = len;
+   EXPECT_EQ(inflateInit2(&stream, window_bits), Z_OK);
+
+   std::string res;
+   char buf[4096];
+   int ret = Z_OK;
+   while (ret == Z_OK) {
+      stream.next_out = (Bytef *)buf;
+      stream.avail_out = sizeof(buf);
+      ret = inflate(&stream, Z_NO_FLUSH);
+      res.append(buf, sizeof(buf) - stream.avail_out);
+   }
+   EXPECT_EQ(ret, Z_STREAM_END);
+   EXPECT_EQ(stream.avail_in, 0u);
+   inflateEnd(&stream);
+   return res;
+}
+
+TEST(THttpServer, NotModified)
+{
+   THttpServer serv("");
+   serv.SetTimer(0);
+
+   TH1F hist("hist", "cached histogram", 10, 0., 10.);
+   hist.SetDirectory(nullptr);
+   hist.Fill(5.);
+   serv.Register("/Test", &hist);
+   // defines main thread of the server
+   serv.ProcessRequests();
+
+   THttpCallArg arg1;
+   Request(serv, arg1, "Test/hist/root.json");
+   EXPECT_FALSE(arg1.IsNotModified());
+   EXPECT_GT(arg1.GetContentLength(), 0);
+   TString etag = arg1.GetHeader("ETag");
+   ASSERT_GT(etag.Length(), 0);
+
+   // same object, client already has it
+   THttpCallArg arg2;
+   Request(serv, arg2, "Test/hist/root.json", TString::Format("If-None-Match: %s\r\n", etag.Data()).Data());
+   EXPECT_TRUE(arg2.IsNotModified());
+   EXPECT_EQ(arg2.GetContentLength(), 0);
+
+   // object changed, full reply with new ETag
+   hist.Fill(7.);
+   THttpCallArg arg3;
+   Request(serv, arg3, "Test/hist/root.json", TString::Format("If-None-Match: %s\r\n", etag.Data()).Data());
+   EXPECT_FALSE(arg3.IsNotModified());
+   EXPECT_GT(arg3.GetContentLength(), 0);
+   TString etag3 = arg3.GetHeader("ETag");
+   EXPECT_GT(etag3.Length(), 0);
+   EXPECT_NE(etag, etag3);
+
+   // binary requests are tracked as well
+   THttpCallArg arg4;
+   Request(serv, arg4, "Test/hist/root.bin");
+   TString etag4 = arg4.GetHeader("ETag");
+   ASSERT_GT(etag4.Length(), 0);
+   THttpCallArg arg5;
+   Request(serv, arg5, "Test/hist/root.bin", TString::Format("If-None-Match: %s\r\n", etag4.Data()).Data());
+   EXPECT_TRUE(arg5.IsNotModified());
+
+   serv.Unregister(&hist);
+}
+
+TEST(THttpCallArg, Compression)
+{
+   std::string payload;
+   for (int n = 0; n < 2000; ++n)
+      payload += "{\"_typename\" : \"TH1F\", \"fBins\" : " + std::to_string(n * 7 % 113) + "},\n";
+
+   THttpCallArg arg1;
+   arg1.SetContent(payload.c_str());
+   EXPECT_TRUE(arg1.CompressWithEncoding("deflate"));
+   EXPECT_EQ(arg1.GetHeader("Content-Encoding"), "deflate");
+   EXPECT_LT(arg1.GetContentLength(), (Long_t)payload.length());
+   EXPECT_EQ(Inflate(arg1.GetContent(), arg1.GetContentLength(), MAX_WBITS), payload);
+
+   THttpCallArg arg2;
+   arg2.SetContent(payload.c_str());
+   EXPECT_TRUE(arg2.CompressWithEncoding("gzip, deflate"));
+   EXPECT_EQ(arg2.GetHeader("Content-Encoding"), "gzip");
+   EXPECT_LT(arg2.GetContentLength(), (Long_t)payload.length());
+   EXPECT_EQ(Inflate(arg2.GetContent(), arg2.GetContentLength(), 16 + MAX_WBITS), payload);
+
+   // small content, compressed data may be larger than original
+   THttpCallArg arg3;
+   arg3.SetContent("{}");
+   EXPECT_TRUE(arg3.CompressWithDeflate());
+   EXPECT_EQ(Inflate(arg3.GetContent(), arg3.GetContentLength(), MAX_WBITS), "{}");
+
+   THttpCallArg arg4;
+   arg4.SetContent(payload.c_str());
+   EXPECT_FALSE(arg4.CompressWithEncoding("br"));
+   EXPECT_EQ(arg4.GetContentLength(), (Long_t)payload.length());
+}
@@ -0,0 +1,81 @@
+#include "THttpCallArg.h"
+#include "THttpServer.h"
+#include "TH1.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+// Issue request from an engine-like thread, returns content of the reply.
+// Main thread processes requests until the reply arrives.
+TString RequestFromThread(THttpServer &serv, THttpCallArg &arg, Bool_t &served_concurrently)
+{
+   auto reply = std::async(std::launch::async, [&serv, &arg]() { return serv.ExecuteHttp(&arg); });
+
+   served_concurrently = reply.wait_for(std::chrono::seconds(1)) == std::future_status::ready;
+
+   while (reply.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready)
+      serv.ProcessRequests();
+
+   EXPECT_TRUE(reply.get());
+
+   return TString((const char *)arg.GetContent(), arg.GetContentLength());
+}
+
+TEST(THttpServer, ConcurrentRequest)
+{
+   THttpServer serv("");
+   serv.SetTimer(0);
+
+   TH1F hist("hist", "concurrent histogram", 10, 0., 10.);
+   hist.SetDirectory(nullptr);
+   hist.Fill(5.);
+   serv.Register("/Test", &hist);
+
+   serv.SetConcurrent();
+   EXPECT_TRUE(serv.SetThreadSafe("Test/hist"));
+   // defines main thread of the server
+   serv.ProcessRequests();
+
+   THttpCallArg arg1;
+   arg1.SetPathAndFileName("Test/hist/root.json");
+   Bool_t concurrent = kFALSE;
+   TString json = RequestFromThread(serv, arg1, concurrent);
+   EXPECT_TRUE(concurrent);
+   EXPECT_TRUE(json.Contains("TH1F")) << json;
+   EXPECT_TRUE(json.Contains("concurrent histogram")) << json;
+
+   THttpCallArg arg2;
+   arg2.SetPathAndFileName("Test/hist/root.bin");
+   RequestFromThread(serv, arg2, concurrent);
+   EXPECT_TRUE(concurrent);
+   EXPECT_GT(arg2.GetContentLength(), 0);
+
+   // outdated snapshot, request goes to the main thread and gets actual content
+   serv.SetSnapshotInterval(1);
+   hist.SetTitle("modified histogram");
+   std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+   THttpCallArg arg3;
+   arg3.SetPathAndFileName("Test/hist/root.json");
+   json = RequestFromThread(serv, arg3, concurrent);
+   EXPECT_FALSE(concurrent);
+   EXPECT_TRUE(json.Contains("modified histogram")) << json;
+
+   // requests to the latency histogram itself are served from its snapshot
+   serv.SetSnapshotInterval(1000);
+   EXPECT_TRUE(serv.SetThreadSafe("Server/RequestLatency"));
+   THttpCallArg arg4;
+   arg4.SetPathAndFileName("Server/RequestLatency/root.json");
+   json = RequestFromThread(serv, arg4, concurrent);
+   EXPECT_TRUE(concurrent);
+   EXPECT_TRUE(json.Contains("RequestLatency")) << json;
+
+   ASSERT_NE(serv.GetLatencyHist(), nullptr);
+   EXPECT_EQ(serv.GetLatencyHist()->GetEntries(), 4);
+
+   serv.Unregister(&hist);
+}
@@ -25,6 +25,7 @@ Exponential p.d.f
 #include "Riostream.h"
 #include "Riostream.h"
 #include <math.h>
+#include <vector>
 
 #include "RooExponential.h"
 #include "RooRealVar.h"
@@ -57,6 +58,21 @@ Double_t RooExponential::evaluate() const{
   return exp(c*x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate() for the events [first,first+nEvents) of the data store
+
+Bool_t RooExponential::evaluateBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* /*normSet*/) const
+{
+  std::vector<Double_t> xv(nEvents), cv(nEvents) ;
+  if (!x.arg().getValBatch(&xv[0],first,nEvents,data,x.nset())) return kFALSE ;
+  if (!c.arg().getValBatch(&cv[0],first,nEvents,data,c.nset())) return kFALSE ;
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    output[i] = exp(cv[i]*xv[i]) ;
+  }
+  return kTRUE ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
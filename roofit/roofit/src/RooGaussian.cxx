@@ -25,6 +25,7 @@ Plain Gaussian p.d.f
 #include "Riostream.h"
 #include "Riostream.h"
 #include <math.h>
+#include <vector>
 
 #include "RooGaussian.h"
 #include "RooAbsReal.h"
@@ -69,6 +70,25 @@ Double_t RooGaussian::evaluate() const
   return ret ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): compute the unnormalized values for the events
+/// [first,first+nEvents) of the data store
+
+Bool_t RooGaussian::evaluateBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* /*normSet*/) const
+{
+  std::vector<Double_t> xv(nEvents), meanv(nEvents), sigmav(nEvents) ;
+  if (!x.arg().getValBatch(&xv[0],first,nEvents,data,x.nset())) return kFALSE ;
+  if (!mean.arg().getValBatch(&meanv[0],first,nEvents,data,mean.nset())) return kFALSE ;
+  if (!sigma.arg().getValBatch(&sigmav[0],first,nEvents,data,sigma.nset())) return kFALSE ;
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    const Double_t arg = xv[i] - meanv[i] ;
+    const Double_t sig = sigmav[i] ;
+    output[i] = exp(-0.5*arg*arg/(sig*sig)) ;
+  }
+  return kTRUE ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// calculate and return the negative log-likelihood of the Poisson
 
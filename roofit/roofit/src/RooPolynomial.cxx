@@ -26,6 +26,7 @@ less than polynomial functions due to the normalization condition
 
 #include <cmath>
 #include <cassert>
+#include <algorithm>
 
 #include "RooPolynomial.h"
 #include "RooAbsReal.h"
@@ -123,6 +124,34 @@ Double_t RooPolynomial::evaluate() const
   return retVal * std::pow(x, lowestOrder) + (lowestOrder ? 1.0 : 0.0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate() for the events [first,first+nEvents) of the data store.
+/// The polynomial is evaluated with the Horner scheme, one coefficient at a time
+
+Bool_t RooPolynomial::evaluateBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* /*normSet*/) const
+{
+  const int sz = _coefList.getSize();
+  const int lowestOrder = _lowestOrder;
+  if (!sz) {
+    std::fill(output, output + nEvents, lowestOrder ? 1. : 0.);
+    return kTRUE;
+  }
+
+  std::vector<Double_t> xv(nEvents), cv(nEvents);
+  if (!_x.arg().getValBatch(&xv[0], first, nEvents, data, _x.nset())) return kFALSE;
+
+  const RooArgSet* nset = _coefList.nset();
+  if (!static_cast<RooAbsReal&>(_coefList[sz - 1]).getValBatch(output, first, nEvents, data, nset)) return kFALSE;
+  for (int j = sz - 1; j--; ) {
+    if (!static_cast<RooAbsReal&>(_coefList[j]).getValBatch(&cv[0], first, nEvents, data, nset)) return kFALSE;
+    for (Int_t i = 0; i < nEvents; ++i) output[i] = cv[i] + xv[i] * output[i];
+  }
+  for (Int_t i = 0; i < nEvents; ++i) {
+    output[i] = output[i] * std::pow(xv[i], lowestOrder) + (lowestOrder ? 1.0 : 0.0);
+  }
+  return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooPolynomial::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
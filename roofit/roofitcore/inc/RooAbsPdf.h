@@ -186,6 +186,7 @@ public:
   virtual Bool_t traceEvalHook(Double_t value) const ;  
   virtual Double_t getValV(const RooArgSet* set=0) const ;
   virtual Double_t getLogVal(const RooArgSet* set=0) const ;
+  virtual Bool_t getValBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet=0) const ;
 
   Double_t getNorm(const RooArgSet& nset) const { 
     // Get p.d.f normalization term needed for observables 'nset'
@@ -73,6 +73,9 @@ public:
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
 
+  // Batch evaluation for a range of events of a vector data store
+  virtual Bool_t getValBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet=0) const ;
+
   Double_t getPropagatedError(const RooFitResult& fr) ;
 
   Bool_t operator==(Double_t value) const ;
@@ -372,6 +375,10 @@ protected:
   }
   virtual Double_t evaluate() const = 0 ;
 
+  // Batch evaluation interface
+  Bool_t getValBatchFromData(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const ;
+  virtual Bool_t evaluateBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const ;
+
   // Hooks for RooDataSet interface
   friend class RooRealIntegral ;
   friend class RooVectorDataStore ;
@@ -27,6 +27,7 @@ class RooAbsData ;
 class RooAbsReal ;
 class RooSimultaneous ;
 class RooRealMPFE ;
+namespace ROOT { class TThreadExecutor ; }
 
 class RooAbsTestStatistic ;
 typedef RooAbsTestStatistic* pRooAbsTestStatistic ;
@@ -95,9 +96,9 @@ protected:
   
   RooSetProxy _paramSet ;          // Parameters of the test statistic (=parameters of the input function)
 
-  enum GOFOpMode { SimMaster,MPMaster,Slave } ;
+  enum GOFOpMode { SimMaster,MPMaster,Slave,MTMaster } ;
   GOFOpMode operMode() const { 
-    // Return test statistic operation mode of this instance (SimMaster, MPMaster or Slave)
+    // Return test statistic operation mode of this instance (SimMaster, MPMaster, Slave or MTMaster)
     return _gofOpMode ; 
   }
 
@@ -121,6 +122,10 @@ protected:
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;    
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void initMTParameters() ;
+  void syncMTParameters() const ;
+  static Bool_t useThreads() ;
 
   mutable Bool_t _init ;          //! Is object initialized  
   GOFOpMode   _gofOpMode ;        // Operation mode of test statistic instance 
@@ -138,6 +143,9 @@ protected:
   // Parallel mode data
   Int_t          _nCPU ;      //  Number of processors to use in parallel calculation mode
   pRooRealMPFE*  _mpfeArray ; //! Array of parallel execution frond ends
+  mutable Bool_t _mtSerialEval ; //! Evaluate thread partitions serially on the next call (set after configuration changes)
+  RooArgSet**    _mtParamArray ; //! Parameter clones owned by each thread partition
+  mutable ROOT::TThreadExecutor* _mtExecutor ; //! Executor evaluating the thread partitions
 
   RooFit::MPSplit        _mpinterl ; // Use interleaving strategy rather than N-wise split for partioning of dataset for multiprocessor-split
   Bool_t         _doOffset ; // Apply interval value offset to control numeric precision?
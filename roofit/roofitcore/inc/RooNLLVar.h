@@ -66,6 +66,7 @@ protected:
 
   Bool_t _extended ;
   virtual Double_t evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const ;
+  Bool_t evaluateBatches(Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& carry, Double_t& sumWeight, Double_t& sumWeightCarry) const ;
   Bool_t _weightSq ; // Apply weights squared?
   mutable Bool_t _first ; //!
   Double_t _offsetSaveW2; //!
@@ -73,6 +74,7 @@ protected:
 
   mutable std::vector<Double_t> _binw ; //!
   mutable RooRealSumPdf* _binnedPdf ; //!
+  mutable Bool_t _batchUnsupported ; //! Pdf does not support batch evaluation
    
   ClassDef(RooNLLVar,2) // Function representing (extended) -log(L) of p.d.f and dataset
 };
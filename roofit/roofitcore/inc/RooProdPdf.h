@@ -55,6 +55,7 @@ public:
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
   Double_t evaluate() const ;
+  Bool_t evaluateBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const ;
   virtual Bool_t checkObservables(const RooArgSet* nset) const ;	
 
   virtual Bool_t forceAnalyticalInt(const RooAbsArg& dep) const ; 
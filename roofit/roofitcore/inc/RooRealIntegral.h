@@ -22,6 +22,8 @@
 #include "RooRealProxy.h"
 #include "RooSetProxy.h"
 #include "RooListProxy.h"
+#include <list>
+#include <vector>
 
 class RooArgSet ;
 class TH1F ;
@@ -70,6 +72,19 @@ public:
 
   static Int_t getCacheAllNumeric() ;
 
+  static void setNumericValueCacheSize(Int_t size) ;
+  static Int_t getNumericValueCacheSize() ;
+
+  // Statistics of numeric integrations
+  Int_t numCacheHits() const { return _nCacheHits ; }
+  Int_t numCacheMisses() const { return _nCacheMisses ; }
+  Double_t cacheHitRate() const { return (_nCacheHits+_nCacheMisses)>0 ? Double_t(_nCacheHits)/(_nCacheHits+_nCacheMisses) : 0. ; }
+  Double_t integrationTime() const { 
+    // Total wall clock time (in seconds) spent in numeric integrations
+    return _intTime ; 
+  }
+  void resetIntegrationStats() const { _nCacheHits = 0 ; _nCacheMisses = 0 ; _intTime = 0 ; }
+
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const {
     // Forward plot sampling hint of integrand
     return _function.arg().plotSamplingHint(obs,xlo,xhi) ;
@@ -83,6 +98,21 @@ protected:
 
   const RooArgSet& parameters() const ;
 
+  // Key of the numeric value cache: everything the value of a numeric integral depends on
+  struct ValueCacheKey {
+    const RooNumIntConfig* _config ; // Integrator configuration
+    const TNamed* _intRange ;        // Integration range
+    const TNamed* _normRange ;       // Normalization range of the integrand
+    std::vector<Double_t> _values ;  // Parameter values, integration and normalization limits, integrator settings
+    bool operator==(const ValueCacheKey& other) const {
+      return _config==other._config && _intRange==other._intRange && _normRange==other._normRange && _values==other._values ;
+    }
+  } ;
+
+  Bool_t valueCacheKey(ValueCacheKey& key) const ;
+  Bool_t getCachedValue(const ValueCacheKey& key, Double_t& value) const ;
+  void cacheValue(const ValueCacheKey& key, Double_t value) const ;
+
   enum IntOperMode { Hybrid, Analytic, PassThrough } ;
   //friend class RooAbsPdf ;
 
@@ -137,6 +167,16 @@ protected:
   Bool_t _cacheNum ;           // Cache integral if numeric
   static Int_t _cacheAllNDim ; //! Cache all integrals with given numeric dimension
 
+  typedef std::list<std::pair<ValueCacheKey,Double_t> > ValueCache ;
+  mutable ValueCache _valueCache ;   //! Recently calculated numeric integrals, most recent first
+  mutable RooArgSet* _cacheParams ;  //! Leaf parameters of the integrand defining the value cache key
+  mutable RooArgSet* _cacheNormObs ; //! Observables of the integrand's normalization set
+  static Int_t _valueCacheSize ;     //! Maximum number of values kept per integral
+
+  mutable Int_t _nCacheHits ;    //! Number of numeric integrals taken from the value cache
+  mutable Int_t _nCacheMisses ;  //! Number of value cache lookups that required a new integration
+  mutable Double_t _intTime ;    //! Time spent in numeric integration (seconds)
+
 
   virtual void operModeHook() ; // cache operation mode
 
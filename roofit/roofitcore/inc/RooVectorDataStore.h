@@ -75,6 +75,9 @@ public:
   virtual Double_t weight(Int_t index) const ;
   virtual Bool_t isWeighted() const { return (_wgtVar!=0||_extWgtArray!=0) ; }
 
+  // Direct access to the values of a column for a range of rows
+  const Double_t* getBatch(const RooAbsReal& real, Int_t first, Int_t nEvents) const ;
+
   // Change observable name
   virtual Bool_t changeObservableName(const char* from, const char* to) ;
   
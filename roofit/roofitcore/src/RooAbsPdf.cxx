@@ -311,6 +311,33 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of getValV(): fill output with the values of this p.d.f., normalized
+/// over the observables in normSet, for the events [first,first+nEvents) of the data store.
+/// The raw values are calculated by evaluateBatch() and divided by the normalization integral,
+/// which does not depend on the event. Return kFALSE if batch evaluation is not supported
+/// by this p.d.f. or by any of its inputs. No error checking is done on the values: callers
+/// should fall back to getVal() for events where the returned value is not positive
+
+Bool_t RooAbsPdf::getValBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  if (getValBatchFromData(output,first,nEvents,data,normSet)) return kTRUE ;
+
+  // Synchronize normalization first, evaluateBatch() may rely on _normSet being set
+  Double_t normVal = getNorm(normSet) ;
+  if (!evaluateBatch(output,first,nEvents,data,normSet)) return kFALSE ;
+
+  if (normVal!=1.) {
+    for (Int_t i=0 ; i<nEvents ; i++) {
+      output[i] /= normVal ;
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Analytical integral with normalization (see RooAbsReal::analyticalIntegralWN() for further information)
 ///
@@ -733,6 +760,8 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 ///                                                 do not share many parameters
 ///                                    Strategy 3 = RooFit::Hybrid --> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                                                 30 dataset entries, for which strategy 2 is followed.
+///                                    If implicit multi-threading is enabled (ROOT::EnableImplicitMT()), the N partitions are
+///                                    calculated by tasks of the ROOT thread pool instead of forked processes.
 ///
 /// Optimize(Bool_t flag)           -- Activate constant term optimization (on by default)
 /// SplitRange(Bool_t flag)         -- Use separate fit ranges in a simultaneous fit. Actual range name for each
@@ -996,6 +1025,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 ///                                                 do not share many parameters
 ///                                    Strategy 3 = RooFit::Hybrid --> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                                                 30 dataset entries, for which strategy 2 is followed.
+///                                    If implicit multi-threading is enabled (ROOT::EnableImplicitMT()), the N partitions are
+///                                    calculated by tasks of the ROOT thread pool instead of forked processes.
 ///
 /// SplitRange(Bool_t flag)         -- Use separate fit ranges in a simultaneous fit. Actual range name for each
 ///                                    subsample is assumed to by rangeName_{indexState} where indexState
@@ -102,7 +102,11 @@
 #include "TMatrixD.h"
 #include "TVector.h"
 
+#include "ThreadLocalStorage.h"
+
 #include <sstream>
+#include <algorithm>
+#include <mutex>
 
 using namespace std ;
 
@@ -120,6 +124,9 @@ RooAbsReal::ErrorLoggingMode RooAbsReal::_evalErrorMode = RooAbsReal::PrintError
 Int_t RooAbsReal::_evalErrorCount = 0 ;
 map<const RooAbsArg*,pair<string,list<RooAbsReal::EvalError> > > RooAbsReal::_evalErrorList ;
 
+// Protects the evaluation error log, which may be written by test statistics evaluated in parallel threads
+static std::mutex gEvalErrorMutex ;
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// coverity[UNINIT_CTOR]
@@ -264,6 +271,58 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of this function for the events [first,first+nEvents) of the
+/// given vector data store and write them in output. The normalization set is
+/// interpreted as in getVal(). Values of observables and of cached terms are taken
+/// directly from the columns of the store, functions that do not depend on the
+/// observables of the store are evaluated only once, all other functions are evaluated
+/// with evaluateBatch(). Return kFALSE if this function, or any of its inputs, does not
+/// support batch evaluation. In that case the contents of output are undefined and the
+/// caller should fall back to getVal() event by event.
+
+Bool_t RooAbsReal::getValBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  if (getValBatchFromData(output,first,nEvents,data,normSet)) return kTRUE ;
+  return evaluateBatch(output,first,nEvents,data,normSet) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill output with the values of this function for the events [first,first+nEvents)
+/// if they can be obtained without evaluating the function for each event: i.e. if this
+/// object is stored (as observable or cached term) in the data store, or if it does
+/// not depend on any of the observables of the store. Return kFALSE otherwise
+
+Bool_t RooAbsReal::getValBatchFromData(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  const Double_t* column = data.getBatch(*this,first,nEvents) ;
+  if (column) {
+    std::copy(column,column+nEvents,output) ;
+    return kTRUE ;
+  }
+
+  if (!dependsOnValue(*data.get())) {
+    std::fill(output,output+nEvents,getVal(normSet)) ;
+    return kTRUE ;
+  }
+
+  return kFALSE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the (unnormalized) values of this function for the events [first,first+nEvents)
+/// of the data store. Derived classes supporting batch evaluation should re-implement
+/// this function, obtaining the values of their inputs with getValBatch(), and return kTRUE.
+/// This default implementation returns kFALSE (batch evaluation not supported)
+
+Bool_t RooAbsReal::evaluateBatch(Double_t* /*output*/, Int_t /*first*/, Int_t /*nEvents*/, const RooVectorDataStore& /*data*/, const RooArgSet* /*normSet*/) const
+{
+  return kFALSE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooAbsReal::numEvalErrorItems()
@@ -3580,11 +3639,12 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
   }
 
   if (_evalErrorMode==CountErrors) {
+    std::lock_guard<std::mutex> lock(gEvalErrorMutex) ;
     _evalErrorCount++ ;
     return ;
   }
 
-  static Bool_t inLogEvalError = kFALSE ;
+  TTHREAD_TLS(Bool_t) inLogEvalError = kFALSE ;
 
   if (inLogEvalError) {
     return ;
@@ -3598,6 +3658,7 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     ee.setServerValues(serverValueString) ;
   }
 
+  std::lock_guard<std::mutex> lock(gEvalErrorMutex) ;
   if (_evalErrorMode==PrintErrors) {
    oocoutE((TObject*)0,Eval) << "RooAbsReal::logEvalError(" << "<STATIC>" << ") evaluation error, " << endl
 		   << " origin       : " << origName << endl
@@ -3635,11 +3696,12 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
   }
 
   if (_evalErrorMode==CountErrors) {
+    std::lock_guard<std::mutex> lock(gEvalErrorMutex) ;
     _evalErrorCount++ ;
     return ;
   }
 
-  static Bool_t inLogEvalError = kFALSE ;
+  TTHREAD_TLS(Bool_t) inLogEvalError = kFALSE ;
 
   if (inLogEvalError) {
     return ;
@@ -3672,6 +3734,7 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
   ostringstream oss2 ;
   printStream(oss2,kName|kClassName|kArgs,kInline)  ;
 
+  std::lock_guard<std::mutex> lock(gEvalErrorMutex) ;
   if (_evalErrorMode==PrintErrors) {
    coutE(Eval) << "RooAbsReal::logEvalError(" << GetName() << ") evaluation error, " << endl
 	       << " origin       : " << oss2.str() << endl
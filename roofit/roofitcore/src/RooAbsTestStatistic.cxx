@@ -31,7 +31,9 @@ statistic values for the PDF components of the simultaneous PDF and
 organizes multi-processor parallel calculation of test statistic
 values. For the latter, the test statistic value is calculated in
 partitions in parallel executing processes and a posteriori
-combined in the main thread.
+combined in the main thread. If implicit multi-threading is enabled
+(ROOT::EnableImplicitMT()), the partitions are instead evaluated by
+tasks of the ROOT thread pool within the same process.
 **/
 
 
@@ -44,6 +46,7 @@ combined in the main thread.
 #include "RooAbsData.h"
 #include "RooArgSet.h"
 #include "RooRealVar.h"
+#include "RooAbsCategoryLValue.h"
 #include "RooNLLVar.h"
 #include "RooRealMPFE.h"
 #include "RooErrorHandler.h"
@@ -51,7 +54,14 @@ combined in the main thread.
 #include "TTimeStamp.h"
 #include "RooProdPdf.h"
 #include "RooRealSumPdf.h"
+#include "RConfigure.h"
 #include <string>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 using namespace std;
 
@@ -64,7 +74,7 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
   _func(0), _data(0), _projDeps(0), _splitRange(0), _simCount(0),
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
   _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
-  _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
+  _mtSerialEval(kTRUE), _mtParamArray(0), _mtExecutor(0), _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
   _offsetCarry(0), _evalCarry(0)
 {
 }
@@ -102,6 +112,9 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
+  _mtSerialEval(kTRUE),
+  _mtParamArray(0),
+  _mtExecutor(0),
   _mpinterl(interleave),
   _doOffset(kFALSE),
   _offset(0),
@@ -119,7 +132,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
       _nCPU=1 ;
     }
 
-    _gofOpMode = MPMaster ;
+    _gofOpMode = useThreads() ? MTMaster : MPMaster ;
 
   } else {
 
@@ -161,6 +174,9 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofSplitMode(other._gofSplitMode),
   _nCPU(other._nCPU),
   _mpfeArray(0),
+  _mtSerialEval(kTRUE),
+  _mtParamArray(0),
+  _mtExecutor(0),
   _mpinterl(other._mpinterl),
   _doOffset(other._doOffset),
   _offset(other._offset),
@@ -176,7 +192,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
       _nCPU=1 ;
     }
       
-    _gofOpMode = MPMaster ;
+    _gofOpMode = useThreads() ? MTMaster : MPMaster ;
 
   } else {
 
@@ -211,11 +227,20 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _mpfeArray ;
   }
 
-  if (SimMaster == _gofOpMode && _init) {
+  if ((SimMaster == _gofOpMode || MTMaster == _gofOpMode) && _init) {
     for (Int_t i = 0; i < _nGof; ++i) delete _gofArray[i];
     delete[] _gofArray ;
   }
 
+  if (MTMaster == _gofOpMode && _init) {
+    for (Int_t i = 0; i < _nGof; ++i) delete _mtParamArray[i];
+    delete[] _mtParamArray ;
+  }
+
+#ifdef R__USE_IMT
+  delete _mtExecutor ;
+#endif
+
   delete _projDeps ;
 
 }
@@ -227,7 +252,8 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
 /// is calculated from on a RooSimultaneous, the test statistic calculation
 /// is performed separately on each simultaneous p.d.f component and associated
 /// data and then combined. If the test statistic calculation is parallelized
-/// partitions are calculated in nCPU processes and a posteriori combined.
+/// partitions are calculated in nCPU processes (or nCPU tasks of the ROOT thread
+/// pool if implicit multi-threading is enabled) and a posteriori combined.
 
 Double_t RooAbsTestStatistic::evaluate() const
 {
@@ -287,6 +313,45 @@ Double_t RooAbsTestStatistic::evaluate() const
     _evalCarry = carry;
     return ret ;
 
+  } else if (MTMaster == _gofOpMode) {
+
+    // Evaluate partitions in parallel. Each partition owns its clone of the function, of the data and
+    // of the parameters, which take the current parameter values before the partitions are dispatched
+    syncMTParameters() ;
+    std::vector<Double_t> vals(_nGof), carries(_nGof) ;
+    auto evalPartition = [&](UInt_t i) {
+      vals[i] = _gofArray[i]->getVal() ;
+      carries[i] = _gofArray[i]->getCarry() ;
+    } ;
+
+    // The first evaluation after (re)configuration is serial, as it may create and register
+    // normalization integrals and other cached objects in shared registries
+#ifdef R__USE_IMT
+    if (!_mtSerialEval && _nGof>1) {
+      if (!_mtExecutor) _mtExecutor = new ROOT::TThreadExecutor ;
+      _mtExecutor->Foreach(evalPartition, ROOT::TSeqU(_nGof)) ;
+    } else
+#endif
+    {
+      for (Int_t i = 0; i < _nGof; ++i) evalPartition(i) ;
+      _mtSerialEval = kFALSE ;
+    }
+
+    // Combine in fixed order, so that the result does not depend on the scheduling of the partitions
+    Double_t sum(0), carry = 0.;
+    for (Int_t i = 0; i < _nGof; ++i) {
+      Double_t y = vals[i];
+      carry += carries[i];
+      y -= carry;
+      const Double_t t = sum + y;
+      carry = (t - sum) - y;
+      sum = t;
+    }
+
+    Double_t ret = sum ;
+    _evalCarry = carry;
+    return ret ;
+
   } else {
 
     // Evaluate as straight FUNC
@@ -342,6 +407,8 @@ Bool_t RooAbsTestStatistic::initialize()
   
   if (MPMaster == _gofOpMode) {
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (MTMaster == _gofOpMode) {
+    initMTMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   }
@@ -356,13 +423,17 @@ Bool_t RooAbsTestStatistic::initialize()
 
 Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t)
 {
-  if (SimMaster == _gofOpMode && _gofArray) {
+  if ((SimMaster == _gofOpMode || MTMaster == _gofOpMode) && _gofArray) {
     // Forward to slaves
     for (Int_t i = 0; i < _nGof; ++i) {
       if (_gofArray[i]) {
 	_gofArray[i]->recursiveRedirectServers(newServerList,mustReplaceAll,nameChange);
       }
     }
+    // Thread partitions must not share the new servers: give them new clones of the parameters
+    if (MTMaster == _gofOpMode && _mtParamArray) {
+      initMTParameters() ;
+    }
   } else if (MPMaster == _gofOpMode&& _mpfeArray) {
     // Forward to slaves
     for (Int_t i = 0; i < _nCPU; ++i) {
@@ -383,7 +454,7 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
 
 void RooAbsTestStatistic::printCompactTreeHook(ostream& os, const char* indent)
 {
-  if (SimMaster == _gofOpMode) {
+  if (SimMaster == _gofOpMode || MTMaster == _gofOpMode) {
     // Forward to slaves
     os << indent << "RooAbsTestStatistic begin GOF contents" << endl ;
     for (Int_t i = 0; i < _nGof; ++i) {
@@ -421,6 +492,13 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
     }
+  } else if (MTMaster == _gofOpMode) {
+    // Constant term optimization depends on which parameters are constant
+    syncMTParameters() ;
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
+    _mtSerialEval = kTRUE ;
   }
 }
 
@@ -478,6 +556,96 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create nCPU component test statistics, each
+/// calculating one partition of the data with its own clone of the function, the data and the
+/// parameters, that are evaluated in parallel by tasks of the ROOT thread pool. As the partitioning
+/// only depends on nCPU, the result does not depend on the number of threads in the pool.
+
+void RooAbsTestStatistic::initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
+{
+  _nGof = _nCPU ;
+  _gofArray = new pRooAbsTestStatistic[_nGof];
+  _mtParamArray = new RooArgSet*[_nGof];
+
+  for (Int_t i = 0; i < _nGof; ++i) {
+    _gofArray[i] = create(Form("%s_GOF%d",GetName(),i),Form("%s_GOF%d",GetTitle(),i),*real,*data,*projDeps,rangeName,addCoefRangeName,1,_mpinterl,_verbose,_splitRange);
+    _gofArray[i]->setMPSet(i,_nGof);
+    _mtParamArray[i] = 0 ;
+  }
+  initMTParameters() ;
+  _mtSerialEval = kTRUE ;
+  coutI(Eval) << "RooAbsTestStatistic::initMTMode: created " << _nGof << " partitions for multi-threaded calculation" << endl;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Connect each thread partition to its own clones of the parameters of this test statistic.
+/// Partitions evaluated in different threads then never write to the same parameter objects
+/// (value caches and dirty flags of the leaves).
+
+void RooAbsTestStatistic::initMTParameters()
+{
+  for (Int_t i = 0; i < _nGof; ++i) {
+    RooArgSet* params = (RooArgSet*) _paramSet.snapshot(kFALSE) ;
+    _gofArray[i]->recursiveRedirectServers(*params) ;
+    delete _mtParamArray[i] ;
+    _mtParamArray[i] = params ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the values and constant flags of the parameters of this test statistic to the parameter
+/// clones of the thread partitions. Only clones whose value changed are set dirty, so that the
+/// caches of the partitions that do not depend on a changed parameter stay valid.
+
+void RooAbsTestStatistic::syncMTParameters() const
+{
+  for (Int_t i = 0; i < _nGof; ++i) {
+    RooFIter miter = _paramSet.fwdIterator() ;
+    RooFIter piter = _mtParamArray[i]->fwdIterator() ;
+    RooAbsArg *marg, *parg ;
+    while ((marg = miter.next()) && (parg = piter.next())) {
+      if (parg->isConstant() != marg->isConstant()) {
+        parg->setAttribute("Constant",marg->isConstant()) ;
+        parg->setValueDirty() ;
+        parg->setShapeDirty() ;
+      }
+      RooAbsRealLValue* preal = dynamic_cast<RooAbsRealLValue*>(parg) ;
+      if (preal) {
+        Double_t val = static_cast<RooAbsReal*>(marg)->getVal() ;
+        if (preal->getVal() != val) preal->setVal(val) ;
+        continue ;
+      }
+      RooAbsCategoryLValue* pcat = dynamic_cast<RooAbsCategoryLValue*>(parg) ;
+      if (pcat) {
+        Int_t idx = static_cast<RooAbsCategory*>(marg)->getIndex() ;
+        if (pcat->getIndex() != idx) pcat->setIndex(idx) ;
+      }
+    }
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if parallel calculation should use the ROOT thread pool
+/// rather than forked processes, i.e. if implicit multi-threading is enabled
+
+Bool_t RooAbsTestStatistic::useThreads()
+{
+#ifdef R__USE_IMT
+  return ROOT::IsImplicitMTEnabled() ;
+#else
+  return kFALSE ;
+#endif
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize simultaneous p.d.f processing mode. Strip simultaneous
 /// p.d.f into individual components, split dataset in subset
@@ -652,6 +820,13 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
       }
     }
     break;
+  case MTMaster:
+    // Each partition needs its own copy of the data
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->setData(indata, kTRUE);
+    }
+    _mtSerialEval = kTRUE;
+    break;
   case MPMaster:
     // Not supported
     coutF(DataHandling) << "RooAbsTestStatistic::setData(" << GetName() << ") FATAL: setData() is not supported in multi-processor mode" << endl;
@@ -693,6 +868,12 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
       _mpfeArray[i]->enableOffsetting(flag);
     }
     break;
+  case MTMaster:
+    _doOffset = flag;
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->enableOffsetting(flag);
+    }
+    break;
   }
 }
 
@@ -74,10 +74,12 @@ of each coefficient_i.
 #include "RooRecursiveFraction.h"
 #include "RooGlobalFunc.h"
 #include "RooRealIntegral.h"
+#include "RooVectorDataStore.h"
 #include "RooTrace.h"
 
 #include "Riostream.h"
 #include <algorithm>
+#include <vector>
 
 
 using namespace std;
@@ -860,6 +862,57 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): sum the batch values of the component p.d.f.s for the
+/// events [first,first+nEvents) of the data store. Only supported if the coefficients and
+/// the supplemental normalization terms do not depend on the observables of the store,
+/// as they are calculated once for the whole batch
+
+Bool_t RooAddPdf::evaluateBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  const RooArgSet* nset = normSet ;
+  if (nset==0 || nset->getSize()==0) {
+    if (_refCoefNorm.getSize()!=0) {
+      nset = &_refCoefNorm ;
+    }
+  }
+
+  const RooArgSet& obs = *data.get() ;
+  RooFIter ci = _coefList.fwdIterator() ;
+  RooAbsReal* coef ;
+  while((coef = (RooAbsReal*)ci.next())) {
+    if (coef->dependsOnValue(obs)) return kFALSE ;
+  }
+
+  CacheElem* cache = getProjCache(nset) ;
+  updateCoefficients(*cache,nset) ;
+
+  std::vector<Double_t> pdfVals(nEvents) ;
+  std::fill(output,output+nEvents,0.) ;
+
+  RooAbsPdf* pdf ;
+  Int_t i(0) ;
+  RooFIter pi = _pdfList.fwdIterator() ;
+  while((pdf = (RooAbsPdf*)pi.next())) {
+    if (pdf->isSelectedComp()) {
+      Double_t coefVal = _coefCache[i] ;
+      if (cache->_needSupNorm) {
+        RooAbsReal* snorm = (RooAbsReal*)cache->_suppNormList.at(i) ;
+        if (snorm->dependsOnValue(obs)) return kFALSE ;
+        coefVal /= snorm->getVal() ;
+      }
+      if (!pdf->getValBatch(&pdfVals[0],first,nEvents,data,nset)) return kFALSE ;
+      for (Int_t j=0 ; j<nEvents ; j++) {
+        output[j] += coefVal*pdfVals[j] ;
+      }
+    }
+    i++ ;
+  }
+
+  return kTRUE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset error counter to given value, limiting the number
 /// of future error messages for this pdf to 'resetValue'
@@ -43,6 +43,7 @@
 #include <iomanip>
 #include <fstream>
 #include <list>
+#include <mutex>
 #include "TClass.h"
 #include "RooErrorHandler.h"
 #include "RooArgSet.h"
@@ -77,11 +78,16 @@ struct POOLDATA
 
 static std::list<POOLDATA> _memPoolList ;
 
+// Protects the memory pools, as RooArgSets may be created and deleted by test statistic
+// partitions evaluated in parallel threads
+static std::mutex _memPoolMutex ;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Clear memoery pool on exit to avoid reported memory leaks
 
 void RooArgSet::cleanup()
 {
+  std::lock_guard<std::mutex> lock(_memPoolMutex) ;
   std::list<POOLDATA>::iterator iter = _memPoolList.begin() ;
   while(iter!=_memPoolList.end()) {
     free(iter->_base) ;
@@ -105,6 +111,8 @@ void* RooArgSet::operator new (size_t bytes)
 {
   //cout << " RooArgSet::operator new(" << bytes << ")" << endl ;
 
+  std::lock_guard<std::mutex> lock(_memPoolMutex) ;
+
   if (!_poolBegin || _poolCur+(sizeof(RooArgSet)) >= _poolEnd) {
 
     if (_poolBegin!=0) {
@@ -181,12 +189,15 @@ void* RooArgSet::operator new (size_t bytes, void* ptr) noexcept
 void RooArgSet::operator delete (void* ptr)
 {
   // Decrease use count in pool that ptr is on
+  std::unique_lock<std::mutex> lock(_memPoolMutex) ;
   for (std::list<POOLDATA>::iterator poolIter =  _memPoolList.begin() ; poolIter!=_memPoolList.end() ; ++poolIter) {
     if ((char*)ptr > (char*)poolIter->_base && (char*)ptr < (char*)poolIter->_base + POOLSIZE) {
       (*(Int_t*)(poolIter->_base))-- ;
       return ;
     }
   }
+  lock.unlock() ;
+
   // Not part of any pool; use global op delete:
   ::operator delete(ptr);
 }
@@ -43,6 +43,7 @@ In extended mode, a (Nexpect - Nobserved*log(NExpected) term is added
 #include "RooRealSumPdf.h"
 #include "RooRealVar.h"
 #include "RooProdPdf.h"
+#include "RooVectorDataStore.h"
 
 ClassImp(RooNLLVar);
 ;
@@ -96,6 +97,7 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
   _offsetCarrySaveW2 = 0.;
 
   _binnedPdf = 0 ;
+  _batchUnsupported = kFALSE ;
 }
 
 
@@ -110,7 +112,7 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
-  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
+  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.), _batchUnsupported(kFALSE)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
   // for a binned likelihood calculation
@@ -155,7 +157,7 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
-  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
+  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.), _batchUnsupported(kFALSE)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
   // for a binned likelihood calculation
@@ -196,7 +198,7 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   _weightSq(other._weightSq),
   _first(kTRUE), _offsetSaveW2(other._offsetSaveW2),
   _offsetCarrySaveW2(other._offsetCarrySaveW2),
-  _binw(other._binw) {
+  _binw(other._binw), _batchUnsupported(other._batchUnsupported) {
   _binnedPdf = other._binnedPdf ? (RooRealSumPdf*)_funcClone : 0 ;
 }
 
@@ -227,7 +229,7 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
   } else if ( _gofOpMode==MPMaster) {
     for (Int_t i=0 ; i<_nCPU ; i++)
       _mpfeArray[i]->applyNLLWeightSquared(flag);
-  } else if ( _gofOpMode==SimMaster) {
+  } else if ( _gofOpMode==SimMaster || _gofOpMode==MTMaster) {
     for (Int_t i=0 ; i<_nGof ; i++)
       ((RooNLLVar*)_gofArray[i])->applyWeightSquared(flag);
   }
@@ -235,6 +237,60 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add the unbinned likelihood terms of the events [firstEvent,lastEvent) to the Kahan
+/// sums 'result' and 'sumWeight', evaluating the p.d.f. for blocks of events at once with
+/// RooAbsReal::getValBatch(). Events for which the batch value is not positive are
+/// recalculated with getLogVal() to get the usual error handling. Return kFALSE, without
+/// touching the sums, if the data or the p.d.f. does not support batch evaluation
+
+Bool_t RooNLLVar::evaluateBatches(Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& carry, Double_t& sumWeight, Double_t& sumWeightCarry) const
+{
+  const RooVectorDataStore* store = dynamic_cast<const RooVectorDataStore*>(_dataClone->store()) ;
+  if (!store || _dataClone->isWeighted() || lastEvent<=firstEvent) return kFALSE ;
+
+  RooAbsPdf* pdfClone = (RooAbsPdf*) _funcClone ;
+  const Int_t batchSize = 1024 ;
+  std::vector<Double_t> vals(std::min(batchSize,lastEvent-firstEvent)) ;
+
+  Double_t res(result), resCarry(carry), sumW(sumWeight), sumWCarry(sumWeightCarry) ;
+  for (Int_t first=firstEvent ; first<lastEvent ; first+=batchSize) {
+    Int_t n = std::min(batchSize,lastEvent-first) ;
+    if (!pdfClone->getValBatch(&vals[0],first,n,*store,_normSet)) {
+      coutI(Eval) << "RooNLLVar::evaluateBatches(" << GetName() << ") p.d.f. " << pdfClone->GetName()
+                  << " does not support batch evaluation, using event-by-event evaluation" << std::endl ;
+      _batchUnsupported = kTRUE ;
+      return kFALSE ;
+    }
+
+    for (Int_t j=0 ; j<n ; j++) {
+      Double_t term ;
+      if (vals[j]>0 && !TMath::IsNaN(vals[j])) {
+        term = -log(vals[j]) ;
+      } else {
+        _dataClone->get(first+j) ;
+        term = -pdfClone->getLogVal(_normSet) ;
+      }
+
+      Double_t y = 1. - sumWCarry;
+      Double_t t = sumW + y;
+      sumWCarry = (t - sumW) - y;
+      sumW = t;
+
+      y = term - resCarry;
+      t = res + y;
+      resCarry = (t - res) - y;
+      res = t;
+    }
+  }
+
+  result = res ; carry = resCarry ;
+  sumWeight = sumW ; sumWeightCarry = sumWCarry ;
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate and return likelihood on subset of data from firstEvent to lastEvent
 /// processed with a step size of 'stepSize'. If this an extended likelihood and
@@ -306,7 +362,11 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
   } else {
 
-    for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
+    // Evaluate the pdf for blocks of events at once when the pdf and the data store support it
+    Bool_t batchDone = (stepSize==1 && !_batchUnsupported) ?
+      evaluateBatches(firstEvent,lastEvent,result,carry,sumWeight,sumWeightCarry) : kFALSE ;
+
+    for (i=firstEvent ; i<lastEvent && !batchDone ; i+=stepSize) {
 
       _dataClone->get(i) ;
 
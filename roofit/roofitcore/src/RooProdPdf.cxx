@@ -61,6 +61,7 @@ have to appear in any specific place in the list.
 #include <cstring>
 #include <sstream>
 #include <algorithm>
+#include <vector>
 
 #ifndef _WIN32
 #include <strings.h>
@@ -495,6 +496,47 @@ Double_t RooProdPdf::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): multiply the batch values of the partial terms
+/// for the events [first,first+nEvents) of the data store. Rearranged products
+/// are not supported in batch mode
+
+Bool_t RooProdPdf::evaluateBatch(Double_t* output, Int_t first, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  _curNormSet = (RooArgSet*)normSet ;
+
+  Int_t code ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  if (!cache) {
+    RooArgList *plist(0) ;
+    RooLinkedList *nlist(0) ;
+    getPartIntList(_curNormSet,0,plist,nlist,code) ;
+    cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  }
+  if (cache->_isRearranged) return kFALSE ;
+
+  std::vector<Double_t> partVals(nEvents) ;
+  std::fill(output,output+nEvents,1.) ;
+
+  RooAbsReal* partInt;
+  RooArgSet* nset;
+  RooFIter plIter = cache->_partList.fwdIterator();
+  RooFIter nlIter = cache->_normList.fwdIterator();
+  for (partInt = (RooAbsReal*) plIter.next(),
+	 nset = (RooArgSet*) nlIter.next(); partInt && nset;
+       partInt = (RooAbsReal*) plIter.next(),
+	 nset = (RooArgSet*) nlIter.next()) {
+    if (!partInt->getValBatch(&partVals[0],first,nEvents,data,nset->getSize() > 0 ? nset : 0)) return kFALSE ;
+    for (Int_t i=0 ; i<nEvents ; i++) {
+      output[i] *= partVals[i] ;
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate running product of pdfs terms, using the supplied
 /// normalization set in 'normSetList' for each component
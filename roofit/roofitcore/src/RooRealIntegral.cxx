@@ -36,9 +36,11 @@ integration is performed in the various implemenations of the RooAbsIntegrator b
 #include "TObjString.h"
 #include "TH1.h"
 #include "RooRealIntegral.h"
+#include "RooAbsPdf.h"
 #include "RooArgSet.h"
 #include "RooAbsRealLValue.h"
 #include "RooAbsCategoryLValue.h"
+#include "RooCategory.h"
 #include "RooRealBinding.h"
 #include "RooRealAnalytic.h"
 #include "RooInvTransform.h"
@@ -51,6 +53,8 @@ integration is performed in the various implemenations of the RooAbsIntegrator b
 #include "RooDouble.h"
 #include "RooTrace.h"
 
+#include <chrono>
+
 using namespace std;
 
 ClassImp(RooRealIntegral); 
@@ -58,6 +62,7 @@ ClassImp(RooRealIntegral);
 
 
 Int_t RooRealIntegral::_cacheAllNDim(2) ;
+Int_t RooRealIntegral::_valueCacheSize(16) ;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -74,7 +79,12 @@ RooRealIntegral::RooRealIntegral() :
   _numIntegrand(0),
   _rangeName(0),
   _params(0),
-  _cacheNum(kFALSE)
+  _cacheNum(kFALSE),
+  _cacheParams(0),
+  _cacheNormObs(0),
+  _nCacheHits(0),
+  _nCacheMisses(0),
+  _intTime(0)
 {
   _facListIter = _facList.createIterator() ;
   _jacListIter = _jacList.createIterator() ;
@@ -117,7 +127,12 @@ RooRealIntegral::RooRealIntegral(const char *name, const char *title,
   _numIntegrand(0),
   _rangeName((TNamed*)RooNameReg::ptr(rangeName)),
   _params(0),
-  _cacheNum(kFALSE)
+  _cacheNum(kFALSE),
+  _cacheParams(0),
+  _cacheNormObs(0),
+  _nCacheHits(0),
+  _nCacheMisses(0),
+  _intTime(0)
 {
   //   A) Check that all dependents are lvalues 
   //
@@ -773,7 +788,12 @@ RooRealIntegral::RooRealIntegral(const RooRealIntegral& other, const char* name)
   _numIntegrand(0),
   _rangeName(other._rangeName),
   _params(0),
-  _cacheNum(kFALSE)
+  _cacheNum(kFALSE),
+  _cacheParams(0),
+  _cacheNormObs(0),
+  _nCacheHits(0),
+  _nCacheMisses(0),
+  _intTime(0)
 {
  _funcNormSet = other._funcNormSet ? (RooArgSet*)other._funcNormSet->snapshot(kFALSE) : 0 ;
 
@@ -806,6 +826,8 @@ RooRealIntegral::~RooRealIntegral()
   delete _jacListIter ;
   if (_sumCatIter)  delete _sumCatIter ;
   if (_params) delete _params ;
+  delete _cacheParams ;
+  delete _cacheNormObs ;
 
   TRACE_DESTROY
 }
@@ -891,6 +913,17 @@ Double_t RooRealIntegral::evaluate() const
     
   case Hybrid: 
     {      
+      // Look up the value in the cache of recently calculated integrals
+      ValueCacheKey cacheKey ;
+      Bool_t useValueCache = _valueCacheSize>0 && valueCacheKey(cacheKey) ;
+      if (useValueCache) {
+	if (getCachedValue(cacheKey,retVal)) {
+	  _nCacheHits++ ;
+	  break ;
+	}
+	_nCacheMisses++ ;
+      }
+
       // Cache numeric integrals in >1d expensive object cache
       RooDouble* cacheVal(0) ;
       if ((_cacheNum && _intList.getSize()>0) || _intList.getSize()>=_cacheAllNDim) {
@@ -920,7 +953,9 @@ Double_t RooRealIntegral::evaluate() const
 	_saveSum = _sumList ;
 
 	// Evaluate sum/integral
+	auto start = std::chrono::steady_clock::now() ;
 	retVal = sum() ;
+	_intTime += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count() ;
 
 	// This must happen BEFORE restoring dependents, otherwise no dirty state propagation in restore step
 	setDirtyInhibit(origState) ;
@@ -937,6 +972,10 @@ Double_t RooRealIntegral::evaluate() const
 	}
 	
       }
+
+      if (useValueCache) {
+	cacheValue(cacheKey,retVal) ;
+      }
       break ;
     }
   case Analytic:
@@ -1090,6 +1129,13 @@ Bool_t RooRealIntegral::redirectServersHook(const RooAbsCollection& /*newServerL
     _params = 0 ;
   }
 
+  // Cached integral values may no longer be valid
+  delete _cacheParams ;
+  _cacheParams = 0 ;
+  delete _cacheNormObs ;
+  _cacheNormObs = 0 ;
+  _valueCache.clear() ;
+
   return kFALSE ;
 }
 
@@ -1116,6 +1162,130 @@ const RooArgSet& RooRealIntegral::parameters() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill 'key' with everything that determines the value of a numeric integral: the values
+/// of all leaf parameters of the integrand that are not integrated over, the integration
+/// limits of the numerically integrated observables, the limits of the observables the
+/// integrand is normalized over, the normalization range of the integrand and the
+/// integrator configuration. Return kFALSE if the integral cannot be cached because one of
+/// the parameters is neither real-valued nor a category
+
+Bool_t RooRealIntegral::valueCacheKey(ValueCacheKey& key) const
+{
+  if (!_cacheParams) {
+    _cacheParams = _function.arg().getParameters(intVars()) ;
+  }
+  if (!_cacheNormObs) {
+    _cacheNormObs = _funcNormSet ? _function.arg().getObservables(_funcNormSet) : new RooArgSet ;
+  }
+
+  const RooAbsPdf* pdf = dynamic_cast<const RooAbsPdf*>(&_function.arg()) ;
+  const char* normRange = pdf ? pdf->normRange() : 0 ;
+
+  key._config = _iconfig ;
+  key._intRange = _rangeName ;
+  key._normRange = RooNameReg::ptr(normRange) ;
+
+  std::vector<Double_t>& values = key._values ;
+  values.clear() ;
+  values.reserve(_cacheParams->getSize()+3*intVars().getSize()+2*_cacheNormObs->getSize()+8) ;
+
+  RooFIter iter = _cacheParams->fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    if (RooAbsReal* real = dynamic_cast<RooAbsReal*>(arg)) {
+      values.push_back(real->getVal()) ;
+    } else if (RooAbsCategory* cat = dynamic_cast<RooAbsCategory*>(arg)) {
+      values.push_back(cat->getIndex()) ;
+    } else {
+      return kFALSE ;
+    }
+  }
+
+  // The integral depends on the limits and binning in the integration range of all integrated
+  // observables, whether they are integrated numerically, analytically, summed or factorized
+  const char* rangeName = RooNameReg::str(_rangeName) ;
+  const RooArgSet* intLists[] = { &_intList, &_anaList, &_facList, &_sumList } ;
+  for (const RooArgSet* intList : intLists) {
+    iter = intList->fwdIterator() ;
+    while((arg=iter.next())) {
+      if (RooAbsRealLValue* lv = dynamic_cast<RooAbsRealLValue*>(arg)) {
+        values.push_back(lv->getMin(rangeName)) ;
+        values.push_back(lv->getMax(rangeName)) ;
+        values.push_back(lv->numBins(rangeName)) ;
+      } else if (RooCategory* cat = dynamic_cast<RooCategory*>(arg)) {
+        // Summation runs over the states in the named range
+        TIterator* titer = cat->typeIterator() ;
+        const RooCatType* type ;
+        while((type=(const RooCatType*)titer->Next())) {
+          values.push_back(cat->isStateInRange(rangeName,type->GetName()) ? type->getVal() : -1) ;
+        }
+        delete titer ;
+      } else if (RooAbsCategoryLValue* catlv = dynamic_cast<RooAbsCategoryLValue*>(arg)) {
+        values.push_back(catlv->numTypes(rangeName)) ;
+      } else {
+        return kFALSE ;
+      }
+    }
+  }
+
+  // The integrand's normalization integral runs over the normalization range of its observables
+  iter = _cacheNormObs->fwdIterator() ;
+  while((arg=iter.next())) {
+    if (RooAbsRealLValue* lv = dynamic_cast<RooAbsRealLValue*>(arg)) {
+      values.push_back(lv->getMin(normRange)) ;
+      values.push_back(lv->getMax(normRange)) ;
+    }
+  }
+
+  if (_iconfig) {
+    values.push_back(_iconfig->epsAbs()) ;
+    values.push_back(_iconfig->epsRel()) ;
+    values.push_back(_iconfig->method1D().getIndex()) ;
+    values.push_back(_iconfig->method2D().getIndex()) ;
+    values.push_back(_iconfig->methodND().getIndex()) ;
+    values.push_back(_iconfig->method1DOpen().getIndex()) ;
+    values.push_back(_iconfig->method2DOpen().getIndex()) ;
+    values.push_back(_iconfig->methodNDOpen().getIndex()) ;
+  }
+
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Retrieve the value of the integral calculated for the given key, if it is still in
+/// the value cache. The entry is moved to the front of the cache
+
+Bool_t RooRealIntegral::getCachedValue(const ValueCacheKey& key, Double_t& value) const
+{
+  for (ValueCache::iterator iter = _valueCache.begin() ; iter != _valueCache.end() ; ++iter) {
+    if (iter->first == key) {
+      value = iter->second ;
+      _valueCache.splice(_valueCache.begin(),_valueCache,iter) ;
+      return kTRUE ;
+    }
+  }
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the value of the integral calculated for the given key, dropping the least
+/// recently used entry if the cache is full
+
+void RooRealIntegral::cacheValue(const ValueCacheKey& key, Double_t value) const
+{
+  _valueCache.push_front(std::make_pair(key,value)) ;
+  while (Int_t(_valueCache.size()) > _valueCacheSize) {
+    _valueCache.pop_back() ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Dummy
 
@@ -1204,6 +1374,10 @@ void RooRealIntegral::printMultiline(ostream& os, Int_t contents, Bool_t verbose
     os << "<none>" ;
   
   os << endl ;
+  if (_intOperMode==Hybrid && (_intTime>0 || _nCacheHits+_nCacheMisses>0)) {
+    os << indent << "  Time spent in numeric integration " << _intTime << " s, value cache "
+       << _nCacheHits << " hits and " << _nCacheMisses << " misses (hit rate " << cacheHitRate() << ")" << endl ;
+  }
 } 
 
 
@@ -1225,3 +1399,23 @@ Int_t RooRealIntegral::getCacheAllNumeric()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Global switch to set the number of recently calculated values that each integral keeps,
+/// keyed on the values of its parameters, to avoid repeating numeric integrations when the
+/// parameters return to a previous point (e.g. in the numeric derivatives of MINUIT).
+/// A size of zero disables the cache
+
+void RooRealIntegral::setNumericValueCacheSize(Int_t size) {
+  _valueCacheSize = size ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of recently calculated values kept per integral
+
+Int_t RooRealIntegral::getNumericValueCacheSize() 
+{
+  return _valueCacheSize ;
+}
+
+
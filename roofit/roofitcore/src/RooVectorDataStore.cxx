@@ -482,6 +482,34 @@ Int_t RooVectorDataStore::fill()
  
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the stored values of the column holding 'real' (an
+/// observable, or a term cached by the constant term optimizer) for the
+/// rows [first,first+nEvents). A null pointer is returned if no such column
+/// exists in this store or its cache, or if the range is out of bounds.
+
+const Double_t* RooVectorDataStore::getBatch(const RooAbsReal& real, Int_t first, Int_t nEvents) const
+{
+  if (first<0 || nEvents<0 || first+nEvents>_nEntries) return 0 ;
+
+  for (Int_t i=0 ; i<_nReal ; i++) {
+    const RealVector* rv = *(_firstReal+i) ;
+    if (rv->_nativeReal && !strcmp(rv->_nativeReal->GetName(),real.GetName())) {
+      return rv->_vec0 ? rv->_vec0+first : 0 ;
+    }
+  }
+  for (Int_t i=0 ; i<_nRealF ; i++) {
+    const RealVector* rv = *(_firstRealF+i) ;
+    if (rv->_nativeReal && !strcmp(rv->_nativeReal->GetName(),real.GetName())) {
+      return rv->_vec0 ? rv->_vec0+first : 0 ;
+    }
+  }
+
+  return _cache ? _cache->getBatch(real,first,nEvents) : 0 ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Load the n-th data point (n='index') in memory
 /// and return a pointer to the internal RooArgSet
@@ -66,6 +66,12 @@
 //
 //  Additionally, if the environment ENABLE_TTREEPERFSTATS is set, then detailed
 //  statistics about IO performance will be reported.
+//  If the environment DISABLE_STREAMER_BLOCKS is set, the runs of numerical data
+//  members are streamed one by one instead of as one block (see
+//  TStreamerInfo::EnableBlockStreaming). Blocks are used for the objects streamed
+//  as a whole, i.e. with split = 0. To compare, time without compression:
+//     Event 400 0 0 1 ; Event 400 0 0 20
+//     DISABLE_STREAMER_BLOCKS=1 Event 400 0 0 1 ; DISABLE_STREAMER_BLOCKS=1 Event 400 0 0 20
 //
 //   ---Running/Linking instructions----
 //  This program consists of the following files and procedures.
@@ -100,6 +106,7 @@
 #include "TRandom.h"
 #include "TTree.h"
 #include "TTreePerfStats.h"
+#include "TStreamerInfo.h"
 #include "TBranch.h"
 #include "TClonesArray.h"
 #include "TStopwatch.h"
@@ -146,6 +153,7 @@ int main(int argc, char **argv)
    if (arg4 == 36) { write = 1; }            //netfile + write sequential
    Int_t branchStyle = 1; //new style by default
    if (split < 0) {branchStyle = 0; split = -1-split;}
+   if (getenv("DISABLE_STREAMER_BLOCKS")) TStreamerInfo::EnableBlockStreaming(kFALSE);
 
 #ifdef R__USE_IMT
    if (enable_imt) {
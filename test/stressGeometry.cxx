@@ -27,6 +27,8 @@
 //   stressGeometry
 // or  stressGeometry *
 // or  stressGeometry alice
+// or  stressGeometry alice bvh   (compare the bounding volume hierarchy finder with the
+//                                 voxels, then check the reference using the BVH)
 // or from the ROOT command line
 // root > .L stressGeometry.cxx  or .L stressGeometry.cxx+
 // root > stressGeometry(exp_name); // where exp_name is the geometry file name without .root
@@ -41,6 +43,8 @@
 #include "TGeoMedium.h"
 #include "TGeoMaterial.h"
 #include "TGeoBBox.h"
+#include "TGeoNavigator.h"
+#include "TGeoVolume.h"
 #include "TROOT.h"
 #include "TFile.h"
 #include "TTree.h"
@@ -58,25 +62,25 @@ Double_t tpstot = 0;
 Double_t tpsref = 112.1; //time including the generation of the ref files
 Bool_t testfailed = kFALSE;
 #ifndef __CINT__
-void stressGeometry(const char*, Bool_t, Bool_t);
+void stressGeometry(const char*, Bool_t, Bool_t, Bool_t);
 
 int main(int argc, char **argv)
 {
    gROOT->SetBatch();
    TApplication theApp("App", &argc, argv);
    Bool_t vecgeom = kFALSE;
+   Bool_t bvh = kFALSE;
    TString geom = "*";
-   if (argc > 1) geom = argv[1];
+   for (Int_t iarg=1; iarg<argc; ++iarg) {
+      if (!strcmp(argv[iarg], "vecgeom"))  vecgeom = kTRUE;
+      else if (!strcmp(argv[iarg], "bvh")) bvh = kTRUE;
+      else                                 geom = argv[iarg];
+   }
    geom.ToLower();
    if (geom == "all") geom = "*";
    printf("geom: %s\n", geom.Data());
 
-   if (argc > 1) {
-       for (Int_t iarg=1; iarg<argc; ++iarg) {
-          if (!strcmp(argv[iarg], "vecgeom")) vecgeom = kTRUE;
-       }
-   }
-   stressGeometry(geom,kFALSE,vecgeom);
+   stressGeometry(geom,kFALSE,vecgeom,bvh);
    return 0;
 }
 
@@ -235,9 +239,12 @@ Bool_t gen_ref=kFALSE;
 void FindRad(Double_t x, Double_t y, Double_t z,Double_t theta, Double_t phi, Int_t &nbound, Float_t &length, Float_t &safe, Float_t &rad, Bool_t verbose=kFALSE);
 void ReadRef(Int_t kexp);
 void WriteRef(Int_t kexp);
+void CheckBasketNavigation(Int_t kexp);
+void CheckBVH(Int_t kexp);
+void CheckStateCache(Int_t kexp);
 void InspectRef(const char *exp="alice", Int_t vers=3);
 
-void stressGeometry(const char *exp="*", Bool_t generate_ref=kFALSE, Bool_t vecgeom=kFALSE) {
+void stressGeometry(const char *exp="*", Bool_t generate_ref=kFALSE, Bool_t vecgeom=kFALSE, Bool_t bvh=kFALSE) {
    TGeoManager::SetVerboseLevel(0);
    gen_ref = generate_ref;
    gErrorIgnoreLevel = 10;
@@ -270,6 +277,8 @@ void stressGeometry(const char *exp="*", Bool_t generate_ref=kFALSE, Bool_t vecg
       TGeoManager::Import(Form("http://root.cern.ch/files/%s",fname.Data()));
       if (!gGeoManager) return;
       if (vecgeom) TVirtualGeoConverter::Instance()->ConvertGeometry();
+      // Compare the bounding volume hierarchy with the voxels, then keep it for the reference check
+      if (bvh) CheckBVH(i);
       
       fname = TString::Format("files/%s_ref_%d.root", exps[i],versions[i]);
 
@@ -280,6 +289,8 @@ void stressGeometry(const char *exp="*", Bool_t generate_ref=kFALSE, Bool_t vecg
       }
 
       ReadRef(i);
+      CheckBasketNavigation(i);
+      CheckStateCache(i);
    }
    if (all && tpstot>0) {
       Float_t rootmarks = 800*tpsref/tpstot;
@@ -536,6 +547,261 @@ void FindRad(Double_t x, Double_t y, Double_t z,Double_t theta, Double_t phi, In
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compare the basket navigation queries TGeoNavigator::FindNextBoundaryN and
+/// SafetyN with the scalar FindNextBoundary and with the scalar shape methods.
+/// Baskets of tracks around random points are located in the deepest volume,
+/// with random directions. Volumes with overlapping daughters or assemblies are
+/// skipped, since the basket methods do not handle them.
+
+void CheckBasketNavigation(Int_t kexp) {
+   const Int_t kNpoints = 2000;
+   const Int_t kNtracks = 16;
+   TRandom3 r(kexp+1);
+   TGeoNavigator *nav = gGeoManager->GetCurrentNavigator();
+   TGeoShape *top = gGeoManager->GetMasterVolume()->GetShape();
+   Double_t x[kNtracks], y[kNtracks], z[kNtracks], dx[kNtracks], dy[kNtracks], dz[kNtracks];
+   Double_t steps[kNtracks], safe[kNtracks];
+   Int_t idaughter[kNtracks];
+   Double_t point[3], dir[3], local[3], dlocal[3];
+   Int_t nbad = 0, nchecked = 0;
+   for (Int_t ipoint=0; ipoint<kNpoints; ipoint++) {
+      point[0] = r.Uniform(-boxes[kexp][0],boxes[kexp][0]);
+      point[1] = r.Uniform(-boxes[kexp][1],boxes[kexp][1]);
+      point[2] = r.Uniform(-boxes[kexp][2],boxes[kexp][2]);
+      if (!top->Contains(point)) continue;
+      TGeoNode *node = nav->FindNode(point[0],point[1],point[2]);
+      if (!node || nav->IsOutside() || node->IsOverlapping()) continue;
+      TGeoVolume *vol = node->GetVolume();
+      if (vol->IsAssembly()) continue;
+      Int_t nd = vol->GetNdaughters();
+      Bool_t skip = kFALSE;
+      for (Int_t id=0; id<nd; id++) {
+         TGeoNode *daughter = vol->GetNode(id);
+         if (daughter->IsOverlapping() || daughter->GetVolume()->IsAssembly()) skip = kTRUE;
+      }
+      if (skip) continue;
+      // Stay within the safety of the point, so that all tracks are in the same node
+      Double_t s0 = nav->Safety();
+      if (s0 < 1.E-6) continue;
+      TGeoHMatrix mat(*nav->GetCurrentMatrix());
+      for (Int_t i=0; i<kNtracks; i++) {
+         Double_t rr = 0.5*s0*r.Rndm();
+         Double_t phi = 2*TMath::Pi()*r.Rndm();
+         Double_t theta = TMath::ACos(1.-2.*r.Rndm());
+         x[i] = point[0] + rr*TMath::Sin(theta)*TMath::Cos(phi);
+         y[i] = point[1] + rr*TMath::Sin(theta)*TMath::Sin(phi);
+         z[i] = point[2] + rr*TMath::Cos(theta);
+         phi = 2*TMath::Pi()*r.Rndm();
+         theta = TMath::ACos(1.-2.*r.Rndm());
+         dx[i] = TMath::Sin(theta)*TMath::Cos(phi);
+         dy[i] = TMath::Sin(theta)*TMath::Sin(phi);
+         dz[i] = TMath::Cos(theta);
+      }
+      nav->FindNextBoundaryN(kNtracks, x, y, z, dx, dy, dz, steps, idaughter);
+      nav->SafetyN(kNtracks, x, y, z, safe);
+      nchecked++;
+      for (Int_t i=0; i<kNtracks; i++) {
+         Bool_t bad = kFALSE;
+         // Safety: minimum of the scalar shape safeties of the volume and its daughters
+         Double_t master[3] = {x[i], y[i], z[i]};
+         mat.MasterToLocal(master, local);
+         Double_t ref = vol->GetShape()->Safety(local, kTRUE);
+         for (Int_t id=0; id<nd; id++) {
+            TGeoNode *daughter = vol->GetNode(id);
+            daughter->GetMatrix()->MasterToLocal(local, dlocal);
+            ref = TMath::Min(ref, daughter->GetVolume()->GetShape()->Safety(dlocal, kFALSE));
+         }
+         if (TMath::Abs(safe[i]-ref) > 1.E-10*(1.+ref)) bad = kTRUE;
+         // Distance to the next boundary from the scalar navigation
+         dir[0] = dx[i]; dir[1] = dy[i]; dir[2] = dz[i];
+         nav->InitTrack(master, dir);
+         if (nav->GetCurrentNode() == node) {
+            nav->FindNextBoundary();
+            Double_t step = nav->GetStep();
+            if (TMath::Abs(steps[i]-step) > 1.E-8*(1.+step)) bad = kTRUE;
+            if (safe[i] > steps[i]+1.E-8) bad = kTRUE;
+         }
+         if (bad) {
+            nbad++;
+            if (nbad < 10) {
+               fprintf(stderr," ==>Basket track in %s differs, x=%g, y=%g, z=%g, dx=%g, dy=%g, dz=%g\n",
+                       nav->GetPath(),x[i],y[i],z[i],dx[i],dy[i],dz[i]);
+               fprintf(stderr,"    stepN=%g (daughter %d), safetyN=%g, scalar safety=%g\n",
+                       steps[i],idaughter[i],safe[i],ref);
+            }
+         }
+      }
+   }
+   if (nbad) testfailed = kTRUE;
+   if (nbad > 0) fprintf(stderr,"*     basket %-15s  found %5d bad tracks ............. failed\n",exps[kexp],nbad);
+   else          fprintf(stderr,"*     basket %-15s: %5d baskets checked ................ OK\n",exps[kexp],nchecked);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Switch all voxelized volumes between voxels and bounding volume hierarchies.
+
+void UseBVH(Bool_t flag) {
+   TIter next(gGeoManager->GetListOfVolumes());
+   TGeoVolume *vol;
+   while ((vol = (TGeoVolume*)next())) {
+      if (!vol->GetVoxels() || vol->IsUsingBVH() == flag) continue;
+      vol->SetUseBVH(flag);
+      vol->Voxelize("");
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Locate random points and take one step from each of them along a random
+/// direction. Fill the path of the starting node, the step and the path of the
+/// node entered.
+
+void NavigatePoints(Int_t npoints, const Double_t *points, const Double_t *dirs,
+                    TString *path, Double_t *step, TString *nextpath) {
+   TGeoNavigator *nav = gGeoManager->GetCurrentNavigator();
+   for (Int_t i=0; i<npoints; i++) {
+      nav->InitTrack(&points[3*i], &dirs[3*i]);
+      path[i] = nav->GetPath();
+      nav->FindNextBoundaryAndStep();
+      step[i] = nav->GetStep();
+      nextpath[i] = nav->IsOutside() ? "outside" : nav->GetPath();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compare FindNode and FindNextBoundary with the bounding volume hierarchy
+/// finder (TGeoVolume::SetUseBVH) against the voxels. The BVH is left enabled.
+
+void CheckBVH(Int_t kexp) {
+   const Int_t kNpoints = 10000;
+   TRandom3 r(kexp+1);
+   TGeoShape *top = gGeoManager->GetMasterVolume()->GetShape();
+   Double_t *points = new Double_t[3*kNpoints];
+   Double_t *dirs = new Double_t[3*kNpoints];
+   Int_t i = 0;
+   while (i<kNpoints) {
+      Double_t *pt = &points[3*i];
+      pt[0] = r.Uniform(-boxes[kexp][0],boxes[kexp][0]);
+      pt[1] = r.Uniform(-boxes[kexp][1],boxes[kexp][1]);
+      pt[2] = r.Uniform(-boxes[kexp][2],boxes[kexp][2]);
+      if (!top->Contains(pt)) continue;
+      Double_t phi = 2*TMath::Pi()*r.Rndm();
+      Double_t theta = TMath::ACos(1.-2.*r.Rndm());
+      dirs[3*i]   = TMath::Sin(theta)*TMath::Cos(phi);
+      dirs[3*i+1] = TMath::Sin(theta)*TMath::Sin(phi);
+      dirs[3*i+2] = TMath::Cos(theta);
+      i++;
+   }
+
+   TString *path = new TString[kNpoints], *nextpath = new TString[kNpoints];
+   TString *bvhpath = new TString[kNpoints], *bvhnextpath = new TString[kNpoints];
+   Double_t *step = new Double_t[kNpoints], *bvhstep = new Double_t[kNpoints];
+   UseBVH(kFALSE);
+   TStopwatch sw;
+   NavigatePoints(kNpoints, points, dirs, path, step, nextpath);
+   Double_t cpvox = sw.CpuTime();
+   UseBVH(kTRUE);
+   sw.Start();
+   NavigatePoints(kNpoints, points, dirs, bvhpath, bvhstep, bvhnextpath);
+   Double_t cpbvh = sw.CpuTime();
+
+   Int_t nbad = 0;
+   for (i=0; i<kNpoints; i++) {
+      if (path[i] == bvhpath[i] && nextpath[i] == bvhnextpath[i] &&
+          TMath::Abs(step[i]-bvhstep[i]) <= 1.E-9*(1.+step[i])) continue;
+      nbad++;
+      if (nbad < 10) {
+         fprintf(stderr," ==>Point %d differs with BVH, x=%g, y=%g, z=%g\n",i,points[3*i],points[3*i+1],points[3*i+2]);
+         fprintf(stderr,"    voxels: %s step=%g -> %s\n",path[i].Data(),step[i],nextpath[i].Data());
+         fprintf(stderr,"    BVH:    %s step=%g -> %s\n",bvhpath[i].Data(),bvhstep[i],bvhnextpath[i].Data());
+      }
+   }
+   delete [] points; delete [] dirs;
+   delete [] path; delete [] nextpath; delete [] bvhpath; delete [] bvhnextpath;
+   delete [] step; delete [] bvhstep;
+
+   if (nbad) testfailed = kTRUE;
+   if (nbad > 0) fprintf(stderr,"*     bvh    %-15s  found %5d bad points ............. failed\n",exps[kexp],nbad);
+   else          fprintf(stderr,"*     bvh    %-15s: time bvh/voxels = %6.2f/%6.2f..... OK\n",exps[kexp],cpbvh,cpvox);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the safety at clusters of close points, first without and then with
+/// the state cache of the navigator (TGeoNavigator::SetStateCache). A cached
+/// safety must never exceed the computed one, and the points close to the first
+/// one of each cluster must be served from the cache.
+
+void CheckStateCache(Int_t kexp) {
+   const Int_t kNclusters = 2000;
+   const Int_t kNpoints = 8;     // points per cluster, the first one is the seed
+   TRandom3 r(kexp+1);
+   TGeoNavigator *nav = gGeoManager->GetCurrentNavigator();
+   TGeoShape *top = gGeoManager->GetMasterVolume()->GetShape();
+   Double_t *points = new Double_t[3*kNclusters*kNpoints];
+   Int_t npoints = 0;
+   Double_t point[3];
+   while (npoints < kNclusters*kNpoints) {
+      point[0] = r.Uniform(-boxes[kexp][0],boxes[kexp][0]);
+      point[1] = r.Uniform(-boxes[kexp][1],boxes[kexp][1]);
+      point[2] = r.Uniform(-boxes[kexp][2],boxes[kexp][2]);
+      if (!top->Contains(point)) continue;
+      nav->FindNode(point[0],point[1],point[2]);
+      if (nav->IsOutside()) continue;
+      Double_t s0 = nav->Safety();
+      if (s0 < 1.E-6) continue;
+      Double_t *pt = &points[3*npoints];
+      pt[0] = point[0]; pt[1] = point[1]; pt[2] = point[2];
+      // The other points of the cluster are within the reuse distance of the seed
+      for (Int_t i=1; i<kNpoints; i++) {
+         Double_t rr = 0.4*s0*r.Rndm();
+         Double_t phi = 2*TMath::Pi()*r.Rndm();
+         Double_t theta = TMath::ACos(1.-2.*r.Rndm());
+         pt += 3;
+         pt[0] = point[0] + rr*TMath::Sin(theta)*TMath::Cos(phi);
+         pt[1] = point[1] + rr*TMath::Sin(theta)*TMath::Sin(phi);
+         pt[2] = point[2] + rr*TMath::Cos(theta);
+      }
+      npoints += kNpoints;
+   }
+
+   Double_t *safe = new Double_t[npoints], *cached = new Double_t[npoints];
+   Int_t i;
+   for (i=0; i<npoints; i++) {
+      nav->FindNode(points[3*i],points[3*i+1],points[3*i+2]);
+      safe[i] = nav->Safety();
+   }
+   nav->SetStateCache(kTRUE);
+   for (i=0; i<npoints; i++) {
+      nav->FindNode(points[3*i],points[3*i+1],points[3*i+2]);
+      cached[i] = nav->Safety();
+   }
+   TGeoTouchableCache *cache = nav->GetStateCache();
+   Long64_t nlookups = cache->GetNlookups();
+   Long64_t nhits = cache->GetNhits();
+   Long64_t nstores = cache->GetNstores();
+   nav->SetStateCache(kFALSE);
+
+   Int_t nbad = 0;
+   for (i=0; i<npoints; i++) {
+      if (cached[i] <= safe[i] + 1.E-10*(1.+safe[i])) continue;
+      nbad++;
+      if (nbad < 10)
+         fprintf(stderr," ==>Cached safety too large, x=%g, y=%g, z=%g: cached=%g computed=%g\n",
+                 points[3*i],points[3*i+1],points[3*i+2],cached[i],safe[i]);
+   }
+   // Every seed misses and stores, most of the other points hit
+   if (nhits == 0 || nlookups == nhits || nstores == 0) {
+      nbad++;
+      fprintf(stderr," ==>State cache statistics not updated: lookups=%lld hits=%lld stores=%lld\n",
+              nlookups, nhits, nstores);
+   }
+   delete [] points; delete [] safe; delete [] cached;
+
+   if (nbad) testfailed = kTRUE;
+   if (nbad > 0) fprintf(stderr,"*     cache  %-15s  found %5d bad points ............. failed\n",exps[kexp],nbad);
+   else          fprintf(stderr,"*     cache  %-15s: hits/lookups = %6lld/%6lld......... OK\n",exps[kexp],nhits,nlookups);
+}
+
 void InspectDiff(const char* exp="alice",Long64_t ientry=-1) {
    Int_t nbound = 0;
    Float_t length = 0.;
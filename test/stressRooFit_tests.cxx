@@ -6444,3 +6444,371 @@ public:
   }
 } ;
 
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE' RooFit regression test
+//
+// Batch evaluation of the unbinned likelihood on vector stores
+// must agree with event-by-event evaluation on tree stores
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooAddPdf.h"
+#include "RooFitResult.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic901 : public RooUnitTest
+{
+public:
+  TestBasic901(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Batch vs event-by-event likelihood",refFile,writeRef,verbose) {} ;
+
+  Bool_t sameValue(Double_t a, Double_t b, Double_t tol) {
+    return TMath::Abs(a-b) <= tol*TMath::Max(1.,TMath::Abs(a)+TMath::Abs(b)) ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l   a n d   d a t a
+  // -------------------------------------------
+
+  RooRealVar x("x","x",0,10) ;
+  RooRealVar mean("mean","mean",5,0,10) ;
+  RooRealVar sigma("sigma","sigma",0.5,0.1,2) ;
+  RooGaussian gauss("gauss","gauss",x,mean,sigma) ;
+  RooRealVar lambda("lambda","lambda",-0.3,-2.,0.) ;
+  RooExponential bkg("bkg","bkg",x,lambda) ;
+  RooRealVar fsig("fsig","fsig",0.3,0.,1.) ;
+  RooAddPdf model("model","model",RooArgList(gauss,bkg),fsig) ;
+
+  // Vector store data is evaluated in batches, tree store data event by event
+  RooDataSet* dataVec = model.generate(x,10000) ;
+  dataVec->convertToVectorStore() ;
+  RooDataSet dataTree(*dataVec,"dataTree") ;
+  dataTree.convertToTreeStore() ;
+
+  // C o m p a r e   l i k e l i h o o d   v a l u e s
+  // ---------------------------------------------------
+
+  RooAbsReal* nllVec = model.createNLL(*dataVec) ;
+  RooAbsReal* nllTree = model.createNLL(dataTree) ;
+
+  Bool_t ok = kTRUE ;
+  const Double_t means[] = { 3., 5., 6.5 } ;
+  for (Int_t i=0 ; i<3 ; i++) {
+    mean.setVal(means[i]) ;
+    sigma.setVal(0.4+0.3*i) ;
+    if (!sameValue(nllVec->getVal(),nllTree->getVal(),1e-9)) {
+      cout << "TestBasic901: NLL differs at mean=" << means[i] << ": batch " << nllVec->getVal()
+           << " event-by-event " << nllTree->getVal() << endl ;
+      ok = kFALSE ;
+    }
+  }
+  delete nllVec ;
+  delete nllTree ;
+
+  // C o m p a r e   f i t   r e s u l t s
+  // ---------------------------------------
+
+  RooArgSet params(mean,sigma,lambda,fsig) ;
+  RooArgSet* initParams = (RooArgSet*) params.snapshot() ;
+
+  RooFitResult* rVec = model.fitTo(*dataVec,Save(),PrintLevel(-1)) ;
+  params = *initParams ;
+  RooFitResult* rTree = model.fitTo(dataTree,Save(),PrintLevel(-1)) ;
+
+  if (!sameValue(rVec->minNll(),rTree->minNll(),1e-9)) {
+    cout << "TestBasic901: minimum NLL differs: batch " << rVec->minNll() << " event-by-event " << rTree->minNll() << endl ;
+    ok = kFALSE ;
+  }
+  for (Int_t i=0 ; i<rVec->floatParsFinal().getSize() ; i++) {
+    RooRealVar* pv = (RooRealVar*) rVec->floatParsFinal().at(i) ;
+    RooRealVar* pt = (RooRealVar*) rTree->floatParsFinal().at(i) ;
+    if (!sameValue(pv->getVal(),pt->getVal(),1e-5)) {
+      cout << "TestBasic901: fitted " << pv->GetName() << " differs: batch " << pv->getVal()
+           << " event-by-event " << pt->getVal() << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+  delete rVec ;
+  delete rTree ;
+  delete initParams ;
+  delete dataVec ;
+
+  return ok ;
+  }
+} ;
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE' RooFit regression test
+//
+// Likelihoods evaluated in partitions on the implicit multi-threading
+// pool must agree with the serial likelihood for 1, 2 and 4 threads
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RConfigure.h"
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooAddPdf.h"
+#include "RooFitResult.h"
+#include "TMath.h"
+#include "TROOT.h"
+
+using namespace RooFit ;
+
+
+class TestBasic902 : public RooUnitTest
+{
+public:
+  TestBasic902(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Multi-threaded likelihood",refFile,writeRef,verbose) {} ;
+
+#ifdef R__USE_IMT
+  Bool_t isTestAvailable() { return kTRUE ; }
+#else
+  Bool_t isTestAvailable() { return kFALSE ; }
+#endif
+
+  Bool_t sameValue(Double_t a, Double_t b, Double_t tol) {
+    return TMath::Abs(a-b) <= tol*TMath::Max(1.,TMath::Abs(a)+TMath::Abs(b)) ;
+  }
+
+  Bool_t testCode() {
+
+#ifdef R__USE_IMT
+
+  // C r e a t e   m o d e l   a n d   d a t a
+  // -------------------------------------------
+
+  RooRealVar x("x","x",0,10) ;
+  RooRealVar mean("mean","mean",5,0,10) ;
+  RooRealVar sigma("sigma","sigma",0.5,0.1,2) ;
+  RooGaussian gauss("gauss","gauss",x,mean,sigma) ;
+  RooRealVar lambda("lambda","lambda",-0.3,-2.,0.) ;
+  RooExponential bkg("bkg","bkg",x,lambda) ;
+  RooRealVar fsig("fsig","fsig",0.3,0.,1.) ;
+  RooAddPdf model("model","model",RooArgList(gauss,bkg),fsig) ;
+
+  RooDataSet* data = model.generate(x,10000) ;
+
+  RooArgSet params(mean,sigma,lambda,fsig) ;
+  RooArgSet* initParams = (RooArgSet*) params.snapshot() ;
+
+  // E v a l u a t e   a n d   f i t   w i t h   1 ,   2   a n d   4   t h r e a d s
+  // -----------------------------------------------------------------------------------
+
+  ROOT::EnableImplicitMT(4) ;
+
+  const Int_t nThreads[] = { 1, 2, 4 } ;
+  Double_t nllVal[3] ;
+  RooFitResult* result[3] ;
+  for (Int_t i=0 ; i<3 ; i++) {
+    params = *initParams ;
+    RooAbsReal* nll = model.createNLL(*data,NumCPU(nThreads[i])) ;
+    // The first evaluation initializes the partitions serially, the second one runs on the pool
+    nll->getVal() ;
+    mean.setVal(4.8) ;
+    nllVal[i] = nll->getVal() ;
+    delete nll ;
+
+    params = *initParams ;
+    result[i] = model.fitTo(*data,NumCPU(nThreads[i]),Save(),PrintLevel(-1)) ;
+  }
+
+  ROOT::DisableImplicitMT() ;
+
+  // C o m p a r e   t o   t h e   s i n g l e   t h r e a d   r e s u l t
+  // -----------------------------------------------------------------------
+
+  Bool_t ok = kTRUE ;
+  for (Int_t i=1 ; i<3 ; i++) {
+    if (!sameValue(nllVal[i],nllVal[0],1e-12)) {
+      cout << "TestBasic902: NLL with " << nThreads[i] << " threads " << nllVal[i] << " differs from " << nllVal[0] << endl ;
+      ok = kFALSE ;
+    }
+    if (result[i]->status()!=result[0]->status() || !sameValue(result[i]->minNll(),result[0]->minNll(),1e-10)) {
+      cout << "TestBasic902: fit with " << nThreads[i] << " threads converged to " << result[i]->minNll()
+           << " (status " << result[i]->status() << ") instead of " << result[0]->minNll() << endl ;
+      ok = kFALSE ;
+    }
+    for (Int_t j=0 ; j<result[0]->floatParsFinal().getSize() ; j++) {
+      RooRealVar* p0 = (RooRealVar*) result[0]->floatParsFinal().at(j) ;
+      RooRealVar* pi = (RooRealVar*) result[i]->floatParsFinal().at(j) ;
+      if (!sameValue(pi->getVal(),p0->getVal(),1e-6) || !sameValue(pi->getError(),p0->getError(),1e-4)) {
+        cout << "TestBasic902: fitted " << p0->GetName() << " with " << nThreads[i] << " threads " << pi->getVal()
+             << " +/- " << pi->getError() << " differs from " << p0->getVal() << " +/- " << p0->getError() << endl ;
+        ok = kFALSE ;
+      }
+    }
+  }
+
+  for (Int_t i=0 ; i<3 ; i++) delete result[i] ;
+  delete initParams ;
+  delete data ;
+
+  return ok ;
+
+#else
+  return kTRUE ;
+#endif
+  }
+} ;
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE' RooFit regression test
+//
+// The value cache of numeric integrals must return stored values only
+// for the same parameters, integration range and integrator settings
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooFormulaVar.h"
+#include "RooGaussian.h"
+#include "RooRealIntegral.h"
+#include "RooNumIntConfig.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic903 : public RooUnitTest
+{
+public:
+  TestBasic903(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Numeric integral value cache",refFile,writeRef,verbose) {} ;
+
+  Bool_t check(const char* what, Bool_t ok) {
+    if (!ok) cout << "TestBasic903: " << what << " failed" << endl ;
+    return ok ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   n u m e r i c   i n t e g r a l
+  // -----------------------------------------------
+
+  RooRealVar x("x","x",-3,3) ;
+  RooRealVar a("a","a",1,0.1,10) ;
+  RooFormulaVar f("f","f","exp(-a*x*x)",RooArgList(x,a)) ;
+
+  // Integrate with a configuration specific to f, so that it can be modified below
+  RooNumIntConfig* cfg = f.specialIntegratorConfig(kTRUE) ;
+  RooAbsReal* intF = f.createIntegral(x) ;
+  RooRealIntegral* integral = dynamic_cast<RooRealIntegral*>(intF) ;
+  if (!integral) {
+    cout << "TestBasic903: integral of f is not a RooRealIntegral" << endl ;
+    delete intF ;
+    return kFALSE ;
+  }
+
+  Int_t origSize = RooRealIntegral::getNumericValueCacheSize() ;
+  RooRealIntegral::setNumericValueCacheSize(16) ;
+  Bool_t ok = kTRUE ;
+
+  // H i t s   a n d   m i s s e s   f o r   p a r a m e t e r   c h a n g e s
+  // ---------------------------------------------------------------------------
+
+  Double_t val1 = integral->getVal() ;
+  a.setVal(2) ;
+  Double_t val2 = integral->getVal() ;
+  ok &= check("miss count for new parameters",integral->numCacheHits()==0 && integral->numCacheMisses()==2) ;
+  ok &= check("integral value",TMath::Abs(val1-TMath::Sqrt(TMath::Pi())*TMath::Erf(3))<1e-6) ;
+
+  a.setVal(1) ;
+  ok &= check("value from cache",integral->getVal()==val1) ;
+  ok &= check("hit count for known parameters",integral->numCacheHits()==1 && integral->numCacheMisses()==2) ;
+
+  // C h a n g e   o f   i n t e g r a t i o n   r a n g e
+  // -------------------------------------------------------
+
+  x.setRange(-1,1) ;
+  Double_t val3 = integral->getVal() ;
+  ok &= check("recalculation for new range",integral->numCacheHits()==1 && integral->numCacheMisses()==3) ;
+  ok &= check("value for new range",TMath::Abs(val3-TMath::Sqrt(TMath::Pi())*TMath::Erf(1))<1e-6) ;
+
+  x.setRange(-3,3) ;
+  ok &= check("value for restored range",integral->getVal()==val1) ;
+  ok &= check("hit count for restored range",integral->numCacheHits()==2 && integral->numCacheMisses()==3) ;
+
+  // C h a n g e   o f   i n t e g r a t o r   c o n f i g u r a t i o n
+  // ---------------------------------------------------------------------
+
+  // Changing the configuration does not make the integral dirty, move a away and back again
+  cfg->setEpsRel(1e-9) ;
+  a.setVal(2) ;
+  integral->getVal() ;
+  a.setVal(1) ;
+  Double_t val4 = integral->getVal() ;
+  ok &= check("recalculation for new integrator precision",integral->numCacheHits()==2 && integral->numCacheMisses()==5) ;
+  ok &= check("value for new integrator precision",TMath::Abs(val4-val1)<1e-6) ;
+
+  // C h a n g e   o f   a n a l y t i c   i n t e g r a t i o n   r a n g e
+  // -------------------------------------------------------------------------
+
+  // Integrate y analytically and x numerically
+  RooRealVar y("y","y",-5,5) ;
+  RooFormulaVar m("m","m","sin(x)",RooArgList(x)) ;
+  RooRealVar s("s","s",1) ;
+  RooGaussian g("g","g",y,m,s) ;
+  RooAbsReal* intG = g.createIntegral(RooArgSet(x,y)) ;
+  RooRealIntegral* hybrid = dynamic_cast<RooRealIntegral*>(intG) ;
+  if (!check("hybrid integral",hybrid && hybrid->anaIntVars().find("y") && hybrid->numIntRealVars().find("x"))) {
+    delete intG ;
+    delete intF ;
+    RooRealIntegral::setNumericValueCacheSize(origSize) ;
+    return kFALSE ;
+  }
+
+  Double_t val5 = hybrid->getVal() ;
+  y.setRange(-1,1) ;
+  Double_t val6 = hybrid->getVal() ;
+  ok &= check("recalculation for new analytic range",hybrid->numCacheHits()==0 && hybrid->numCacheMisses()==2) ;
+  ok &= check("value for new analytic range",val6<0.8*val5) ;
+
+  y.setRange(-5,5) ;
+  ok &= check("value for restored analytic range",hybrid->getVal()==val5) ;
+  ok &= check("hit count for restored analytic range",hybrid->numCacheHits()==1 && hybrid->numCacheMisses()==2) ;
+  delete intG ;
+
+  // D i s a b l e d   c a c h e
+  // ---------------------------
+
+  RooRealIntegral::setNumericValueCacheSize(0) ;
+  integral->resetIntegrationStats() ;
+  a.setVal(2) ;
+  integral->getVal() ;
+  ok &= check("no counts without cache",integral->numCacheHits()==0 && integral->numCacheMisses()==0) ;
+
+  RooRealIntegral::setNumericValueCacheSize(origSize) ;
+  delete intF ;
+
+  return ok ;
+  }
+} ;
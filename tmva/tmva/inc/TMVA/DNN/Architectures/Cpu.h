@@ -20,6 +20,7 @@
 
 #include "Cpu/CpuBuffer.h"
 #include "Cpu/CpuMatrix.h"
+#include "TMVA/DNN/Functions.h"
 
 namespace TMVA
 {
@@ -61,6 +62,13 @@ public:
    /** Add the vectors biases row-wise to the matrix output */
    static void AddRowWise(TCpuMatrix<Scalar_t> &output,
                           const TCpuMatrix<Scalar_t> &biases);
+   /** Add the vector \p biases row-wise to \p output, write the derivatives
+    *  of the activation function \p f into \p derivatives and apply \p f to
+    *  \p output in a single pass over the matrix. */
+   static void AddRowWiseAndEvaluate(TCpuMatrix<Scalar_t> &output,
+                                     TCpuMatrix<Scalar_t> &derivatives,
+                                     const TCpuMatrix<Scalar_t> &biases,
+                                     EActivationFunction f);
    ///@}
 
    /** @name Backward Propagation
@@ -291,6 +299,26 @@ public:
 
 };
 
+//______________________________________________________________________________
+template<>
+inline void addRowWiseAndEvaluate<TCpu<Double_t>>(TCpuMatrix<Double_t> & A,
+                                                  TCpuMatrix<Double_t> & B,
+                                                  const TCpuMatrix<Double_t> & biases,
+                                                  EActivationFunction f)
+{
+   TCpu<Double_t>::AddRowWiseAndEvaluate(A, B, biases, f);
+}
+
+//______________________________________________________________________________
+template<>
+inline void addRowWiseAndEvaluate<TCpu<Real_t>>(TCpuMatrix<Real_t> & A,
+                                                TCpuMatrix<Real_t> & B,
+                                                const TCpuMatrix<Real_t> & biases,
+                                                EActivationFunction f)
+{
+   TCpu<Real_t>::AddRowWiseAndEvaluate(A, B, biases, f);
+}
+
 } // namespace DNN
 } // namespace TMVA
 
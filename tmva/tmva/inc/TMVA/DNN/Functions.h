@@ -131,6 +131,22 @@ inline void evaluateDerivative(typename Architecture_t::Matrix_t & B,
     }
 }
 
+/*! Add the vector \p biases row-wise to A, write the first partial derivative
+*  of the activation function at the resulting values into B and apply the
+*  activation function to A. Architectures may specialize this function to
+*  perform the three steps in a single pass over the matrix. */
+//______________________________________________________________________________
+template<typename Architecture_t>
+inline void addRowWiseAndEvaluate(typename Architecture_t::Matrix_t & A,
+                                  typename Architecture_t::Matrix_t & B,
+                                  const typename Architecture_t::Matrix_t & biases,
+                                  EActivationFunction f)
+{
+    Architecture_t::AddRowWise(A, biases);
+    evaluateDerivative<Architecture_t>(B, f, A);
+    evaluate<Architecture_t>(A, f);
+}
+
 //______________________________________________________________________________
 //
 //  Output Functions
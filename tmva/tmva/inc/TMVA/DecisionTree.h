@@ -52,6 +52,10 @@
 
 class TRandom3;
 
+namespace ROOT {
+   class TThreadExecutor;
+}
+
 namespace TMVA {
 
    class Event;
@@ -229,12 +233,15 @@ namespace TMVA {
       UInt_t     fMaxDepth;      // max depth
       UInt_t     fSigClass;      // class which is treated as signal when building the tree
       static const Int_t  fgDebugLevel = 0;     // debug level determining some printout/control plots etc.
+      static const UInt_t fgMinEventsNodeMT = 1000; // minimum number of events in a node to scan the variables in parallel
       Int_t     fTreeID;        // just an ID number given to the tree.. makes debugging easier as tree knows who he is.
 
       Types::EAnalysisType  fAnalysisType;   // kClassification(=0=false) or kRegression(=1=true)
 
       DataSetInfo*  fDataSetInfo;
 
+      ROOT::TThreadExecutor* fPool; //! executor of the parallel node splitting, set by the outermost BuildTree call
+
 
       ClassDef(DecisionTree,0);               // implementation of a Decision Tree
    };
@@ -98,8 +98,19 @@ namespace TMVA {
       // calculate the MVA value
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0);
 
+      // calculate the MVA values of a range of events in blocks
+      std::vector<Double_t> GetMvaValues(Long64_t firstEvt = 0, Long64_t lastEvt = -1, Bool_t logProgress = false);
+
+      // calculate the MVA values of rows of input variables, thread-safe
+      Bool_t EvaluateBatch( const Float_t* inputs, UInt_t nEvents, Double_t* outputs ) const;
+
       // get the actual forest size (might be less than fNTrees, the requested one, if boosting is stopped early
       UInt_t   GetNTrees() const {return fForest.size();}
+
+      // flat (struct-of-arrays) copy of the forest used for the evaluation; the response of a
+      // flat tree is the one of DecisionTree::CheckEvent for the same input variables
+      Bool_t   HasFlatForest() const { return !fFlatTreeRoot.empty() && fFlatTreeRoot.size() == fForest.size(); }
+      Double_t GetFlatTreeResponse(UInt_t itree, const Float_t* x) const;
    private:
       Double_t GetMvaValue( Double_t* err, Double_t* errUpper, UInt_t useNTrees );
       Double_t PrivateGetMvaValue( const TMVA::Event *ev, Double_t* err=0, Double_t* errUpper=0, UInt_t useNTrees=0 );
@@ -190,6 +201,11 @@ namespace TMVA {
       void UpdateTargets( std::vector<const TMVA::Event*>&, UInt_t cls = 0);
       void UpdateTargetsRegression( std::vector<const TMVA::Event*>&,Bool_t first=kFALSE);
       Double_t GetGradBoostMVA(const TMVA::Event *e, UInt_t nTrees);
+
+      // flat (struct-of-arrays) copy of the forest used for the evaluation
+      void     BuildFlatForest();
+      void     ClearFlatForest();
+      void     GetFlatForestValues(const Float_t* x, UInt_t nEvents, Double_t* out) const;
       void     GetBaggedSubSample(std::vector<const TMVA::Event*>&);
 
       std::vector<const TMVA::Event*>       fEventSample;     // the training events
@@ -200,6 +216,11 @@ namespace TMVA {
       Int_t                           fNTrees;          // number of decision trees requested
       std::vector<DecisionTree*>      fForest;          // the collection of decision trees
       std::vector<double>             fBoostWeights;    // the weights applied in the individual boosts
+      std::vector<UInt_t>             fFlatTreeRoot;    //! flat forest: index of the root node of each tree
+      std::vector<Int_t>              fFlatSelector;    //! flat forest: cut variable of each node, -1 for leaf nodes
+      std::vector<Float_t>            fFlatCutValue;    //! flat forest: cut value of each node
+      std::vector<UInt_t>             fFlatChildren;    //! flat forest: daughters of node i at 2i (value < cut) and 2i+1 (value >= cut)
+      std::vector<Double_t>           fFlatResponse;    //! flat forest: leaf response as returned by DecisionTree::CheckEvent
       Double_t                        fSigToBkgFraction;// Signal to Background fraction assumed during training
       TString                         fBoostType;       // string specifying the boost type
       Double_t                        fAdaBoostBeta;    // beta parameter for AdaBoost algorithm
@@ -269,6 +290,7 @@ namespace TMVA {
 
       void                             DeterminePreselectionCuts(const std::vector<const TMVA::Event*>& eventSample);
       Double_t                         ApplyPreselectionCuts(const Event* ev);
+      Double_t                         ApplyPreselectionCuts(const Float_t* x) const;
       
       std::vector<Double_t> fLowSigCut;
       std::vector<Double_t> fLowBkgCut;
@@ -289,6 +311,7 @@ namespace TMVA {
 
       // debugging flags
       static const Int_t               fgDebugLevel;     // debug level determining some printout/control plots etc.
+      static const UInt_t              fgFlatBlockSize = 256; // number of events evaluated together with the flat forest
 
       // for backward compatibility
 
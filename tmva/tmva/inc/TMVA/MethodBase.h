@@ -191,6 +191,12 @@ namespace TMVA {
       // signal/background classification response
       Double_t GetMvaValue( const TMVA::Event* const ev, Double_t* err = 0, Double_t* errUpper = 0 );
 
+      // signal/background classification response for nEvents rows of GetNvar() input values;
+      // methods which can evaluate without their internal event buffers (and hence concurrently)
+      // override this, the default returns kFALSE and the Reader evaluates the events one by one
+      // under a lock (this is the case of MLP and DNN, whose networks hold the neuron values)
+      virtual Bool_t EvaluateBatch( const Float_t* /*inputs*/, UInt_t /*nEvents*/, Double_t* /*outputs*/ ) const { return kFALSE; }
+
    protected:
       // helper function to set errors to -1
       void NoErrorCalc(Double_t* const err, Double_t* const errUpper);
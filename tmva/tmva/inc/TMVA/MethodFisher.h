@@ -82,6 +82,7 @@ namespace TMVA {
 
       // calculate the MVA value
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0 );
+      Bool_t   EvaluateBatch( const Float_t* inputs, UInt_t nEvents, Double_t* outputs ) const;
 
       enum EFisherMethod { kFisher, kMahalanobis };
       EFisherMethod GetFisherMethod( void ) { return fFisherMethod; }
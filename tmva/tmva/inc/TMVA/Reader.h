@@ -51,6 +51,7 @@
 
 #include <vector>
 #include <map>
+#include <mutex>
 #include <stdexcept>
 
 namespace TMVA {
@@ -92,6 +93,15 @@ namespace TMVA {
       Double_t EvaluateMVA( MethodBase* method,           Double_t aux = 0 );
       Double_t EvaluateMVA( const TString& methodTag,     Double_t aux = 0 );
 
+      // returns the MVA responses for a block of events, the inputs are stored either row by row
+      // (nEvents rows of the input variables) or, if columnar, variable by variable;
+      // can be called concurrently from several threads, but only methods implementing
+      // MethodBase::EvaluateBatch (BDT, Fisher) run concurrently, others (e.g. MLP, DNN) are serialised
+      void EvaluateMVA( const Float_t* inputs, UInt_t nEvents, Double_t* outputs, const TString& methodTag,
+                        Bool_t columnar = kFALSE, Double_t aux = 0 ) const;
+      void EvaluateMVA( const std::vector<Float_t>& inputs, std::vector<Double_t>& outputs, const TString& methodTag,
+                        Bool_t columnar = kFALSE, Double_t aux = 0 ) const;
+
       // returns error on MVA response for given event
       // NOTE: must be called AFTER "EvaluateMVA(...)" call !
       Double_t GetMVAError() const { return fMvaEventError; }
@@ -161,6 +171,8 @@ namespace TMVA {
 
       std::vector<Float_t> fTmpEvalVec; // temporary evaluation vector (if user input is v<double>)
 
+      mutable std::mutex fEvalMutex;    //! serialises the block evaluation of methods using their event buffers and its messages
+
       mutable MsgLogger* fLogger;   // message logger
       MsgLogger& Log() const { return *fLogger; }
 
@@ -0,0 +1,447 @@
+// @(#)root/tmva/tmva/dnn:$Id$
+// Author: Simon Pfreundschuh 20/07/16
+
+/*************************************************************************
+ * Copyright (C) 2016, Simon Pfreundschuh                                *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////
+// Implementation of the BLAS functions used by the CPU backend.  //
+// They call the external BLAS library TMVA is linked against or, //
+// if it is built without one (DNNCPU_BUILTIN_BLAS), the built-in //
+// kernels.                                                       //
+////////////////////////////////////////////////////////////////////
+
+#include "TMVA/DNN/Architectures/Cpu/Blas.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifndef DNNCPU_BUILTIN_BLAS
+
+// External Library Routines
+//____________________________________________________________________________
+extern "C" void saxpy_(const int * n, const float * alpha, const float * x,
+                       const int * incx, float * y,   const int * incy);
+extern "C" void daxpy_(const int * n, const double * alpha, const double * x,
+                       const int * incx, double * y, const int * incy);
+extern "C" void sger_(const int * m, const int * n, const float * alpha,
+                      const float * x, const int * incx,
+                      const float * y, const int * incy,
+                      float * A, const int * lda);
+extern "C" void dger_(const int * m, const int * n, const double * alpha,
+                      const double * x, const int * incx,
+                      const double * y, const int * incy,
+                      double * A, const int * lda);
+extern "C" void sgemv_(const char * trans, const int * m, const int * n,
+                       const float * alpha,  const float * A, const int * lda,
+                       const float * x, const int * incx,
+                       const float * beta, float * y, const int * incy);
+extern "C" void dgemv_(const char * trans, const int * m, const int * n,
+                       const double * alpha,  const double * A, const int * lda,
+                       const double * x, const int * incx,
+                       const double * beta, double * y, const int * incy);
+extern "C" void dgemm_(const char * transa, const char * transb,
+                       const int * m, const int * n, const int * k,
+                       const double * alpha, const double * A, const int * lda,
+                       const double * B, const int * ldb, const double * beta,
+                       double * C, const int * ldc);
+extern "C" void sgemm_(const char * transa, const char * transb,
+                       const int * m, const int * n, const int * k,
+                       const float * alpha, const float * A, const int * lda,
+                       const float * B, const int * ldb, const float * beta,
+                       float * C, const int * ldc);
+
+#endif // DNNCPU_BUILTIN_BLAS
+
+namespace TMVA
+{
+namespace DNN
+{
+namespace Blas
+{
+
+namespace
+{
+
+// Built-in Implementations
+//____________________________________________________________________________
+template <typename Real_t>
+void AxpyImpl(const int * n, const Real_t * alpha,
+              const Real_t * x, const int * incx,
+              Real_t * y, const int * incy)
+{
+   for (int i = 0; i < *n; i++) y[i * *incy] += *alpha * x[i * *incx];
+}
+
+template <typename Real_t>
+void GemvImpl(const char *trans, const int * m, const int * n,
+              const Real_t * alpha, const Real_t * A, const int * lda,
+              const Real_t * x, const int * incx,
+              const Real_t * beta, Real_t * y, const int * incy)
+{
+   bool transA = (*trans == 'T' || *trans == 't' || *trans == 'C' || *trans == 'c');
+   int  ny     = transA ? *n : *m;
+   int  nx     = transA ? *m : *n;
+
+   for (int i = 0; i < ny; i++) y[i * *incy] = (*beta == 0) ? 0 : *beta * y[i * *incy];
+
+   if (transA) {
+      for (int j = 0; j < ny; j++) {
+         const Real_t *a = A + j * *lda;
+         Real_t sum = 0;
+         for (int i = 0; i < nx; i++) sum += a[i] * x[i * *incx];
+         y[j * *incy] += *alpha * sum;
+      }
+   } else {
+      for (int j = 0; j < nx; j++) {
+         const Real_t *a  = A + j * *lda;
+         Real_t        xj = *alpha * x[j * *incx];
+         for (int i = 0; i < ny; i++) y[i * *incy] += a[i] * xj;
+      }
+   }
+}
+
+template <typename Real_t>
+void GemmImpl(const char *transa, const char *transb,
+              const int * m, const int * n, const int* k,
+              const Real_t * alpha, const Real_t * A, const int * lda,
+              const Real_t * B, const int * ldb, const Real_t * beta,
+              Real_t * C, const int * ldc)
+{
+   const int kMC = 128; // rows of op(A) per block
+   const int kKC = 256; // inner dimension per block
+   const int kNC = 256; // columns of op(B) per block
+   const int kMR = 32;  // rows of the micro tile accumulated locally
+   const int kNR = 4;   // columns of the micro tile accumulated locally
+
+   bool transA = (*transa == 'T' || *transa == 't' || *transa == 'C' || *transa == 'c');
+   bool transB = (*transb == 'T' || *transb == 't' || *transb == 'C' || *transb == 'c');
+
+   for (int j = 0; j < *n; j++) {
+      Real_t *c = C + j * *ldc;
+      if (*beta == 0)      std::fill(c, c + *m, Real_t(0));
+      else if (*beta != 1) for (int i = 0; i < *m; i++) c[i] *= *beta;
+   }
+   if (*alpha == 0 || *k == 0) return;
+
+   std::vector<Real_t> packedA(kMC * kKC);
+   std::vector<Real_t> packedB(kKC * kNC);
+
+   for (int pc = 0; pc < *k; pc += kKC) {
+      int kc = std::min(kKC, *k - pc);
+      for (int jc = 0; jc < *n; jc += kNC) {
+         int nc = std::min(kNC, *n - jc);
+
+         // packedB(p, j) = alpha * op(B)(pc + p, jc + j), stored column-wise and
+         // padded with zero columns to a multiple of kNR
+         for (int j = 0; j < nc; j++) {
+            Real_t *b = packedB.data() + j * kc;
+            for (int p = 0; p < kc; p++) {
+               b[p] = *alpha * (transB ? B[(jc + j) + (pc + p) * *ldb]
+                                       : B[(pc + p) + (jc + j) * *ldb]);
+            }
+         }
+         for (int j = nc; j % kNR != 0; j++) {
+            std::fill(packedB.data() + j * kc, packedB.data() + (j + 1) * kc, Real_t(0));
+         }
+
+         for (int ic = 0; ic < *m; ic += kMC) {
+            int mc = std::min(kMC, *m - ic);
+
+            // op(A)(ic + i, pc + p) is packed in panels of kMR rows, padded with zero rows:
+            // element (ir + i, p) of the block is stored at ir * kc + p * kMR + i
+            for (int ir = 0; ir < mc; ir += kMR) {
+               int mr = std::min(kMR, mc - ir);
+               for (int p = 0; p < kc; p++) {
+                  Real_t *a = packedA.data() + ir * kc + p * kMR;
+                  if (transA) {
+                     for (int i = 0; i < mr; i++) a[i] = A[(pc + p) + (ic + ir + i) * *lda];
+                  } else {
+                     const Real_t *acol = A + (ic + ir) + (pc + p) * *lda;
+                     std::copy(acol, acol + mr, a);
+                  }
+                  std::fill(a + mr, a + kMR, Real_t(0));
+               }
+            }
+
+            // the micro tile of kMR x kNR elements of C is accumulated in a local array, which
+            // cannot alias the packed blocks, so that the compiler vectorizes the loop over the rows
+            for (int j = 0; j < nc; j += kNR) {
+               int nr = std::min(kNR, nc - j);
+               const Real_t *b0 = packedB.data() + j * kc;
+               const Real_t *b1 = b0 + kc;
+               const Real_t *b2 = b1 + kc;
+               const Real_t *b3 = b2 + kc;
+               for (int ir = 0; ir < mc; ir += kMR) {
+                  int mr = std::min(kMR, mc - ir);
+                  const Real_t *panel = packedA.data() + ir * kc;
+                  Real_t acc[kNR][kMR] = {};
+                  for (int p = 0; p < kc; p++) {
+                     const Real_t *a = panel + p * kMR;
+                     Real_t x0 = b0[p], x1 = b1[p], x2 = b2[p], x3 = b3[p];
+                     for (int i = 0; i < kMR; i++) {
+                        acc[0][i] += a[i] * x0;
+                        acc[1][i] += a[i] * x1;
+                        acc[2][i] += a[i] * x2;
+                        acc[3][i] += a[i] * x3;
+                     }
+                  }
+                  for (int jr = 0; jr < nr; jr++) {
+                     Real_t *c = C + (ic + ir) + (jc + j + jr) * *ldc;
+                     for (int i = 0; i < mr; i++) c[i] += acc[jr][i];
+                  }
+               }
+            }
+         }
+      }
+   }
+}
+
+template <typename Real_t>
+void GerImpl(const int * m, const int * n, const Real_t * alpha,
+             const Real_t * x, const int * incx,
+             const Real_t * y, const int * incy,
+             Real_t * A, const int * lda)
+{
+   for (int j = 0; j < *n; j++) {
+      Real_t *a  = A + j * *lda;
+      Real_t  yj = *alpha * y[j * *incy];
+      for (int i = 0; i < *m; i++) a[i] += x[i * *incx] * yj;
+   }
+}
+
+} // namespace
+
+namespace Builtin
+{
+
+//____________________________________________________________________________
+void Axpy(const int * n, const double * alpha, const double * x, const int * incx,
+          double * y, const int * incy)
+{
+   AxpyImpl(n, alpha, x, incx, y, incy);
+}
+
+void Axpy(const int * n, const float * alpha, const float * x, const int * incx,
+          float * y, const int * incy)
+{
+   AxpyImpl(n, alpha, x, incx, y, incy);
+}
+
+//____________________________________________________________________________
+void Gemv(const char *trans, const int * m, const int * n,
+          const double * alpha, const double * A, const int * lda,
+          const double * x, const int * incx,
+          const double * beta, double * y, const int * incy)
+{
+   GemvImpl(trans, m, n, alpha, A, lda, x, incx, beta, y, incy);
+}
+
+void Gemv(const char *trans, const int * m, const int * n,
+          const float * alpha, const float * A, const int * lda,
+          const float * x, const int * incx,
+          const float * beta, float * y, const int * incy)
+{
+   GemvImpl(trans, m, n, alpha, A, lda, x, incx, beta, y, incy);
+}
+
+//____________________________________________________________________________
+void Gemm(const char *transa, const char *transb,
+          const int * m, const int * n, const int* k,
+          const double * alpha, const double * A, const int * lda,
+          const double * B, const int * ldb, const double * beta,
+          double * C, const int * ldc)
+{
+   GemmImpl(transa, transb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+void Gemm(const char *transa, const char *transb,
+          const int * m, const int * n, const int* k,
+          const float * alpha, const float * A, const int * lda,
+          const float * B, const int * ldb, const float * beta,
+          float * C, const int * ldc)
+{
+   GemmImpl(transa, transb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+//____________________________________________________________________________
+void Ger(const int * m, const int * n, const double * alpha,
+         const double * x, const int * incx,
+         const double * y, const int * incy,
+         double * A, const int * lda)
+{
+   GerImpl(m, n, alpha, x, incx, y, incy, A, lda);
+}
+
+void Ger(const int * m, const int * n, const float * alpha,
+         const float * x, const int * incx,
+         const float * y, const int * incy,
+         float * A, const int * lda)
+{
+   GerImpl(m, n, alpha, x, incx, y, incy, A, lda);
+}
+
+} // namespace Builtin
+
+#ifndef DNNCPU_BUILTIN_BLAS
+
+// Specializations, calling the external library
+//____________________________________________________________________________
+template<>
+void Axpy<double>(const int * n, const double * alpha,
+                  const double * x, const int * incx,
+                  double * y, const int * incy)
+{
+   daxpy_(n, alpha, x, incx, y, incy);
+}
+
+template<>
+void Axpy<float>(const int * n, const float * alpha,
+                 const float * x, const int * incx,
+                 float * y, const int * incy)
+{
+   saxpy_(n, alpha, x, incx, y, incy);
+}
+
+template<>
+void Gemv<double>(const char *trans, const int * m, const int * n,
+                  const double * alpha, const double * A, const int * lda,
+                  const double * x, const int * incx,
+                  const double * beta, double * y, const int * incy)
+{
+   dgemv_(trans, m, n, alpha, A, lda, x, incx, beta, y, incy);
+}
+
+template<>
+void Gemv<float>(const char *trans, const int * m, const int * n,
+                 const float * alpha, const float * A, const int * lda,
+                 const float * x, const int * incx,
+                 const float * beta, float * y, const int * incy)
+{
+   sgemv_(trans, m, n, alpha, A, lda, x, incx, beta, y, incy);
+}
+
+template<>
+void Gemm<double>(const char *transa, const char *transb,
+                  const int * m, const int * n, const int* k,
+                  const double * alpha, const double * A, const int * lda,
+                  const double * B, const int * ldb, const double * beta,
+                  double * C, const int * ldc)
+{
+   dgemm_(transa, transb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+template<>
+void Gemm<float>(const char *transa, const char *transb,
+                 const int * m, const int * n, const int* k,
+                 const float * alpha, const float * A, const int * lda,
+                 const float * B, const int * ldb, const float * beta,
+                 float * C, const int * ldc)
+{
+   sgemm_(transa, transb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+template <>
+void Ger<double>(const int * m, const int * n, const double * alpha,
+                 const double * x, const int * incx,
+                 const double * y, const int * incy,
+                 double * A, const int * lda)
+{
+   dger_(m, n, alpha, x, incx, y, incy, A, lda);
+}
+
+template <>
+void Ger<float>(const int * m, const int * n, const float * alpha,
+                const float * x, const int * incx,
+                const float * y, const int * incy,
+                float * A, const int * lda)
+{
+   sger_(m, n, alpha, x, incx, y, incy, A, lda);
+}
+
+#else // DNNCPU_BUILTIN_BLAS
+
+// Specializations, calling the built-in kernels
+//____________________________________________________________________________
+template<>
+void Axpy<double>(const int * n, const double * alpha,
+                  const double * x, const int * incx,
+                  double * y, const int * incy)
+{
+   Builtin::Axpy(n, alpha, x, incx, y, incy);
+}
+
+template<>
+void Axpy<float>(const int * n, const float * alpha,
+                 const float * x, const int * incx,
+                 float * y, const int * incy)
+{
+   Builtin::Axpy(n, alpha, x, incx, y, incy);
+}
+
+template<>
+void Gemv<double>(const char *trans, const int * m, const int * n,
+                  const double * alpha, const double * A, const int * lda,
+                  const double * x, const int * incx,
+                  const double * beta, double * y, const int * incy)
+{
+   Builtin::Gemv(trans, m, n, alpha, A, lda, x, incx, beta, y, incy);
+}
+
+template<>
+void Gemv<float>(const char *trans, const int * m, const int * n,
+                 const float * alpha, const float * A, const int * lda,
+                 const float * x, const int * incx,
+                 const float * beta, float * y, const int * incy)
+{
+   Builtin::Gemv(trans, m, n, alpha, A, lda, x, incx, beta, y, incy);
+}
+
+template<>
+void Gemm<double>(const char *transa, const char *transb,
+                  const int * m, const int * n, const int* k,
+                  const double * alpha, const double * A, const int * lda,
+                  const double * B, const int * ldb, const double * beta,
+                  double * C, const int * ldc)
+{
+   Builtin::Gemm(transa, transb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+template<>
+void Gemm<float>(const char *transa, const char *transb,
+                 const int * m, const int * n, const int* k,
+                 const float * alpha, const float * A, const int * lda,
+                 const float * B, const int * ldb, const float * beta,
+                 float * C, const int * ldc)
+{
+   Builtin::Gemm(transa, transb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+template <>
+void Ger<double>(const int * m, const int * n, const double * alpha,
+                 const double * x, const int * incx,
+                 const double * y, const int * incy,
+                 double * A, const int * lda)
+{
+   Builtin::Ger(m, n, alpha, x, incx, y, incy, A, lda);
+}
+
+template <>
+void Ger<float>(const int * m, const int * n, const float * alpha,
+                const float * x, const int * incx,
+                const float * y, const int * incy,
+                float * A, const int * lda)
+{
+   Builtin::Ger(m, n, alpha, x, incx, y, incy, A, lda);
+}
+
+#endif // DNNCPU_BUILTIN_BLAS
+
+} // namespace Blas
+} // namespace DNN
+} // namespace TMVA
@@ -64,6 +64,101 @@ void TCpu<AFloat>::AddRowWise(
     ::TMVA::DNN::Blas::Ger(&m, &n, &alpha, x, &inc, y, &inc, A, &m);
 }
 
+namespace
+{
+
+//______________________________________________________________________________
+/** Add biases[j] to column j of output and replace each element x by
+ *  f(x, dfdx), which returns the activation and stores its derivative in
+ *  dfdx. The columns are processed in parallel. */
+template<typename AFloat, typename Function_t>
+void AddRowWiseAndMap(TCpuMatrix<AFloat> &output,
+                      TCpuMatrix<AFloat> &derivatives,
+                      const TCpuMatrix<AFloat> &biases,
+                      Function_t f)
+{
+   size_t m = output.GetNrows();
+   size_t n = output.GetNcols();
+
+         AFloat * x  = output.GetRawDataPointer();
+         AFloat * dx = derivatives.GetRawDataPointer();
+   const AFloat * b  = biases.GetRawDataPointer();
+
+   auto column = [=](UInt_t j)
+   {
+      AFloat * xj  = x  + j * m;
+      AFloat * dxj = dx + j * m;
+      for (size_t i = 0; i < m; i++) {
+         xj[i] = f(xj[i] + b[j], dxj[i]);
+      }
+   };
+   output.GetThreadExecutor().Foreach(column, ROOT::TSeqU(n));
+}
+
+} // namespace
+
+template<typename AFloat>
+void TCpu<AFloat>::AddRowWiseAndEvaluate(TCpuMatrix<AFloat> &output,
+                                         TCpuMatrix<AFloat> &derivatives,
+                                         const TCpuMatrix<AFloat> &biases,
+                                         EActivationFunction f)
+{
+   // Same expressions as in ActivationFunctions.cxx, evaluated once per element.
+   switch(f)
+   {
+   case EActivationFunction::kIdentity :
+      AddRowWiseAndMap(output, derivatives, biases,
+                       [](AFloat x, AFloat & dfdx) {dfdx = 1.0; return x;});
+      break;
+   case EActivationFunction::kRelu :
+      AddRowWiseAndMap(output, derivatives, biases,
+                       [](AFloat x, AFloat & dfdx) {
+                          dfdx = (x < 0.0) ? 0.0 : 1.0;
+                          return (x < 0.0) ? 0.0 : x;
+                       });
+      break;
+   case EActivationFunction::kSigmoid :
+      AddRowWiseAndMap(output, derivatives, biases,
+                       [](AFloat x, AFloat & dfdx) {
+                          AFloat sig = 1.0 / (1.0 + exp(-x));
+                          dfdx = sig * (1.0 - sig);
+                          return sig;
+                       });
+      break;
+   case EActivationFunction::kTanh :
+      AddRowWiseAndMap(output, derivatives, biases,
+                       [](AFloat x, AFloat & dfdx) {
+                          AFloat t = tanh(x);
+                          dfdx = 1 - t * t;
+                          return t;
+                       });
+      break;
+   case EActivationFunction::kSymmRelu :
+      AddRowWiseAndMap(output, derivatives, biases,
+                       [](AFloat x, AFloat & dfdx) {
+                          dfdx = (x < 0.0) ? -1.0 : 1.0;
+                          return fabs(x);
+                       });
+      break;
+   case EActivationFunction::kSoftSign :
+      AddRowWiseAndMap(output, derivatives, biases,
+                       [](AFloat x, AFloat & dfdx) {
+                          AFloat d = 1.0 + fabs(x);
+                          dfdx = 1.0 / (d * d);
+                          return x / d;
+                       });
+      break;
+   case EActivationFunction::kGauss :
+      AddRowWiseAndMap(output, derivatives, biases,
+                       [](AFloat x, AFloat & dfdx) {
+                          AFloat g = exp(- x * x);
+                          dfdx = - 2.0 * x * g;
+                          return g;
+                       });
+      break;
+   }
+}
+
 template<typename AFloat>
 void TCpu<AFloat>::Backward(
     TCpuMatrix<AFloat> & activationGradientsBackward,
@@ -74,8 +169,28 @@ void TCpu<AFloat>::Backward(
     const TCpuMatrix<AFloat> & weights,
     const TCpuMatrix<AFloat> & activationsBackward)
 {
-   // Compute element-wise product.
-   Hadamard(df, activationGradients);
+   // Compute element-wise product and, in the same pass, the bias
+   // gradients as the column sums of the product.
+   size_t m = df.GetNrows();
+   size_t n = df.GetNcols();
+
+         AFloat * dfPointer = df.GetRawDataPointer();
+   const AFloat * gPointer  = activationGradients.GetRawDataPointer();
+         AFloat * bPointer  = (biasGradients.GetNElements() > 0)
+                              ? biasGradients.GetRawDataPointer() : nullptr;
+
+   auto column = [=](UInt_t j)
+   {
+            AFloat * dfj = dfPointer + j * m;
+      const AFloat * gj  = gPointer  + j * m;
+      AFloat sum = 0.0;
+      for (size_t i = 0; i < m; i++) {
+         dfj[i] *= gj[i];
+         sum    += dfj[i];
+      }
+      if (bPointer) bPointer[j] = sum;
+   };
+   df.GetThreadExecutor().Foreach(column, ROOT::TSeqU(n));
 
    // Activation gradients.
    if (activationGradientsBackward.GetNElements() > 0)
@@ -84,10 +199,6 @@ void TCpu<AFloat>::Backward(
    // Weight gradients.
    if (weightGradients.GetNElements() > 0)
        TransposeMultiply(weightGradients, df, activationsBackward);
-
-   // Bias gradients.
-   if (biasGradients.GetNElements() > 0)
-       SumColumns(biasGradients, df);
 }
 
 } // namespace DNN
@@ -64,11 +64,18 @@ more signal respective background events from the training sample.
 #include <fstream>
 #include <algorithm>
 #include <cassert>
+#include <memory>
 
+#include "RConfigure.h"
 #include "TRandom3.h"
 #include "TMath.h"
 #include "TMatrix.h"
 
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 #include "TMVA/MsgLogger.h"
 #include "TMVA/DecisionTree.h"
 #include "TMVA/DecisionTreeNode.h"
@@ -138,7 +145,8 @@ TMVA::DecisionTree::DecisionTree():
    fSigClass       (0),
    fTreeID         (0),
    fAnalysisType   (Types::kClassification),
-   fDataSetInfo    (NULL)
+   fDataSetInfo    (NULL),
+   fPool           (NULL)
 {
 }
 
@@ -175,7 +183,8 @@ TMVA::DecisionTree::DecisionTree( TMVA::SeparationBase *sepType, Float_t minSize
    fSigClass       (cls),
    fTreeID         (treeID),
    fAnalysisType   (Types::kClassification),
-   fDataSetInfo    (dataInfo)
+   fDataSetInfo    (dataInfo),
+   fPool           (NULL)
 {
    if (sepType == NULL) { // it is interpreted as a regression tree, where
                           // currently the separation type (simple least square)
@@ -222,7 +231,8 @@ TMVA::DecisionTree::DecisionTree( const DecisionTree &d ):
    fSigClass   (d.fSigClass),
    fTreeID     (d.fTreeID),
    fAnalysisType(d.fAnalysisType),
-   fDataSetInfo    (d.fDataSetInfo)
+   fDataSetInfo    (d.fDataSetInfo),
+   fPool           (NULL)
 {
    this->SetRoot( new TMVA::DecisionTreeNode ( *((DecisionTreeNode*)(d.GetRoot())) ) );
    this->SetParentTreeInNodes();
@@ -294,6 +304,21 @@ TMVA::DecisionTree* TMVA::DecisionTree::CreateFromXML(void* node, UInt_t tmva_Ve
 UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & eventSample,
                                       TMVA::DecisionTreeNode *node)
 {
+#ifdef R__USE_IMT
+   // the outermost call creates the executor used to split all the nodes of the tree
+   std::unique_ptr<ROOT::TThreadExecutor> pool;
+   if (!fPool && ROOT::IsImplicitMTEnabled()) {
+      pool.reset(new ROOT::TThreadExecutor());
+      fPool = pool.get();
+   }
+   // and forgets it when it returns (or throws)
+   struct PoolRelease {
+      ROOT::TThreadExecutor *&fPoolRef;
+      bool fOwner;
+      ~PoolRelease() { if (fOwner) fPoolRef = nullptr; }
+   } poolRelease{fPool, pool != nullptr};
+#endif
+
    if (node==NULL) {
       //start with the root node
       node = new TMVA::DecisionTreeNode();
@@ -930,7 +955,7 @@ void TMVA::DecisionTree::GetRandomisedVariables(Bool_t *useVariable, UInt_t *map
 Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
                                             TMVA::DecisionTreeNode *node )
 {
-   Double_t  separationGainTotal = -1, sepTmp;
+   Double_t  separationGainTotal = -1;
    Double_t *separationGain    = new Double_t[fNvars+1];
    Int_t    *cutIndex          = new Int_t[fNvars+1];  //-1;
 
@@ -1127,6 +1152,116 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
       }
    }
 
+   // helpers filling the histogram of a variable, turning it into a cumulative distribution,
+   // checking it and finding the cut giving the best separationGain
+   auto fillVariable = [&](UInt_t ivar, UInt_t iev, Double_t eventWeight) {
+      Double_t eventData;
+      if (ivar < fNvars) eventData = eventSample[iev]->GetValueFast(ivar);
+      else { // the fisher variable
+         eventData = fisherCoeff[fNvars];
+         for (UInt_t jvar=0; jvar<fNvars; jvar++)
+            eventData += fisherCoeff[jvar]*(eventSample[iev])->GetValueFast(jvar);
+
+      }
+      // "maximum" is nbins-1 (the "-1" because we start counting from 0 !!
+      Int_t iBin = TMath::Min(Int_t(nBins[ivar]-1),TMath::Max(0,int (invBinWidth[ivar]*(eventData-xmin[ivar]) ) ));
+      if (eventSample[iev]->GetClass() == fSigClass) {
+         nSelS[ivar][iBin]+=eventWeight;
+         nSelS_unWeighted[ivar][iBin]++;
+      }
+      else {
+         nSelB[ivar][iBin]+=eventWeight;
+         nSelB_unWeighted[ivar][iBin]++;
+      }
+      if (DoRegression()) {
+         target[ivar][iBin] +=eventWeight*eventSample[iev]->GetTarget(0);
+         target2[ivar][iBin]+=eventWeight*eventSample[iev]->GetTarget(0)*eventSample[iev]->GetTarget(0);
+      }
+   };
+
+   auto cumulateVariable = [&](UInt_t ivar) {
+      for (UInt_t ibin=1; ibin < nBins[ivar]; ibin++) {
+         nSelS[ivar][ibin]+=nSelS[ivar][ibin-1];
+         nSelS_unWeighted[ivar][ibin]+=nSelS_unWeighted[ivar][ibin-1];
+         nSelB[ivar][ibin]+=nSelB[ivar][ibin-1];
+         nSelB_unWeighted[ivar][ibin]+=nSelB_unWeighted[ivar][ibin-1];
+         if (DoRegression()) {
+            target[ivar][ibin] +=target[ivar][ibin-1] ;
+            target2[ivar][ibin]+=target2[ivar][ibin-1];
+         }
+      }
+   };
+
+   // logs with kFATAL, hence must only be called from the thread owning the tree
+   auto checkVariable = [&](UInt_t ivar) {
+      if (nSelS_unWeighted[ivar][nBins[ivar]-1] +nSelB_unWeighted[ivar][nBins[ivar]-1] != eventSample.size()) {
+         Log() << kFATAL << "Helge, you have a bug ....nSelS_unw..+nSelB_unw..= "
+               << nSelS_unWeighted[ivar][nBins[ivar]-1] +nSelB_unWeighted[ivar][nBins[ivar]-1]
+               << " while eventsample size = " << eventSample.size()
+               << Endl;
+      }
+      double lastBins=nSelS[ivar][nBins[ivar]-1] +nSelB[ivar][nBins[ivar]-1];
+      double totalSum=nTotS+nTotB;
+      if (TMath::Abs(lastBins-totalSum)/totalSum>0.01) {
+         Log() << kFATAL << "Helge, you have another bug ....nSelS+nSelB= "
+               << lastBins
+               << " while total number of events = " << totalSum
+               << Endl;
+      }
+   };
+
+   auto findBestCut = [&](UInt_t ivar) {
+      for (UInt_t iBin=0; iBin<nBins[ivar]-1; iBin++) { // the last bin contains "all events" -->skip
+         // the separationGain is defined as the various indices (Gini, CorssEntropy, e.t.c)
+         // calculated by the "SamplePurities" from the branches that would go to the
+         // left or the right from this node if "these" cuts were used in the Node:
+         // hereby: nSelS and nSelB would go to the right branch
+         //        (nTotS - nSelS) + (nTotB - nSelB)  would go to the left branch;
+
+         // only allow splits where both daughter nodes match the specified minimum number
+         // for this use the "unweighted" events, as you are interested in statistically
+         // significant splits, which is determined by the actual number of entries
+         // for a node, rather than the sum of event weights.
+
+         Double_t sl = nSelS_unWeighted[ivar][iBin];
+         Double_t bl = nSelB_unWeighted[ivar][iBin];
+         Double_t s  = nTotS_unWeighted;
+         Double_t b  = nTotB_unWeighted;
+         Double_t slW = nSelS[ivar][iBin];
+         Double_t blW = nSelB[ivar][iBin];
+         Double_t sW  = nTotS;
+         Double_t bW  = nTotB;
+         Double_t sr = s-sl;
+         Double_t br = b-bl;
+         Double_t srW = sW-slW;
+         Double_t brW = bW-blW;
+         //            std::cout << "sl="<<sl << " bl="<<bl<<" fMinSize="<<fMinSize << "sr="<<sr << " br="<<br  <<std::endl;
+         if ( ((sl+bl)>=fMinSize && (sr+br)>=fMinSize)
+              && ((slW+blW)>=fMinSize && (srW+brW)>=fMinSize)
+              ) {
+
+            Double_t sepTmp;
+            if (DoRegression()) {
+               sepTmp = fRegType->GetSeparationGain(nSelS[ivar][iBin]+nSelB[ivar][iBin],
+                                                    target[ivar][iBin],target2[ivar][iBin],
+                                                    nTotS+nTotB,
+                                                    target[ivar][nBins[ivar]-1],target2[ivar][nBins[ivar]-1]);
+            } else {
+               sepTmp = fSepType->GetSeparationGain(nSelS[ivar][iBin], nSelB[ivar][iBin], nTotS, nTotB);
+            }
+            if (separationGain[ivar] < sepTmp) {
+               separationGain[ivar] = sepTmp;
+               cutIndex[ivar]       = iBin;
+            }
+         }
+      }
+   };
+
+   Bool_t scanInParallel = kFALSE;
+#ifdef R__USE_IMT
+   scanInParallel = ROOT::IsImplicitMTEnabled() && cNvars > 1 && nevents >= fgMinEventsNodeMT;
+#endif
+
    nTotS=0; nTotB=0;
    nTotS_unWeighted=0; nTotB_unWeighted=0;
    for (UInt_t iev=0; iev<nevents; iev++) {
@@ -1140,114 +1275,48 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
          nTotB_unWeighted++;
       }
 
-      Int_t iBin=-1;
+      if (scanInParallel) continue;
       for (UInt_t ivar=0; ivar < cNvars; ivar++) {
          // now scan trough the cuts for each variable and find which one gives
          // the best separationGain at the current stage.
-         if ( useVariable[ivar] ) {
-            Double_t eventData;
-            if (ivar < fNvars) eventData = eventSample[iev]->GetValueFast(ivar);
-            else { // the fisher variable
-               eventData = fisherCoeff[fNvars];
-               for (UInt_t jvar=0; jvar<fNvars; jvar++)
-                  eventData += fisherCoeff[jvar]*(eventSample[iev])->GetValueFast(jvar);
-
-            }
-            // "maximum" is nbins-1 (the "-1" because we start counting from 0 !!
-            iBin = TMath::Min(Int_t(nBins[ivar]-1),TMath::Max(0,int (invBinWidth[ivar]*(eventData-xmin[ivar]) ) ));
-            if (eventSample[iev]->GetClass() == fSigClass) {
-               nSelS[ivar][iBin]+=eventWeight;
-               nSelS_unWeighted[ivar][iBin]++;
-            }
-            else {
-               nSelB[ivar][iBin]+=eventWeight;
-               nSelB_unWeighted[ivar][iBin]++;
-            }
-            if (DoRegression()) {
-               target[ivar][iBin] +=eventWeight*eventSample[iev]->GetTarget(0);
-               target2[ivar][iBin]+=eventWeight*eventSample[iev]->GetTarget(0)*eventSample[iev]->GetTarget(0);
-            }
-         }
+         if ( useVariable[ivar] ) fillVariable(ivar, iev, eventWeight);
       }
    }
-   // now turn the "histogram" into a cumulative distribution
-   for (UInt_t ivar=0; ivar < cNvars; ivar++) {
-      if (useVariable[ivar]) {
-         for (UInt_t ibin=1; ibin < nBins[ivar]; ibin++) {
-            nSelS[ivar][ibin]+=nSelS[ivar][ibin-1];
-            nSelS_unWeighted[ivar][ibin]+=nSelS_unWeighted[ivar][ibin-1];
-            nSelB[ivar][ibin]+=nSelB[ivar][ibin-1];
-            nSelB_unWeighted[ivar][ibin]+=nSelB_unWeighted[ivar][ibin-1];
-            if (DoRegression()) {
-               target[ivar][ibin] +=target[ivar][ibin-1] ;
-               target2[ivar][ibin]+=target2[ivar][ibin-1];
-            }
-         }
-         if (nSelS_unWeighted[ivar][nBins[ivar]-1] +nSelB_unWeighted[ivar][nBins[ivar]-1] != eventSample.size()) {
-            Log() << kFATAL << "Helge, you have a bug ....nSelS_unw..+nSelB_unw..= "
-                  << nSelS_unWeighted[ivar][nBins[ivar]-1] +nSelB_unWeighted[ivar][nBins[ivar]-1]
-                  << " while eventsample size = " << eventSample.size()
-                  << Endl;
-         }
-         double lastBins=nSelS[ivar][nBins[ivar]-1] +nSelB[ivar][nBins[ivar]-1];
-         double totalSum=nTotS+nTotB;
-         if (TMath::Abs(lastBins-totalSum)/totalSum>0.01) {
-            Log() << kFATAL << "Helge, you have another bug ....nSelS+nSelB= "
-                  << lastBins
-                  << " while total number of events = " << totalSum
-                  << Endl;
+
+   if (!scanInParallel) {
+      // now turn the "histogram" into a cumulative distribution
+      for (UInt_t ivar=0; ivar < cNvars; ivar++) {
+         if (useVariable[ivar]) {
+            cumulateVariable(ivar);
+            checkVariable(ivar);
          }
       }
+      // now select the optimal cuts for each variable and find which one gives
+      // the best separationGain at the current stage
+      for (UInt_t ivar=0; ivar < cNvars; ivar++) {
+         if (useVariable[ivar]) findBestCut(ivar);
+      }
    }
-   // now select the optimal cuts for each variable and find which one gives
-   // the best separationGain at the current stage
-   for (UInt_t ivar=0; ivar < cNvars; ivar++) {
-      if (useVariable[ivar]) {
-         for (UInt_t iBin=0; iBin<nBins[ivar]-1; iBin++) { // the last bin contains "all events" -->skip
-            // the separationGain is defined as the various indices (Gini, CorssEntropy, e.t.c)
-            // calculated by the "SamplePurities" from the branches that would go to the
-            // left or the right from this node if "these" cuts were used in the Node:
-            // hereby: nSelS and nSelB would go to the right branch
-            //        (nTotS - nSelS) + (nTotB - nSelB)  would go to the left branch;
-
-            // only allow splits where both daughter nodes match the specified minimum number
-            // for this use the "unweighted" events, as you are interested in statistically
-            // significant splits, which is determined by the actual number of entries
-            // for a node, rather than the sum of event weights.
-
-            Double_t sl = nSelS_unWeighted[ivar][iBin];
-            Double_t bl = nSelB_unWeighted[ivar][iBin];
-            Double_t s  = nTotS_unWeighted;
-            Double_t b  = nTotB_unWeighted;
-            Double_t slW = nSelS[ivar][iBin];
-            Double_t blW = nSelB[ivar][iBin];
-            Double_t sW  = nTotS;
-            Double_t bW  = nTotB;
-            Double_t sr = s-sl;
-            Double_t br = b-bl;
-            Double_t srW = sW-slW;
-            Double_t brW = bW-blW;
-            //            std::cout << "sl="<<sl << " bl="<<bl<<" fMinSize="<<fMinSize << "sr="<<sr << " br="<<br  <<std::endl;
-            if ( ((sl+bl)>=fMinSize && (sr+br)>=fMinSize)
-                 && ((slW+blW)>=fMinSize && (srW+brW)>=fMinSize)
-                 ) {
-
-               if (DoRegression()) {
-                  sepTmp = fRegType->GetSeparationGain(nSelS[ivar][iBin]+nSelB[ivar][iBin],
-                                                       target[ivar][iBin],target2[ivar][iBin],
-                                                       nTotS+nTotB,
-                                                       target[ivar][nBins[ivar]-1],target2[ivar][nBins[ivar]-1]);
-               } else {
-                  sepTmp = fSepType->GetSeparationGain(nSelS[ivar][iBin], nSelB[ivar][iBin], nTotS, nTotB);
-               }
-               if (separationGain[ivar] < sepTmp) {
-                  separationGain[ivar] = sepTmp;
-                  cutIndex[ivar]       = iBin;
-               }
-            }
-         }
+#ifdef R__USE_IMT
+   else {
+      // the variables are independent of each other once the node totals are known: each
+      // task fills, cumulates and scans the histogram of one variable. The sums within a
+      // histogram are done in the same order as in the serial loops, so the resulting tree
+      // does not depend on the threading
+      std::unique_ptr<ROOT::TThreadExecutor> localPool;
+      if (!fPool) localPool.reset(new ROOT::TThreadExecutor());
+      ROOT::TThreadExecutor &pool = fPool ? *fPool : *localPool;
+      pool.Foreach([&](UInt_t ivar) {
+         if (!useVariable[ivar]) return;
+         for (UInt_t iev=0; iev<nevents; iev++) fillVariable(ivar, iev, eventSample[iev]->GetWeight());
+         cumulateVariable(ivar);
+         findBestCut(ivar);
+      }, ROOT::TSeqU(cNvars));
+      for (UInt_t ivar=0; ivar < cNvars; ivar++) {
+         if (useVariable[ivar]) checkVariable(ivar);
       }
    }
+#endif
 
 
    //now you have found the best separation cut for each variable, now compare the variables
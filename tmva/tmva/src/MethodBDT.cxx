@@ -142,6 +142,12 @@ the selection.
 #include "TMatrixTSym.h"
 #include "TObjString.h"
 #include "TGraph.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 #include <algorithm>
 #include <fstream>
@@ -157,6 +163,7 @@ REGISTER_METHOD(BDT)
 ClassImp(TMVA::MethodBDT);
 
    const Int_t TMVA::MethodBDT::fgDebugLevel = 0;
+   const UInt_t TMVA::MethodBDT::fgFlatBlockSize;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// The standard constructor for the "boosted decision trees".
@@ -731,6 +738,7 @@ void TMVA::MethodBDT::Reset( void )
    fForest.clear();
 
    fBoostWeights.clear();
+   ClearFlatForest();
    if (fMonitorNtuple) { fMonitorNtuple->Delete(); fMonitorNtuple=NULL; }
    fVariableImportance.clear();
    fResiduals.clear();
@@ -1136,6 +1144,9 @@ void TMVA::MethodBDT::Train()
 {
    TMVA::DecisionTreeNode::fgIsTraining=true;
 
+   // the flat copy of the forest is rebuilt once training is finished
+   ClearFlatForest();
+
    // fill the STL Vector with the event sample
    // (needs to be done here and cannot be done in "init" as the options need to be
    // known).
@@ -1391,6 +1402,7 @@ void TMVA::MethodBDT::Train()
    }
    TMVA::DecisionTreeNode::fgIsTraining=false;
 
+   BuildFlatForest();
 
    // reset all previously stored/accumulated BOOST weights in the event sample
    //   for (UInt_t iev=0; iev<fEventSample.size(); iev++) fEventSample[iev]->SetBoostWeight(1.);
@@ -1411,29 +1423,142 @@ void TMVA::MethodBDT::Train()
 Double_t TMVA::MethodBDT::GetGradBoostMVA(const TMVA::Event* e, UInt_t nTrees)
 {
    Double_t sum=0;
-   for (UInt_t itree=0; itree<nTrees; itree++) {
-      //loop over all trees in forest
-      sum += fForest[itree]->CheckEvent(e,kFALSE);
+   if (HasFlatForest()) {
+      const Float_t* x = e->GetValues().data();
+      for (UInt_t itree=0; itree<nTrees; itree++) sum += GetFlatTreeResponse(itree, x);
+   }
+   else {
+      for (UInt_t itree=0; itree<nTrees; itree++) {
+         //loop over all trees in forest
+         sum += fForest[itree]->CheckEvent(e,kFALSE);
 
+      }
    }
    return 2.0/(1.0+exp(-2.0*sum))-1; //MVA output between -1 and 1
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the forest into flat node tables (one entry per node, trees stored one
+/// after the other in depth-first order), such that the evaluation walks through
+/// contiguous arrays instead of chasing DecisionTreeNode pointers.
+/// The cut type is folded into the daughter indices, a node is left towards
+/// fFlatChildren[2*inode + (x[selector] >= cut)].
+/// Forests with multivariate (Fisher) cuts are not flattened and keep using
+/// DecisionTree::CheckEvent.
+
+void TMVA::MethodBDT::BuildFlatForest()
+{
+   ClearFlatForest();
+
+   // the same leaf response as used in PrivateGetMvaValue and GetGradBoostMVA
+   const Bool_t useYesNoLeaf = fUseYesNoLeaf && fBoostType!="Grad";
+
+   std::vector<std::pair<const DecisionTreeNode*,Int_t> > stack; // node and slot of its index in fFlatChildren
+   for (UInt_t itree=0; itree<fForest.size(); itree++) {
+      const DecisionTree* dt = fForest[itree];
+      if (!dt || !dt->GetRoot()) {
+         ClearFlatForest();
+         return;
+      }
+      fFlatTreeRoot.push_back(fFlatSelector.size());
+      stack.push_back(std::make_pair(dt->GetRoot(), -1));
+      while (!stack.empty()) {
+         const DecisionTreeNode* node = stack.back().first;
+         Int_t slot = stack.back().second;
+         stack.pop_back();
+
+         UInt_t inode = fFlatSelector.size();
+         if (slot >= 0) fFlatChildren[slot] = inode;
+         fFlatChildren.push_back(0);
+         fFlatChildren.push_back(0);
+         fFlatCutValue.push_back(node->GetCutValue());
+
+         if (node->GetNodeType() != 0) { // leaf node, also in pruned trees
+            fFlatSelector.push_back(-1);
+            if (dt->DoRegression())  fFlatResponse.push_back(node->GetResponse());
+            else if (useYesNoLeaf)   fFlatResponse.push_back(Double_t(node->GetNodeType()));
+            else                     fFlatResponse.push_back(node->GetPurity());
+            continue;
+         }
+
+         const DecisionTreeNode* left  = node->GetLeft();
+         const DecisionTreeNode* right = node->GetRight();
+         if (node->GetNFisherCoeff() != 0 || !left || !right) {
+            Log() << kDEBUG << "Forest cannot be flattened, using the tree nodes for the evaluation" << Endl;
+            ClearFlatForest();
+            return;
+         }
+         fFlatSelector.push_back(node->GetSelector());
+         fFlatResponse.push_back(0);
+         // GoesRight: (x >= cut) == cutType
+         const DecisionTreeNode* below = node->GetCutType() ? left  : right;
+         const DecisionTreeNode* above = node->GetCutType() ? right : left;
+         stack.push_back(std::make_pair(above, Int_t(2*inode+1)));
+         stack.push_back(std::make_pair(below, Int_t(2*inode)));
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the flat copy of the forest.
+
+void TMVA::MethodBDT::ClearFlatForest()
+{
+   fFlatTreeRoot.clear();
+   fFlatSelector.clear();
+   fFlatCutValue.clear();
+   fFlatChildren.clear();
+   fFlatResponse.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Response of tree itree of the flat forest for the input variables x,
+/// identical to fForest[itree]->CheckEvent().
+
+Double_t TMVA::MethodBDT::GetFlatTreeResponse(UInt_t itree, const Float_t* x) const
+{
+   UInt_t inode = fFlatTreeRoot[itree];
+   Int_t ivar;
+   while ((ivar = fFlatSelector[inode]) >= 0)
+      inode = fFlatChildren[2*inode + (x[ivar] >= fFlatCutValue[inode])];
+   return fFlatResponse[inode];
+}
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func for each event of the sample, using the ROOT thread pool if implicit
+/// multi-threading is enabled. func must only modify data belonging to the event.
+
+template <typename F>
+void ForEachEvent(std::vector<const TMVA::Event*>& eventSample, F func)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && eventSample.size() > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(func, eventSample);
+      return;
+   }
+#endif
+   for (auto e : eventSample) func(e);
+}
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate residual for all events.
 
 void TMVA::MethodBDT::UpdateTargets(std::vector<const TMVA::Event*>& eventSample, UInt_t cls)
 {
+   // The update of each event only touches its own residuals and targets, and the map of
+   // residuals is not modified, hence the events can be processed in parallel
    if (DoMulticlass()) {
       UInt_t nClasses = DataInfo().GetNClasses();
-      std::vector<Double_t> expCache;
-      if (cls == nClasses - 1) {
-         expCache.resize(nClasses);
-      }
-      for (auto e : eventSample) {
-         fResiduals[e].at(cls) += fForest.back()->CheckEvent(e, kFALSE);
+      auto update = [&](const TMVA::Event* e) {
+         auto &residualsThisEvent = fResiduals.at(e);
+         residualsThisEvent.at(cls) += fForest.back()->CheckEvent(e, kFALSE);
          if (cls == nClasses - 1) {
-            auto &residualsThisEvent = fResiduals[e];
+            std::vector<Double_t> expCache(nClasses);
             std::transform(residualsThisEvent.begin(),
                            residualsThisEvent.begin() + nClasses,
                            expCache.begin(), [](Double_t d) { return exp(d); });
@@ -1449,15 +1574,17 @@ void TMVA::MethodBDT::UpdateTargets(std::vector<const TMVA::Event*>& eventSample
                const_cast<TMVA::Event *>(e)->SetTarget(i, res);
             }
          }
-      }
+      };
+      ForEachEvent(eventSample, update);
    } else {
-      for (auto e : eventSample) {
-         auto &residualAt0 = fResiduals[e].at(0);
+      auto update = [&](const TMVA::Event* e) {
+         auto &residualAt0 = fResiduals.at(e).at(0);
          residualAt0 += fForest.back()->CheckEvent(e, kFALSE);
          Double_t p_sig = 1.0 / (1.0 + exp(-2.0 * residualAt0));
          Double_t res = (DataInfo().IsSignal(e) ? 1 : 0) - p_sig;
          const_cast<TMVA::Event *>(e)->SetTarget(0, res);
-      }
+      };
+      ForEachEvent(eventSample, update);
    }
 }
 
@@ -1467,9 +1594,9 @@ void TMVA::MethodBDT::UpdateTargets(std::vector<const TMVA::Event*>& eventSample
 void TMVA::MethodBDT::UpdateTargetsRegression(std::vector<const TMVA::Event*>& eventSample, Bool_t first)
 {
    if(!first){
-      for (std::vector<const TMVA::Event*>::const_iterator e=fEventSample.begin(); e!=fEventSample.end();e++) {
-         fLossFunctionEventInfo[*e].predictedValue += fForest.back()->CheckEvent(*e,kFALSE);
-      }
+      ForEachEvent(fEventSample, [&](const TMVA::Event* e) {
+         fLossFunctionEventInfo.at(e).predictedValue += fForest.back()->CheckEvent(e,kFALSE);
+      });
    }
 
    fRegressionLossFunctionBDTG->SetTargets(eventSample, fLossFunctionEventInfo);
@@ -2280,6 +2407,8 @@ void TMVA::MethodBDT::ReadWeightsFromXML(void* parent) {
       fBoostWeights.push_back(boostWeight);
       ch = gTools().GetNextChild(ch);
    }
+
+   BuildFlatForest();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2316,6 +2445,8 @@ void  TMVA::MethodBDT::ReadWeightsFromStream( std::istream& istr )
       fForest.back()->Read(istr, GetTrainingTMVAVersionCode());
       fBoostWeights.push_back(boostWeight);
    }
+
+   BuildFlatForest();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2360,14 +2491,116 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
 
    Double_t myMVA = 0;
    Double_t norm  = 0;
-   for (UInt_t itree=0; itree<nTrees; itree++) {
-      //
-      myMVA += fBoostWeights[itree] * fForest[itree]->CheckEvent(ev,fUseYesNoLeaf);
-      norm  += fBoostWeights[itree];
+   if (HasFlatForest()) {
+      const Float_t* x = ev->GetValues().data();
+      for (UInt_t itree=0; itree<nTrees; itree++) {
+         myMVA += fBoostWeights[itree] * GetFlatTreeResponse(itree, x);
+         norm  += fBoostWeights[itree];
+      }
+   }
+   else {
+      for (UInt_t itree=0; itree<nTrees; itree++) {
+         //
+         myMVA += fBoostWeights[itree] * fForest[itree]->CheckEvent(ev,fUseYesNoLeaf);
+         norm  += fBoostWeights[itree];
+      }
    }
    return ( norm > std::numeric_limits<double>::epsilon() ) ? myMVA /= norm : 0 ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Get the MVA values for a range of events of the current Data type.
+/// The input variables of a block of events are copied into a contiguous buffer
+/// which is evaluated with the flat forest, see GetFlatForestValues.
+
+std::vector<Double_t> TMVA::MethodBDT::GetMvaValues(Long64_t firstEvt, Long64_t lastEvt, Bool_t logProgress)
+{
+   if (!HasFlatForest()) return MethodBase::GetMvaValues(firstEvt, lastEvt, logProgress);
+
+   Long64_t nEvents = Data()->GetNEvents();
+   if (firstEvt > lastEvt || lastEvt > nEvents) lastEvt = nEvents;
+   if (firstEvt < 0) firstEvt = 0;
+   std::vector<Double_t> values(lastEvt-firstEvt);
+   nEvents = values.size();
+
+   Timer timer( nEvents, GetName(), kTRUE );
+
+   if (logProgress)
+      Log() << kHEADER<<Form("[%s] : ",DataInfo().GetName())<< "Evaluation of " << GetMethodName() << " on "
+            << (Data()->GetCurrentType()==Types::kTraining?"training":"testing") << " sample (" << nEvents << " events)" << Endl;
+
+   const UInt_t nVars = GetNvar();
+   std::vector<Float_t> x(fgFlatBlockSize*nVars);
+
+   for (Long64_t first=firstEvt; first<lastEvt; first+=fgFlatBlockSize) {
+      const Long64_t n = std::min(Long64_t(fgFlatBlockSize), lastEvt-first);
+      for (Long64_t i=0; i<n; i++) {
+         Data()->SetCurrentEvent(first+i);
+         const std::vector<Float_t>& vars = GetEvent()->GetValues();
+         std::copy(vars.begin(), vars.begin()+nVars, x.begin()+i*nVars);
+      }
+      GetFlatForestValues(x.data(), n, &values[first-firstEvt]);
+
+      if (logProgress) timer.DrawProgressBar( first+n-firstEvt );
+   }
+
+   if (logProgress) {
+      Log() << kINFO
+            << "Elapsed time for evaluation of " << nEvents <<  " events: "
+            << timer.GetElapsedTime() << "       " << Endl;
+   }
+
+   return values;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate nEvents rows of GetNvar() input variables without using the event
+/// buffers of the method, such that it can be called concurrently.
+/// Only possible with a flat forest and without input variable transformations.
+
+Bool_t TMVA::MethodBDT::EvaluateBatch( const Float_t* inputs, UInt_t nEvents, Double_t* outputs ) const
+{
+   if (!HasFlatForest() || GetTransformationHandler().GetNumOfTransformations() > 0) return kFALSE;
+
+   const UInt_t nVars = GetNvar();
+   for (UInt_t first=0; first<nEvents; first+=fgFlatBlockSize)
+      GetFlatForestValues(inputs+first*nVars, std::min(fgFlatBlockSize, nEvents-first), outputs+first);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// MVA values of nEvents rows of input variables, identical to GetMvaValue().
+/// The forest is applied tree by tree to all rows, such that the node tables
+/// of a tree stay in cache while the rows are processed.
+
+void TMVA::MethodBDT::GetFlatForestValues( const Float_t* x, UInt_t nEvents, Double_t* out ) const
+{
+   const Bool_t isGrad = (fBoostType=="Grad");
+   const UInt_t nVars  = GetNvar();
+   const UInt_t nTrees = fForest.size();
+
+   Double_t norm = 0;
+   for (UInt_t itree=0; itree<nTrees; itree++) norm += fBoostWeights[itree];
+
+   std::fill(out, out+nEvents, 0.);
+   for (UInt_t itree=0; itree<nTrees; itree++) {
+      const Double_t w = isGrad ? 1. : fBoostWeights[itree];
+      for (UInt_t i=0; i<nEvents; i++) out[i] += w * GetFlatTreeResponse(itree, x+i*nVars);
+   }
+
+   for (UInt_t i=0; i<nEvents; i++) {
+      if (fDoPreselection) {
+         Double_t val = ApplyPreselectionCuts(x+i*nVars);
+         if (TMath::Abs(val)>0.05) {
+            out[i] = val;
+            continue;
+         }
+      }
+      if (isGrad) out[i] = 2.0/(1.0+exp(-2.0*out[i]))-1;
+      else        out[i] = ( norm > std::numeric_limits<double>::epsilon() ) ? out[i]/norm : 0;
+   }
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Get the multiclass MVA response for the BDT classifier.
@@ -2384,8 +2617,9 @@ const std::vector<Float_t>& TMVA::MethodBDT::GetMulticlassValues()
    // trees 0, nClasses, 2*nClasses, ... belong to class 0
    // trees 1, nClasses+1, 2*nClasses+1, ... belong to class 1 and so forth
    UInt_t classOfTree = 0;
+   const Float_t* x = HasFlatForest() ? e->GetValues().data() : 0;
    for (UInt_t itree = 0; itree < forestSize; ++itree) {
-      temp[classOfTree] += fForest[itree]->CheckEvent(e, kFALSE);
+      temp[classOfTree] += x ? GetFlatTreeResponse(itree, x) : fForest[itree]->CheckEvent(e, kFALSE);
       if (++classOfTree == nClasses) classOfTree = 0; // cheap modulo
    }
 
@@ -2956,21 +3190,29 @@ void TMVA::MethodBDT::DeterminePreselectionCuts(const std::vector<const TMVA::Ev
 /// Decision Trees  in the GetMVA .. --> -1 for background +1 for Signal
 
 Double_t TMVA::MethodBDT::ApplyPreselectionCuts(const Event* ev)
+{
+   return ApplyPreselectionCuts(ev->GetValues().data());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Apply the preselection cuts to a row of input variables.
+
+Double_t TMVA::MethodBDT::ApplyPreselectionCuts(const Float_t* x) const
 {
    Double_t result=0;
 
    for (UInt_t ivar=0; ivar < GetNvar(); ivar++ ) { // loop over all discriminating variables
       if (fIsLowBkgCut[ivar]){
-         if (ev->GetValue(ivar) < fLowBkgCut[ivar]) result = -1;  // is background
+         if (x[ivar] < fLowBkgCut[ivar]) result = -1;  // is background
       }
       if (fIsLowSigCut[ivar]){
-         if (ev->GetValue(ivar) < fLowSigCut[ivar]) result =  1;  // is signal
+         if (x[ivar] < fLowSigCut[ivar]) result =  1;  // is signal
       }
       if (fIsHighBkgCut[ivar]){
-         if (ev->GetValue(ivar) > fHighBkgCut[ivar]) result = -1;  // is background
+         if (x[ivar] > fHighBkgCut[ivar]) result = -1;  // is background
       }
       if (fIsHighSigCut[ivar]){
-         if (ev->GetValue(ivar) > fHighSigCut[ivar]) result =  1;  // is signal
+         if (x[ivar] > fHighSigCut[ivar]) result =  1;  // is signal
       }
    }
 
@@ -458,12 +458,10 @@ void TMVA::MethodDNN::ProcessOptions()
    if (fArchitectureString == "CPU") {
 #ifndef DNNCPU // Included only if DNNCPU flag is _not_ set.
       Log() << kERROR << "Multi-core CPU backend not enabled. Please make sure "
-                         "you have a BLAS implementation and it was successfully "
-                         "detected by CMake as well that the imt CMake flag is set."
+                         "that the imt CMake flag is set."
             << Endl;
       Log() << kFATAL << "Multi-core CPU backend not enabled. Please make sure "
-                         "you have a BLAS implementation and it was successfully "
-                         "detected by CMake as well that the imt CMake flag is set."
+                         "that the imt CMake flag is set."
             << Endl;
 #endif // DNNCPU
    }
@@ -1141,8 +1139,7 @@ void TMVA::MethodDNN::TrainCpu()
 
 #else // DNNCPU flag not set.
    Log() << kFATAL << "Multi-core CPU backend not enabled. Please make sure "
-                      "you have a BLAS implementation and it was successfully "
-                      "detected by CMake as well that the imt CMake flag is set." << Endl;
+                      "that the imt CMake flag is set." << Endl;
 #endif // DNNCPU
 }
 
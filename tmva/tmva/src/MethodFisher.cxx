@@ -279,6 +279,24 @@ Double_t TMVA::MethodFisher::GetMvaValue( Double_t* err, Double_t* errUpper )
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the Fisher values of nEvents rows of input variables; not possible
+/// if the input variables are transformed.
+
+Bool_t TMVA::MethodFisher::EvaluateBatch( const Float_t* inputs, UInt_t nEvents, Double_t* outputs ) const
+{
+   if (GetTransformationHandler().GetNumOfTransformations() > 0) return kFALSE;
+
+   const UInt_t nVars = GetNvar();
+   for (UInt_t iev=0; iev<nEvents; iev++) {
+      const Float_t* x = inputs + iev*nVars;
+      Double_t result = fF0;
+      for (UInt_t ivar=0; ivar<nVars; ivar++) result += (*fFisherCoeff)[ivar]*x[ivar];
+      outputs[iev] = result;
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// initialization method; creates global matrices and vectors
 
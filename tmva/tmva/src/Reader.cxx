@@ -114,6 +114,7 @@
 #include "TXMLEngine.h"
 #include "TMath.h"
 
+#include <algorithm>
 #include <cstdlib>
 
 #include <string>
@@ -576,6 +577,94 @@ Double_t TMVA::Reader::EvaluateMVA( MethodBase* method, Double_t aux )
                                (fCalculateError?&fMvaEventErrorUpper:0) );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the MVA for a block of nEvents events.
+///
+/// The input variables are given in the order of AddVariable, either row by row
+/// (inputs[ievt*nvar+ivar]) or, if columnar is true, column by column
+/// (inputs[ivar*nEvents+ievt]); outputs must hold nEvents values.
+/// Events with NaN input variables get the MVA value -999.
+///
+/// Methods which can evaluate without their internal event buffers (see
+/// MethodBase::EvaluateBatch, e.g. BDT and Fisher without variable transformations)
+/// are evaluated concurrently when called from several threads. All other methods,
+/// in particular MLP and DNN and any method with variable transformations, write
+/// intermediate results into the method object: they are evaluated event by event
+/// under a lock of the Reader, hence calls from several threads are serialised and
+/// do not run faster than a single thread. The per-event error is not calculated.
+
+void TMVA::Reader::EvaluateMVA( const Float_t* inputs, UInt_t nEvents, Double_t* outputs, const TString& methodTag,
+                                Bool_t columnar, Double_t aux ) const
+{
+   std::map<TString, IMethod*>::const_iterator it = fMethodMap.find( methodTag );
+   MethodBase* meth = (it != fMethodMap.end()) ? dynamic_cast<TMVA::MethodBase*>(it->second) : 0;
+   if (meth==0) {
+      std::fill(outputs, outputs+nEvents, 0.);
+      // the message logger of the Reader is shared by all the threads
+      std::lock_guard<std::mutex> lock(fEvalMutex);
+      Log() << kERROR << "Method " << methodTag << " not found!" << Endl;
+      return;
+   }
+
+   // the methods take the input variables row by row
+   const UInt_t nVars = DataInfo().GetNVariables();
+   std::vector<Float_t> rows;
+   const Float_t* x = inputs;
+   if (columnar) {
+      rows.resize(nEvents*nVars);
+      for (UInt_t ivar=0; ivar<nVars; ivar++)
+         for (UInt_t ievt=0; ievt<nEvents; ievt++) rows[ievt*nVars+ivar] = inputs[ivar*nEvents+ievt];
+      x = rows.data();
+   }
+
+   std::vector<Char_t> isNaN(nEvents, kFALSE);
+   UInt_t nNaN = 0;
+   for (UInt_t ievt=0; ievt<nEvents; ievt++) {
+      for (UInt_t ivar=0; ivar<nVars; ivar++) {
+         if (TMath::IsNaN(x[ievt*nVars+ivar])) {
+            isNaN[ievt] = kTRUE;
+            nNaN++;
+            break;
+         }
+      }
+   }
+
+   if (meth->GetMethodType() == TMVA::Types::kCuts || !meth->EvaluateBatch( x, nEvents, outputs )) {
+      std::lock_guard<std::mutex> lock(fEvalMutex);
+      if (meth->GetMethodType() == TMVA::Types::kCuts) {
+         TMVA::MethodCuts* mc = dynamic_cast<TMVA::MethodCuts*>(meth);
+         if(mc)
+            mc->SetTestSignalEfficiency( aux );
+      }
+      std::vector<Float_t> inputVec(nVars);
+      for (UInt_t ievt=0; ievt<nEvents; ievt++) {
+         if (isNaN[ievt]) continue;
+         std::copy(x+ievt*nVars, x+(ievt+1)*nVars, inputVec.begin());
+         Event tmpEvent(inputVec, nVars);
+         outputs[ievt] = meth->GetMvaValue( &tmpEvent );
+      }
+   }
+
+   if (nNaN > 0) {
+      for (UInt_t ievt=0; ievt<nEvents; ievt++) if (isNaN[ievt]) outputs[ievt] = -999;
+      std::lock_guard<std::mutex> lock(fEvalMutex);
+      Log() << kERROR << nNaN << " events with NaN variables --> return MVA value -999, \n that's all I can do, please fix or remove these events." << Endl;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the MVA for a block of events stored in a vector, see above;
+/// outputs is resized to the number of events.
+
+void TMVA::Reader::EvaluateMVA( const std::vector<Float_t>& inputs, std::vector<Double_t>& outputs, const TString& methodTag,
+                                Bool_t columnar, Double_t aux ) const
+{
+   const UInt_t nVars = DataInfo().GetNVariables();
+   const UInt_t nEvents = (nVars > 0) ? inputs.size()/nVars : 0;
+   outputs.resize(nEvents);
+   EvaluateMVA( inputs.data(), nEvents, outputs.data(), methodTag, columnar, aux );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// evaluates MVA for given set of input variables
 
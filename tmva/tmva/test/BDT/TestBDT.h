@@ -0,0 +1,139 @@
+// @(#)root/tmva/tmva/test:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/////////////////////////////////////////////////////////////////////
+// Toy data and BDT training through the Factory for the BDT tests. //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef TMVA_TEST_BDT_TESTBDT
+#define TMVA_TEST_BDT_TESTBDT
+
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include "TMVA/DataLoader.h"
+#include "TMVA/DecisionTree.h"
+#include "TMVA/DecisionTreeNode.h"
+#include "TMVA/Factory.h"
+#include "TMVA/MethodBDT.h"
+#include "TMVA/Types.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace TMVA
+{
+namespace Test
+{
+
+const UInt_t kNVars = 4;
+
+/** Fill a tree with nEvents events of kNVars gaussian variables x0..x3 centred
+ *  at 'shift', and a regression target y depending non-linearly on them. */
+//______________________________________________________________________________
+inline TTree *MakeToyTree(const char *name, Double_t shift, UInt_t nEvents, UInt_t seed)
+{
+   TDirectory::TContext ctx(gROOT);
+   TTree *tree = new TTree(name, name);
+   Float_t x[kNVars], y;
+   for (UInt_t ivar = 0; ivar < kNVars; ivar++)
+      tree->Branch(Form("x%u", ivar), &x[ivar], Form("x%u/F", ivar));
+   tree->Branch("y", &y, "y/F");
+
+   TRandom3 rnd(seed);
+   for (UInt_t iev = 0; iev < nEvents; iev++) {
+      for (UInt_t ivar = 0; ivar < kNVars; ivar++)
+         x[ivar] = rnd.Gaus(shift * (ivar + 1) / kNVars, 1.);
+      y = x[0] * x[1] + TMath::Sin(x[2]) + 0.5 * x[3] + rnd.Gaus(0, 0.1);
+      tree->Fill();
+   }
+   return tree;
+}
+
+/** A BDT trained through a Factory on toy data, for the analysis types
+ *  "Classification", "Regression" and "Multiclass". The factory, and with it
+ *  the trained method, lives as long as this object. */
+class TTrainedBDT {
+private:
+   std::vector<std::unique_ptr<TTree>> fTrees;
+   std::unique_ptr<TFile> fOutput;
+   std::unique_ptr<TMVA::DataLoader> fLoader;
+   std::unique_ptr<TMVA::Factory> fFactory;
+   TMVA::MethodBDT *fMethod = nullptr;
+   TString fJobName;
+
+public:
+   TTrainedBDT(const TString &jobName, const TString &analysisType, const TString &options, UInt_t nEvents = 4000)
+      : fJobName(jobName)
+   {
+      fOutput.reset(TFile::Open(jobName + ".root", "RECREATE"));
+      fLoader.reset(new TMVA::DataLoader(jobName));
+      fFactory.reset(new TMVA::Factory(jobName, fOutput.get(), "!V:Silent:!DrawProgressBar:AnalysisType=" + analysisType));
+
+      for (UInt_t ivar = 0; ivar < kNVars; ivar++)
+         fLoader->AddVariable(Form("x%u", ivar), 'F');
+
+      if (analysisType == "Regression") {
+         fLoader->AddTarget("y");
+         fTrees.emplace_back(MakeToyTree("reg", 0., nEvents, 1));
+         fLoader->AddRegressionTree(fTrees.back().get());
+      } else if (analysisType == "Multiclass") {
+         for (UInt_t icls = 0; icls < 3; icls++) {
+            fTrees.emplace_back(MakeToyTree(Form("class%u", icls), icls - 1., nEvents, icls + 1));
+            fLoader->AddTree(fTrees.back().get(), Form("class%u", icls));
+         }
+      } else {
+         fTrees.emplace_back(MakeToyTree("sig", 0.5, nEvents, 1));
+         fLoader->AddSignalTree(fTrees.back().get());
+         fTrees.emplace_back(MakeToyTree("bkg", -0.5, nEvents, 2));
+         fLoader->AddBackgroundTree(fTrees.back().get());
+      }
+      fLoader->PrepareTrainingAndTestTree("", "SplitMode=Random:SplitSeed=100:NormMode=NumEvents:!V");
+
+      fMethod = dynamic_cast<TMVA::MethodBDT *>(fFactory->BookMethod(fLoader.get(), TMVA::Types::kBDT, "BDT", options));
+      fFactory->TrainAllMethods();
+   }
+
+   ~TTrainedBDT()
+   {
+      fOutput->Close();
+      fFactory.reset();
+      fLoader.reset();
+   }
+
+   TMVA::MethodBDT *GetMethod() const { return fMethod; }
+
+   /** The weight file written by the training, for the Reader. */
+   TString GetWeightFile() const { return fJobName + "/weights/" + fJobName + "_BDT.weights.xml"; }
+};
+
+/** Compare two (sub)trees node by node. */
+//______________________________________________________________________________
+inline bool SameNodes(const TMVA::DecisionTreeNode *a, const TMVA::DecisionTreeNode *b)
+{
+   if (!a || !b)
+      return a == b;
+   if (a->GetNodeType() != b->GetNodeType() || a->GetSelector() != b->GetSelector() ||
+       a->GetCutValue() != b->GetCutValue() || a->GetCutType() != b->GetCutType() ||
+       a->GetPurity() != b->GetPurity() || a->GetResponse() != b->GetResponse() ||
+       a->GetNFisherCoeff() != b->GetNFisherCoeff())
+      return false;
+   return SameNodes(a->GetLeft(), b->GetLeft()) && SameNodes(a->GetRight(), b->GetRight());
+}
+
+} // namespace Test
+} // namespace TMVA
+
+#endif
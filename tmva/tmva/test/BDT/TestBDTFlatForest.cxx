@@ -0,0 +1,90 @@
+// @(#)root/tmva/tmva/test:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+///////////////////////////////////////////////////////////////////////
+// Test that the flat BDT forest gives the response of the tree nodes. //
+///////////////////////////////////////////////////////////////////////
+
+#include "TMVA/Event.h"
+#include "TestBDT.h"
+
+using namespace TMVA::Test;
+
+/** Append to 'points' copies of 'x' placed exactly on each cut of the tree. */
+//______________________________________________________________________________
+void addCutPoints(const TMVA::DecisionTreeNode *node, const std::vector<Float_t> &x,
+                  std::vector<std::vector<Float_t>> &points)
+{
+   if (!node || node->GetNodeType() != 0)
+      return;
+   std::vector<Float_t> p(x);
+   p[node->GetSelector()] = node->GetCutValue();
+   points.push_back(p);
+   addCutPoints(node->GetLeft(), x, points);
+   addCutPoints(node->GetRight(), x, points);
+}
+
+/** Compare the response of each flat tree with DecisionTree::CheckEvent on
+ *  random points and on points lying on the cuts. */
+//______________________________________________________________________________
+bool testFlatForest(const TString &analysisType, const TString &options, Bool_t useYesNoLeaf)
+{
+   TTrainedBDT bdt("TestBDTFlat" + analysisType, analysisType, options);
+   TMVA::MethodBDT *method = bdt.GetMethod();
+   const std::vector<TMVA::DecisionTree *> &forest = method->GetForest();
+   if (!method->HasFlatForest()) {
+      std::cout << analysisType << ": no flat forest was built" << std::endl;
+      return false;
+   }
+
+   TRandom3 rnd(4711);
+   std::vector<std::vector<Float_t>> points;
+   for (UInt_t i = 0; i < 1000; i++) {
+      std::vector<Float_t> x(kNVars);
+      for (UInt_t ivar = 0; ivar < kNVars; ivar++)
+         x[ivar] = rnd.Gaus(0, 1.5);
+      points.push_back(x);
+   }
+   for (UInt_t itree = 0; itree < forest.size() && itree < 5; itree++)
+      addCutPoints(forest[itree]->GetRoot(), points[itree], points);
+
+   for (const std::vector<Float_t> &x : points) {
+      TMVA::Event ev(x, 0);
+      for (UInt_t itree = 0; itree < forest.size(); itree++) {
+         Double_t flat = method->GetFlatTreeResponse(itree, x.data());
+         Double_t nodes = forest[itree]->CheckEvent(&ev, useYesNoLeaf);
+         if (flat != nodes) {
+            std::cout << analysisType << ": tree " << itree << " gives " << flat << " instead of " << nodes
+                      << std::endl;
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+int main()
+{
+   std::cout << "Testing the flat BDT forest:" << std::endl;
+
+   bool ok = true;
+   ok &= testFlatForest("Classification", "!H:!V:NTrees=50:BoostType=AdaBoost:MaxDepth=4:nCuts=20", kTRUE);
+   ok &= testFlatForest("Classification",
+                        "!H:!V:NTrees=50:BoostType=AdaBoost:MaxDepth=4:nCuts=20:UseYesNoLeaf=False", kFALSE);
+   ok &= testFlatForest("Classification", "!H:!V:NTrees=50:BoostType=Grad:Shrinkage=0.1:MaxDepth=3:nCuts=20",
+                        kFALSE);
+   ok &= testFlatForest("Regression",
+                        "!H:!V:NTrees=50:BoostType=AdaBoostR2:MaxDepth=4:nCuts=20:SeparationType=RegressionVariance",
+                        kFALSE);
+   ok &= testFlatForest("Multiclass", "!H:!V:NTrees=20:BoostType=Grad:Shrinkage=0.1:MaxDepth=3:nCuts=20", kFALSE);
+
+   std::cout << (ok ? "Flat forest matches the trees." : "Flat forest differs from the trees.") << std::endl;
+   return ok ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+// @(#)root/tmva/tmva/test:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////////
+// Test that BDT training with implicit multi-threading gives the same //
+// trees as serial training.                                           //
+////////////////////////////////////////////////////////////////////////
+
+#include "RConfigure.h"
+#include "TestBDT.h"
+
+using namespace TMVA::Test;
+
+/** Train the same BDT with and without implicit multi-threading and
+ *  compare the forests node by node. */
+//______________________________________________________________________________
+bool testTrainingMT(const TString &analysisType, const TString &options)
+{
+   ROOT::DisableImplicitMT();
+   TTrainedBDT serial("TestBDTSerial" + analysisType, analysisType, options, 10000);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   TTrainedBDT parallel("TestBDTMT" + analysisType, analysisType, options, 10000);
+   ROOT::DisableImplicitMT();
+
+   const std::vector<TMVA::DecisionTree *> &forest1 = serial.GetMethod()->GetForest();
+   const std::vector<TMVA::DecisionTree *> &forest2 = parallel.GetMethod()->GetForest();
+   if (forest1.empty() || forest1.size() != forest2.size()) {
+      std::cout << analysisType << ": forests have " << forest1.size() << " and " << forest2.size() << " trees"
+                << std::endl;
+      return false;
+   }
+   for (size_t itree = 0; itree < forest1.size(); itree++) {
+      if (!SameNodes(forest1[itree]->GetRoot(), forest2[itree]->GetRoot())) {
+         std::cout << analysisType << ": tree " << itree << " differs" << std::endl;
+         return false;
+      }
+   }
+   if (serial.GetMethod()->GetBoostWeights() != parallel.GetMethod()->GetBoostWeights()) {
+      std::cout << analysisType << ": boost weights differ" << std::endl;
+      return false;
+   }
+   return true;
+}
+
+int main()
+{
+   std::cout << "Testing BDT training with implicit multi-threading:" << std::endl;
+
+   bool ok = true;
+   ok &= testTrainingMT("Classification", "!H:!V:NTrees=20:BoostType=AdaBoost:MaxDepth=4:nCuts=20");
+   ok &= testTrainingMT("Classification", "!H:!V:NTrees=20:BoostType=Grad:Shrinkage=0.1:MaxDepth=3:nCuts=20");
+   ok &= testTrainingMT("Regression",
+                        "!H:!V:NTrees=20:BoostType=Grad:Shrinkage=0.1:MaxDepth=3:nCuts=20:SeparationType=RegressionVariance");
+   ok &= testTrainingMT("Multiclass", "!H:!V:NTrees=10:BoostType=Grad:Shrinkage=0.1:MaxDepth=3:nCuts=20");
+
+   std::cout << (ok ? "Identical forests." : "Forests differ.") << std::endl;
+   return ok ? 0 : 1;
+}
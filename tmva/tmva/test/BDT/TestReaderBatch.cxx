@@ -0,0 +1,116 @@
+// @(#)root/tmva/tmva/test:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////////
+// Test the block evaluation of the Reader against the per-event call, //
+// also when it is called from several threads at once.                //
+////////////////////////////////////////////////////////////////////////
+
+#include "TMVA/Reader.h"
+#include "TestBDT.h"
+
+#include <thread>
+
+using namespace TMVA::Test;
+
+/** Compare two lists of MVA values. */
+//______________________________________________________________________________
+bool sameValues(const char *what, const std::vector<Double_t> &values, const std::vector<Double_t> &expected)
+{
+   for (size_t i = 0; i < expected.size(); i++) {
+      if (TMath::Abs(values[i] - expected[i]) > 1e-12 * (1. + TMath::Abs(expected[i]))) {
+         std::cout << what << ": event " << i << " has " << values[i] << " instead of " << expected[i] << std::endl;
+         return false;
+      }
+   }
+   return true;
+}
+
+/** Train a BDT, read it back with a Reader and compare the block evaluation,
+ *  row by row, column by column and from several threads, with EvaluateMVA
+ *  called event by event. */
+//______________________________________________________________________________
+bool testReaderBatch(const TString &jobName, const TString &options)
+{
+   TString weightFile;
+   {
+      TTrainedBDT bdt(jobName, "Classification", options);
+      weightFile = bdt.GetWeightFile();
+   }
+
+   TMVA::Reader reader("!Color:Silent");
+   Float_t vars[kNVars];
+   for (UInt_t ivar = 0; ivar < kNVars; ivar++)
+      reader.AddVariable(Form("x%u", ivar), &vars[ivar]);
+   if (!reader.BookMVA("BDT", weightFile)) {
+      std::cout << jobName << ": cannot book " << weightFile << std::endl;
+      return false;
+   }
+
+   const UInt_t nEvents = 5000;
+   TRandom3 rnd(4711);
+   std::vector<Float_t> rows(nEvents * kNVars), columns(nEvents * kNVars);
+   for (UInt_t ievt = 0; ievt < nEvents; ievt++) {
+      for (UInt_t ivar = 0; ivar < kNVars; ivar++) {
+         Float_t x = rnd.Gaus(0, 1.5);
+         rows[ievt * kNVars + ivar] = x;
+         columns[ivar * nEvents + ievt] = x;
+      }
+   }
+
+   // reference: one event at a time through the registered variables
+   std::vector<Double_t> expected(nEvents);
+   for (UInt_t ievt = 0; ievt < nEvents; ievt++) {
+      std::copy(&rows[ievt * kNVars], &rows[(ievt + 1) * kNVars], vars);
+      expected[ievt] = reader.EvaluateMVA("BDT");
+   }
+
+   bool ok = true;
+   std::vector<Double_t> values;
+   reader.EvaluateMVA(rows, values, "BDT");
+   ok &= sameValues(jobName + " rows", values, expected);
+   reader.EvaluateMVA(columns, values, "BDT", kTRUE);
+   ok &= sameValues(jobName + " columns", values, expected);
+
+   // several threads evaluating interleaved blocks with the same reader
+   const UInt_t nThreads = 4;
+   const UInt_t blockSize = 100;
+   std::vector<Double_t> concurrent(nEvents);
+   std::vector<std::thread> threads;
+   for (UInt_t ithread = 0; ithread < nThreads; ithread++) {
+      threads.emplace_back([&, ithread]() {
+         for (UInt_t first = ithread * blockSize; first < nEvents; first += nThreads * blockSize) {
+            UInt_t n = std::min(blockSize, nEvents - first);
+            reader.EvaluateMVA(&rows[first * kNVars], n, &concurrent[first], "BDT");
+         }
+      });
+   }
+   for (auto &t : threads)
+      t.join();
+   ok &= sameValues(jobName + " threads", concurrent, expected);
+
+   return ok;
+}
+
+int main()
+{
+   std::cout << "Testing the block evaluation of the Reader:" << std::endl;
+
+   bool ok = true;
+   // evaluated with MethodBDT::EvaluateBatch on the flat forest
+   ok &= testReaderBatch("TestReaderBatch", "!H:!V:NTrees=50:BoostType=AdaBoost:MaxDepth=4:nCuts=20");
+   ok &= testReaderBatch("TestReaderBatchGrad", "!H:!V:NTrees=50:BoostType=Grad:Shrinkage=0.1:MaxDepth=3:nCuts=20");
+   // with a variable transformation the events are evaluated one by one under the reader's lock
+   ok &= testReaderBatch("TestReaderBatchDeco",
+                         "!H:!V:NTrees=50:BoostType=AdaBoost:MaxDepth=4:nCuts=20:VarTransform=D");
+
+   std::cout << (ok ? "Block evaluation matches." : "Block evaluation differs.") << std::endl;
+   return ok ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+// @(#)root/tmva $Id$
+
+/*************************************************************************
+ * Copyright (C) 2016, Simon Pfreundschuh                                *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////
+// Test the built-in BLAS kernels of the CPU backend against      //
+// naive reference implementations and time the blocked matrix    //
+// multiplication against the naive triple loop.                  //
+////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "TRandom3.h"
+#include "TMVA/DNN/Architectures/Cpu/Blas.h"
+
+using namespace TMVA::DNN;
+
+//______________________________________________________________________________
+template <typename Real_t>
+void fillRandom(std::vector<Real_t> & v, TRandom & rand)
+{
+   for (auto & x : v) x = rand.Uniform(-1, 1);
+}
+
+//______________________________________________________________________________
+template <typename Real_t>
+Real_t maximumRelativeError(const std::vector<Real_t> & a, const std::vector<Real_t> & b)
+{
+   Real_t error = 0;
+   for (size_t i = 0; i < a.size(); i++) {
+      Real_t diff = std::abs(a[i] - b[i]);
+      Real_t norm = std::max(std::abs(b[i]), Real_t(1));
+      error = std::max(error, diff / norm);
+   }
+   return error;
+}
+
+/** C = alpha * op(A) * op(B) + beta * C, column-major, computed with the
+ *  naive triple loop. */
+//______________________________________________________________________________
+template <typename Real_t>
+void referenceGemm(bool transA, bool transB, int m, int n, int k, Real_t alpha,
+                   const Real_t * A, int lda, const Real_t * B, int ldb,
+                   Real_t beta, Real_t * C, int ldc)
+{
+   for (int j = 0; j < n; j++) {
+      for (int i = 0; i < m; i++) {
+         Real_t sum = 0;
+         for (int p = 0; p < k; p++) {
+            Real_t a = transA ? A[p + i * lda] : A[i + p * lda];
+            Real_t b = transB ? B[j + p * ldb] : B[p + j * ldb];
+            sum += a * b;
+         }
+         C[i + j * ldc] = alpha * sum + beta * C[i + j * ldc];
+      }
+   }
+}
+
+/** Compare the built-in Gemm with the reference for all transpose
+ *  combinations, with sizes that are not multiples of the block sizes and
+ *  leading dimensions larger than the number of rows. */
+//______________________________________________________________________________
+template <typename Real_t>
+Real_t testGemm(TRandom & rand)
+{
+   const int m = 300, n = 261, k = 517;
+   Real_t error = 0;
+   for (char ta : {'n', 't'}) {
+      for (char tb : {'n', 't'}) {
+         bool transA = (ta == 't'), transB = (tb == 't');
+         int lda = (transA ? k : m) + 3;
+         int ldb = (transB ? n : k) + 5;
+         int ldc = m + 7;
+         std::vector<Real_t> A(lda * (transA ? m : k)), B(ldb * (transB ? k : n));
+         std::vector<Real_t> C(ldc * n);
+         fillRandom(A, rand);
+         fillRandom(B, rand);
+         fillRandom(C, rand);
+         std::vector<Real_t> reference(C);
+
+         for (Real_t beta : {Real_t(0), Real_t(1), Real_t(0.5)}) {
+            Real_t alpha = 1.5;
+            referenceGemm(transA, transB, m, n, k, alpha, A.data(), lda, B.data(), ldb,
+                          beta, reference.data(), ldc);
+            Blas::Builtin::Gemm(&ta, &tb, &m, &n, &k, &alpha, A.data(), &lda, B.data(), &ldb,
+                                &beta, C.data(), &ldc);
+            error = std::max(error, maximumRelativeError(C, reference));
+            // continue from the same C for the next beta
+            C = reference;
+         }
+      }
+   }
+   return error;
+}
+
+/** Compare the built-in Gemv, Ger and Axpy with the reference loops. */
+//______________________________________________________________________________
+template <typename Real_t>
+Real_t testLevel2(TRandom & rand)
+{
+   const int m = 37, n = 23, lda = 41, inc = 1;
+   Real_t alpha = 0.75, beta = 0.5;
+   std::vector<Real_t> A(lda * n), x(std::max(m, n)), y(std::max(m, n));
+   fillRandom(A, rand);
+   fillRandom(x, rand);
+   fillRandom(y, rand);
+   Real_t error = 0;
+
+   for (char t : {'n', 't'}) {
+      bool trans = (t == 't');
+      int ny = trans ? n : m, nx = trans ? m : n;
+      std::vector<Real_t> result(y), reference(y);
+      for (int i = 0; i < ny; i++) {
+         Real_t sum = 0;
+         for (int j = 0; j < nx; j++) sum += (trans ? A[j + i * lda] : A[i + j * lda]) * x[j];
+         reference[i] = alpha * sum + beta * y[i];
+      }
+      Blas::Builtin::Gemv(&t, &m, &n, &alpha, A.data(), &lda, x.data(), &inc, &beta, result.data(), &inc);
+      error = std::max(error, maximumRelativeError(result, reference));
+   }
+
+   std::vector<Real_t> result(A), reference(A);
+   for (int j = 0; j < n; j++)
+      for (int i = 0; i < m; i++) reference[i + j * lda] += alpha * x[i] * y[j];
+   Blas::Builtin::Ger(&m, &n, &alpha, x.data(), &inc, y.data(), &inc, result.data(), &lda);
+   error = std::max(error, maximumRelativeError(result, reference));
+
+   std::vector<Real_t> sum(y), sumReference(y);
+   for (int i = 0; i < m; i++) sumReference[i] += alpha * x[i];
+   Blas::Builtin::Axpy(&m, &alpha, x.data(), &inc, sum.data(), &inc);
+   error = std::max(error, maximumRelativeError(sum, sumReference));
+
+   return error;
+}
+
+/** Time the blocked Gemm and the naive triple loop for a product of the
+ *  size of a typical hidden layer with a batch of events. */
+//______________________________________________________________________________
+template <typename Real_t>
+void benchmarkGemm(TRandom & rand)
+{
+   const int m = 256, n = 512, k = 512;
+   const char t = 'n';
+   Real_t alpha = 1, beta = 0;
+   std::vector<Real_t> A(m * k), B(k * n), C(m * n);
+   fillRandom(A, rand);
+   fillRandom(B, rand);
+
+   auto start = std::chrono::steady_clock::now();
+   Blas::Builtin::Gemm(&t, &t, &m, &n, &k, &alpha, A.data(), &m, B.data(), &k, &beta, C.data(), &m);
+   double blocked = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+   start = std::chrono::steady_clock::now();
+   referenceGemm(false, false, m, n, k, alpha, A.data(), m, B.data(), k, beta, C.data(), m);
+   double naive = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+   std::cout << "Gemm " << m << "x" << k << " * " << k << "x" << n << ": blocked " << blocked
+             << " ms, naive " << naive << " ms" << std::endl;
+}
+
+int main()
+{
+   TRandom3 rand(1);
+
+   std::cout << "Testing built-in BLAS kernels (double):" << std::endl;
+   double error = testGemm<Double_t>(rand);
+   std::cout << "Gemm:           " << "Max. rel. error: " << error << std::endl;
+   if (error > 1e-10)
+      return 1;
+
+   error = testLevel2<Double_t>(rand);
+   std::cout << "Gemv, Ger, Axpy: " << "Max. rel. error: " << error << std::endl;
+   if (error > 1e-10)
+      return 1;
+
+   std::cout << "Testing built-in BLAS kernels (float):" << std::endl;
+   error = testGemm<Real_t>(rand);
+   std::cout << "Gemm:           " << "Max. rel. error: " << error << std::endl;
+   if (error > 1e-3)
+      return 1;
+
+   error = testLevel2<Real_t>(rand);
+   std::cout << "Gemv, Ger, Axpy: " << "Max. rel. error: " << error << std::endl;
+   if (error > 1e-4)
+      return 1;
+
+   benchmarkGemm<Real_t>(rand);
+   benchmarkGemm<Double_t>(rand);
+
+   return 0;
+}
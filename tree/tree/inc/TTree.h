@@ -217,7 +217,8 @@ public:
    // TTree status bits
    enum {
       kForceRead   = BIT(11),
-      kCircular    = BIT(12)
+      kCircular    = BIT(12),
+      kRecycleObjects = BIT(14)
    };
 
    // Split level modifier
@@ -547,6 +548,7 @@ public:
    virtual void            SetObject(const char* name, const char* title);
    virtual void            SetParallelUnzip(Bool_t opt=kTRUE, Float_t RelSize=-1);
    virtual void            SetPerfStats(TVirtualPerfStats* perf);
+   virtual void            SetRecycleObjects(Bool_t recycle = kTRUE);
    virtual void            SetScanField(Int_t n = 50) { fScanField = n; } // *MENU*
    virtual void            SetTimerInterval(Int_t msec = 333) { fTimerInterval=msec; }
    virtual void            SetTreeIndex(TVirtualIndex* index);
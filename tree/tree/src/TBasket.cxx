@@ -438,6 +438,11 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
 
+   // Per-branch statistics, reported once the basket is in memory.
+   TVirtualPerfStats *perfStats = fBranch->GetTree()->GetPerfStats();
+   Bool_t cacheMiss = kTRUE;
+   Double_t unzipTime = 0;
+
    // See if the cache has already unzipped the buffer for us.
    TFileCacheRead *pf = nullptr;
    {
@@ -450,6 +455,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       char *buffer = nullptr;
       res = pf->GetUnzipBuffer(&buffer, pos, len, &free);
       if (R__unlikely(res >= 0)) {
+         cacheMiss = kFALSE;
          len = ReadBasketBuffersUnzip(buffer, res, free, file);
          // Note that in the kNotDecompressed case, the above function will return 0;
          // In such a case, we should stop processing
@@ -502,6 +508,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          if (ret) {
             return 1;
          }
+      } else {
+         cacheMiss = kFALSE;
       }
       gPerfStats = temp;
    } else {
@@ -560,7 +568,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
 
       // Optional monitor for zip time profiling.
       Double_t start = 0;
-      if (R__unlikely(gPerfStats)) {
+      if (R__unlikely(gPerfStats || perfStats)) {
          start = TTimeStamp();
       }
 
@@ -599,6 +607,10 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          return 1;
       }
       len = fObjlen+fKeylen;
+      if (R__unlikely(perfStats)) {
+         Double_t tnow = TTimeStamp();
+         unzipTime = tnow - start;
+      }
       TVirtualPerfStats* temp = gPerfStats;
       if (fBranch->GetTree()->GetPerfStats() != 0) gPerfStats = fBranch->GetTree()->GetPerfStats();
       if (R__unlikely(gPerfStats)) {
@@ -613,6 +625,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
 AfterBuffer:
 
    fBranch->GetTree()->IncrementTotalBuffers(fBufferSize);
+   if (R__unlikely(perfStats)) {
+      perfStats->BasketReadEvent(fBranch, fNbytes, fObjlen+fKeylen, unzipTime, cacheMiss);
+   }
 
    // Read offsets table if needed.
    if (!fBranch->GetEntryOffsetLen()) {
@@ -37,8 +37,10 @@
 #include "TTree.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
+#include "TTimeStamp.h"
 #include "TVirtualMutex.h"
 #include "TVirtualPad.h"
+#include "TVirtualPerfStats.h"
 
 #include "TBranchIMTHelper.h"
 
@@ -1313,8 +1315,17 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
       buf->SetBufferOffset(bufbegin);
    }
 
+   buf->SetBit(TBufferFile::kRecycleObjects, fTree->TestBit(TTree::kRecycleObjects));
+
    // Int_t bufbegin = buf->Length();
-   (this->*fReadLeaves)(*buf);
+   TVirtualPerfStats *perfStats = fTree->GetPerfStats();
+   if (R__unlikely(perfStats)) {
+      Double_t start = TTimeStamp();
+      (this->*fReadLeaves)(*buf);
+      perfStats->StreamEvent(this, start);
+   } else {
+      (this->*fReadLeaves)(*buf);
+   }
    return buf->Length() - bufbegin;
 }
 
@@ -1613,6 +1613,8 @@ Long64_t TChain::LoadTree(Long64_t entry)
 
    fTree->SetMakeClass(fMakeClass);
    fTree->SetMaxVirtualSize(fMaxVirtualSize);
+   fTree->SetRecycleObjects(TestBit(kRecycleObjects));
+   if (GetPerfStats()) fTree->SetPerfStats(GetPerfStats());
 
    SetChainOffset(fTreeOffset[fTreeNumber]);
 
@@ -8728,6 +8728,26 @@ void TTree::SetPerfStats(TVirtualPerfStats *perf)
    fPerfStats = perf;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Reuse the memory of the objects pointed to by data members when reading.
+///
+/// When reading an entry, the objects pointed to by data members (without
+/// the '->' comment) are normally deleted and replaced by newly allocated
+/// objects. If recycle is true and the object read has the same class as
+/// the object it replaces, it is instead destructed and constructed again
+/// in the same memory, which saves one delete and one new per object and
+/// entry and the corresponding contention on the allocator when several
+/// threads read in parallel.
+///
+/// The pointers of the objects of the previous entry are then still valid
+/// but point to the objects of the current entry. Like for the default
+/// behaviour, the objects must be owned by a single data member.
+
+void TTree::SetRecycleObjects(Bool_t recycle)
+{
+   SetBit(kRecycleObjects, recycle);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// The current TreeIndex is replaced by the new index.
 /// Note that this function does not delete the previous index.
@@ -24,6 +24,8 @@
 #include <tuple>
 #include <cassert>
 
+class TVirtualPerfStats;
+
 namespace ROOT {
 
 namespace Internal {
@@ -69,6 +71,7 @@ class TLoopManager : public std::enable_shared_from_this<TLoopManager> {
    unsigned int fNStopsReceived{0}; ///< Number of times that a children node signaled to stop processing entries.
    const ELoopType fLoopType; ///< The kind of event loop that is going to be run (e.g. on ROOT files, on no files)
    std::string fToJit; ///< string containing all `BuildAndBook` actions that should be jitted before running
+   TVirtualPerfStats *fPerfStats{nullptr}; ///< Performance statistics attached to the processed tree(s)
 
    void RunEmptySourceMT();
    void RunEmptySource();
@@ -109,6 +112,7 @@ public:
    /// End of recursive chain of calls, does nothing
    void PartialReport() const {}
    void SetTree(std::shared_ptr<TTree> tree) { fTree = tree; }
+   void SetPerfStats(TVirtualPerfStats *perfStats) { fPerfStats = perfStats; }
    void IncrChildrenCount() { ++fNChildren; }
    void StopProcessing() { ++fNStopsReceived; }
    void Jit(const std::string& s) { fToJit.append(s); }
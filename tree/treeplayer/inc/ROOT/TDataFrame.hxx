@@ -57,6 +57,7 @@ public:
    TDataFrame(std::string_view treeName, ::TDirectory *dirPtr, const ColumnNames_t &defaultBranches = {});
    TDataFrame(TTree &tree, const ColumnNames_t &defaultBranches = {});
    TDataFrame(ULong64_t numEntries);
+   void SetPerfStats(TVirtualPerfStats *perfStats);
 };
 
 template <typename FILENAMESCOLL, typename std::enable_if<TTraits::IsContainer<FILENAMESCOLL>::value, int>::type>
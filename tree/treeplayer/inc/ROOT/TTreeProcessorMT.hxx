@@ -19,6 +19,7 @@
 #include "TTreeReader.h"
 #include "TError.h"
 #include "TEntryList.h"
+#include "TVirtualPerfStats.h"
 #include "ROOT/TThreadedObject.hxx"
 
 #include <string.h>
@@ -54,6 +55,7 @@ namespace ROOT {
          unsigned int fCurrentIdx;            ///<! Index of the current file.
          std::vector<TEntryList> fEntryLists; ///< Entry numbers to be processed per tree/file
          TEntryList fCurrentEntryList;        ///< Entry numbers for the current range being processed
+         TVirtualPerfStats *fPerfStats = nullptr; ///<! Perf stats attached to the tree of each slot
 
          ////////////////////////////////////////////////////////////////////////////////
          /// Initialize the file and the tree for this view, first looking for a tree in
@@ -87,6 +89,7 @@ namespace ROOT {
 
             // Do not remove this tree from list of cleanups (thread unsafe)
             fCurrentTree->ResetBit(TObject::kMustCleanup);
+            if (fPerfStats) fCurrentTree->SetPerfStats(fPerfStats);
          }
 
       public:
@@ -96,7 +99,9 @@ namespace ROOT {
          /// \param[in] tn Name of the tree to process. If not provided,
          ///               the implementation will automatically search for a
          ///               tree in the file.
-         TTreeView(std::string_view fn, std::string_view tn) : fTreeName(tn), fCurrentIdx(0)
+         /// \param[in] perfStats Performance statistics attached to the tree of each slot.
+         TTreeView(std::string_view fn, std::string_view tn, TVirtualPerfStats *perfStats = nullptr)
+            : fTreeName(tn), fCurrentIdx(0), fPerfStats(perfStats)
          {
             fFileNames.emplace_back(fn);
             Init();
@@ -108,7 +113,9 @@ namespace ROOT {
          /// \param[in] tn Name of the tree to process. If not provided,
          ///               the implementation will automatically search for a
          ///               tree in the collection of files.
-         TTreeView(const std::vector<std::string_view>& fns, std::string_view tn) : fTreeName(tn), fCurrentIdx(0)
+         /// \param[in] perfStats Performance statistics attached to the tree of each slot.
+         TTreeView(const std::vector<std::string_view>& fns, std::string_view tn, TVirtualPerfStats *perfStats = nullptr)
+            : fTreeName(tn), fCurrentIdx(0), fPerfStats(perfStats)
          {
             if (fns.size() > 0) {
                for (auto& fn : fns)
@@ -124,7 +131,7 @@ namespace ROOT {
          //////////////////////////////////////////////////////////////////////////
          /// Constructor based on a TTree.
          /// \param[in] tree Tree or chain of files containing the tree to process.
-         TTreeView(TTree& tree) : fTreeName(tree.GetName()), fCurrentIdx(0)
+         TTreeView(TTree& tree) : fTreeName(tree.GetName()), fCurrentIdx(0), fPerfStats(tree.GetPerfStats())
          {
             static const TClassRef clRefTChain("TChain");
             if (clRefTChain == tree.IsA()) {
@@ -191,7 +198,7 @@ namespace ROOT {
          //////////////////////////////////////////////////////////////////////////
          /// Copy constructor.
          /// \param[in] view Object to copy.
-         TTreeView(const TTreeView& view) : fTreeName(view.fTreeName), fCurrentIdx(view.fCurrentIdx) 
+         TTreeView(const TTreeView& view) : fTreeName(view.fTreeName), fCurrentIdx(view.fCurrentIdx), fPerfStats(view.fPerfStats)
          {
             for (auto& fn : view.fFileNames)
                fFileNames.emplace_back(fn);
@@ -263,6 +270,7 @@ namespace ROOT {
                TFile *f = TFile::Open(fFileNames[fCurrentIdx].data());
                fCurrentTree = (TTree*)f->Get(fTreeName.data());
                fCurrentTree->ResetBit(TObject::kMustCleanup);
+               if (fPerfStats) fCurrentTree->SetPerfStats(fPerfStats);
                fCurrentFile.reset(f);
             }
          }
@@ -275,8 +283,8 @@ namespace ROOT {
       ROOT::TThreadedObject<ROOT::Internal::TTreeView> treeView; ///<! Threaded object with <file,tree> per thread
 
    public:
-      TTreeProcessorMT(std::string_view filename, std::string_view treename = "");
-      TTreeProcessorMT(const std::vector<std::string_view>& filenames, std::string_view treename = "");
+      TTreeProcessorMT(std::string_view filename, std::string_view treename = "", TVirtualPerfStats *perfStats = nullptr);
+      TTreeProcessorMT(const std::vector<std::string_view>& filenames, std::string_view treename = "", TVirtualPerfStats *perfStats = nullptr);
       TTreeProcessorMT(TTree& tree);
       TTreeProcessorMT(TTree& tree, TEntryList& entries);
  
@@ -24,6 +24,10 @@
 #include "TVirtualPerfStats.h"
 #include "TString.h"
 
+#include <map>
+#include <string>
+#include <vector>
+
 
 class TBrowser;
 class TFile;
@@ -35,7 +39,24 @@ class TGaxis;
 class TText;
 class TTreePerfStats : public TVirtualPerfStats {
 
+public:
+   struct BranchStats_t {
+      Long64_t   fBaskets;       //Number of baskets read
+      Long64_t   fCacheMisses;   //Number of baskets read directly from the file (not found in the cache)
+      Long64_t   fZipBytes;      //Number of compressed bytes read
+      Long64_t   fUnzipBytes;    //Number of uncompressed bytes
+      Long64_t   fEntries;       //Number of entries deserialized
+      Double_t   fUnzipTime;     //Time spent uncompressing the baskets
+      Double_t   fStreamTime;    //Time spent deserializing the entries
+
+      BranchStats_t() : fBaskets(0), fCacheMisses(0), fZipBytes(0), fUnzipBytes(0), fEntries(0),
+                        fUnzipTime(0), fStreamTime(0) {}
+   };
+   typedef std::map<std::string, BranchStats_t> BranchStatsMap_t;
+
 protected:
+   struct BranchStatsSlot_t;     //Per-branch counters of one thread, see GetBranchStatsSlot
+
    Int_t         fTreeCacheSize; //TTreeCache buffer size
    Int_t         fNleaves;       //Number of leaves in the tree
    Int_t         fReadCalls;     //Number of read calls
@@ -58,16 +79,26 @@ protected:
    TStopwatch   *fWatch;         //TStopwatch pointer
    TGaxis       *fRealTimeAxis;  //pointer to TGaxis object showing real-time
    TText        *fHostInfoText;  //Graphics Text object with the fHostInfo data
+   BranchStatsMap_t fBranchStats;//Per-branch counters, keyed by branch name
+   std::vector<BranchStatsSlot_t*> fBranchStatsSlots; //!Counters accumulated by each thread, not merged yet
+   ULong64_t     fBranchStatsId; //!Unique identifier of this object in the thread local slot caches
+
+   BranchStatsSlot_t &GetBranchStatsSlot();
+   void             MergeBranchStats();
 
 public:
    TTreePerfStats();
    TTreePerfStats(const char *name, TTree *T);
    virtual ~TTreePerfStats();
+   virtual void     BasketReadEvent(TObject *branch, Int_t complen, Int_t objlen, Double_t unzipTime, Bool_t cacheMiss);
    virtual void     Browse(TBrowser *b);
    virtual Int_t    DistancetoPrimitive(Int_t px, Int_t py);
    virtual void     Draw(Option_t *option="");
    virtual void     ExecuteEvent(Int_t event, Int_t px, Int_t py);
    virtual void     Finish();
+   const BranchStats_t *GetBranchStats(const char *branchname) const;
+   const BranchStatsMap_t &GetBranchStatsMap() const;
+   TString          GetBranchStatsJSON() const;
    virtual Long64_t GetBytesRead() const {return fBytesRead;}
    virtual Long64_t GetBytesReadExtra() const {return fBytesReadExtra;}
    virtual Double_t GetCpuTime()   const {return fCpuTime;}
@@ -85,6 +116,7 @@ public:
    TStopwatch      *GetStopwatch() const {return fWatch;}
    virtual Int_t    GetTreeCacheSize() const {return fTreeCacheSize;}
    virtual Double_t GetUnzipTime() const {return fUnzipTime; }
+   TTree           *MakeBranchStatsTree(const char *name = "branchstats") const;
    virtual void     Paint(Option_t *chopt="");
    virtual void     Print(Option_t *option="") const;
 
@@ -95,6 +127,7 @@ public:
    virtual void     FileOpenEvent(TFile *, const char *, Double_t) {}
    virtual void     FileReadEvent(TFile *file, Int_t len, Double_t start);
    virtual void     UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen);
+   virtual void     StreamEvent(TObject *branch, Double_t start);
    virtual void     RateEvent(Double_t , Double_t , Long64_t , Long64_t) {}
 
    virtual void     SaveAs(const char *filename="",Option_t *option="") const;
@@ -117,7 +150,7 @@ public:
    virtual void     SetTreeCacheSize(Int_t nbytes) {fTreeCacheSize = nbytes;}
    virtual void     SetUnzipTime(Double_t uztime) {fUnzipTime = uztime;}
 
-   ClassDef(TTreePerfStats,6)  // TTree I/O performance measurement
+   ClassDef(TTreePerfStats,7)  // TTree I/O performance measurement
 };
 
 #endif
@@ -310,6 +310,9 @@ void TLoopManager::Run()
 
    InitNodes();
 
+   // TTreeProcessorMT attaches them to the tree of each thread as well
+   if (fPerfStats && fTree) fTree->SetPerfStats(fPerfStats);
+
 #ifdef R__USE_IMT
    if (ROOT::IsImplicitMTEnabled()) {
       switch (fLoopType) {
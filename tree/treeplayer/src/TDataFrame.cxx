@@ -565,3 +565,16 @@ TDataFrame::TDataFrame(ULong64_t numEntries)
    : TInterface<TDFDetail::TLoopManager>(std::make_shared<TDFDetail::TLoopManager>(numEntries))
 {
 }
+
+//////////////////////////////////////////////////////////////////////////
+/// \brief Attach performance statistics to the processed tree
+/// \param[in] perfStats The statistics, e.g. a TTreePerfStats, or nullptr.
+///
+/// When the event loop runs, the statistics are attached to the tree or
+/// chain of this dataframe (see TTree::SetPerfStats) and, if implicit
+/// multi-threading is enabled, to the tree processed by each thread, so
+/// that they cover the whole event loop.
+void TDataFrame::SetPerfStats(TVirtualPerfStats *perfStats)
+{
+   fProxiedPtr->SetPerfStats(perfStats);
+}
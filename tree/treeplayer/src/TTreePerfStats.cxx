@@ -77,6 +77,35 @@ ReadTotal +ReadTotal*Readextra/100. Same for ReadSize.
 A consequence of NOTE1, the Disk I/O speed corresponds to the effective
 number of bytes returned to the application per second.
 The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
+
+ ### Per-branch statistics
+In addition, for each branch read, the following counters are collected:
+ -  Baskets     = Number of baskets read
+ -  CacheMisses = Number of baskets read directly from the file, i.e. not
+                  found in the TTreeCache
+ -  ZipBytes    = Number of compressed bytes read
+ -  UnzipBytes  = Number of uncompressed bytes
+ -  Entries     = Number of entries deserialized
+ -  UnzipTime   = Real time spent uncompressing the baskets
+ -  StreamTime  = Real time spent deserializing the entries
+The counters are keyed by branch name. Each thread accumulates its own
+counters, which are merged when they are queried (GetBranchStats,
+GetBranchStatsMap, GetBranchStatsJSON, MakeBranchStatsTree, Print, Finish),
+so that the same TTreePerfStats can be attached (TTree::SetPerfStats) to
+several trees read in parallel without serializing the reads.
+ROOT::TTreeProcessorMT forwards the TTreePerfStats of the tree it processes to
+the tree of each processing slot only when it is constructed from a TTree,
+TTreeProcessorMT(TTree&): the per-branch counters then cover the whole
+multi-threaded read. When it is constructed from file and tree names, as done
+by ROOT::Experimental::TDataFrame, the trees of the slots have no perf stats.
+The global counters above only cover the tree given to the constructor.
+The per-branch counters are printed with Print("branches"), saved with the
+object and can be exported with MakeBranchStatsTree or GetBranchStatsJSON:
+~~~{.cpp}
+   ps->Print("branches");
+   TTree *bs = ps->MakeBranchStatsTree();
+   bs->Scan("branch:zipbytes:unziptime:streamtime");
+~~~
 */
 
 #include "TTreePerfStats.h"
@@ -95,9 +124,47 @@ The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
 #include "TTimeStamp.h"
 #include "TDatime.h"
 #include "TMath.h"
+#include "ThreadLocalStorage.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 ClassImp(TTreePerfStats);
 
+// Protects the merged per-branch counters and the lists of slots of all the
+// TTreePerfStats. Not taken when recording an event.
+static std::mutex gBranchStatsMutex;
+
+// Source of TTreePerfStats::fBranchStatsId.
+static std::atomic<ULong64_t> gBranchStatsIds(0);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Per-branch counters accumulated by one thread. The slot mutex is only
+/// contended while the counters are merged into fBranchStats.
+
+struct TTreePerfStats::BranchStatsSlot_t {
+   std::mutex       fMutex;
+   BranchStatsMap_t fStats;
+   std::unordered_map<const TObject*, BranchStatsMap_t::value_type*> fIndex; // fStats entries by TBranch address
+
+   /// Return the counters of branch, creating them if needed. The branch
+   /// addresses are cached, the name is checked since a branch of another
+   /// tree may reuse the address of a deleted one. fMutex must be held.
+   BranchStats_t &Find(const TObject *branch)
+   {
+      auto iter = fIndex.find(branch);
+      if (iter != fIndex.end() && iter->second->first == branch->GetName())
+         return iter->second->second;
+      BranchStatsMap_t::value_type &entry = *fStats.insert(BranchStatsMap_t::value_type(branch->GetName(), BranchStats_t())).first;
+      fIndex[branch] = &entry;
+      return entry.second;
+   }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// default constructor (used when reading an object only)
 
@@ -125,6 +192,7 @@ TTreePerfStats::TTreePerfStats() : TVirtualPerfStats()
    fCompress      = 0;
    fRealTimeAxis  = 0;
    fHostInfoText  = 0;
+   fBranchStatsId = ++gBranchStatsIds;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -171,6 +239,7 @@ TTreePerfStats::TTreePerfStats(const char *name, TTree *T) : TVirtualPerfStats()
    TDatime dt;
    fHostInfo += TString::Format(" %s",dt.AsString());
    fHostInfoText   = 0;
+   fBranchStatsId  = ++gBranchStatsIds;
 
    gPerfStats = this;
 }
@@ -188,6 +257,8 @@ TTreePerfStats::~TTreePerfStats()
    delete fWatch;
    delete fRealTimeAxis;
    delete fHostInfoText;
+   for (size_t i = 0; i < fBranchStatsSlots.size(); ++i)
+      delete fBranchStatsSlots[i];
 
    if (gPerfStats == this) {
       gPerfStats = 0;
@@ -195,6 +266,25 @@ TTreePerfStats::~TTreePerfStats()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record the read of a basket of branch.
+/// -  complen is the number of compressed bytes read (including the key)
+/// -  objlen is the number of uncompressed bytes (including the key)
+/// -  unzipTime is the real time spent uncompressing the basket
+/// -  cacheMiss is true if the basket was read directly from the file
+
+void TTreePerfStats::BasketReadEvent(TObject *branch, Int_t complen, Int_t objlen, Double_t unzipTime, Bool_t cacheMiss)
+{
+   BranchStatsSlot_t &slot = GetBranchStatsSlot();
+   std::lock_guard<std::mutex> lock(slot.fMutex);
+   BranchStats_t &stats = slot.Find(branch);
+   stats.fBaskets++;
+   if (cacheMiss) stats.fCacheMisses++;
+   stats.fZipBytes   += complen;
+   stats.fUnzipBytes += objlen;
+   stats.fUnzipTime  += unzipTime;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Browse
 
@@ -311,6 +401,149 @@ void TTreePerfStats::UnzipEvent(TObject * tree, Long64_t /* pos */, Double_t sta
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record the deserialization of one entry of branch.
+/// -  start is the TimeStamp before deserializing
+
+void TTreePerfStats::StreamEvent(TObject *branch, Double_t start)
+{
+   Double_t tnow = TTimeStamp();
+   BranchStatsSlot_t &slot = GetBranchStatsSlot();
+   std::lock_guard<std::mutex> lock(slot.fMutex);
+   BranchStats_t &stats = slot.Find(branch);
+   stats.fEntries++;
+   stats.fStreamTime += tnow-start;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the per-branch counters of the calling thread, creating them on
+/// its first event. Each thread keeps a cache of its slots, keyed by the
+/// address of the TTreePerfStats; fBranchStatsId tells apart a new object
+/// allocated at the address of a deleted one.
+
+TTreePerfStats::BranchStatsSlot_t &TTreePerfStats::GetBranchStatsSlot()
+{
+   typedef std::unordered_map<const TTreePerfStats*, std::pair<ULong64_t, BranchStatsSlot_t*> > SlotCache_t;
+   TTHREAD_TLS_DECL(SlotCache_t, cache);
+
+   std::pair<ULong64_t, BranchStatsSlot_t*> &cached = cache[this];
+   if (cached.second && cached.first == fBranchStatsId)
+      return *cached.second;
+
+   BranchStatsSlot_t *slot = new BranchStatsSlot_t;
+   {
+      std::lock_guard<std::mutex> lock(gBranchStatsMutex);
+      fBranchStatsSlots.push_back(slot);
+   }
+   cached = std::make_pair(fBranchStatsId, slot);
+   return *slot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the counters accumulated by the threads to fBranchStats and reset
+/// them. gBranchStatsMutex must be held.
+
+void TTreePerfStats::MergeBranchStats()
+{
+   for (size_t i = 0; i < fBranchStatsSlots.size(); ++i) {
+      BranchStatsSlot_t &slot = *fBranchStatsSlots[i];
+      std::lock_guard<std::mutex> lock(slot.fMutex);
+      for (BranchStatsMap_t::iterator iter = slot.fStats.begin(); iter != slot.fStats.end(); ++iter) {
+         BranchStats_t &from = iter->second;
+         BranchStats_t &to = fBranchStats[iter->first];
+         to.fBaskets     += from.fBaskets;
+         to.fCacheMisses += from.fCacheMisses;
+         to.fZipBytes    += from.fZipBytes;
+         to.fUnzipBytes  += from.fUnzipBytes;
+         to.fEntries     += from.fEntries;
+         to.fUnzipTime   += from.fUnzipTime;
+         to.fStreamTime  += from.fStreamTime;
+         from = BranchStats_t();
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the counters of the branch named branchname, or 0 if this branch
+/// was not read.
+
+const TTreePerfStats::BranchStats_t *TTreePerfStats::GetBranchStats(const char *branchname) const
+{
+   std::lock_guard<std::mutex> lock(gBranchStatsMutex);
+   ((TTreePerfStats*)this)->MergeBranchStats();
+   BranchStatsMap_t::const_iterator iter = fBranchStats.find(branchname);
+   if (iter == fBranchStats.end()) return 0;
+   return &iter->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the counters of all the branches read, keyed by branch name.
+
+const TTreePerfStats::BranchStatsMap_t &TTreePerfStats::GetBranchStatsMap() const
+{
+   std::lock_guard<std::mutex> lock(gBranchStatsMutex);
+   ((TTreePerfStats*)this)->MergeBranchStats();
+   return fBranchStats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the per-branch counters as a JSON document of the form
+/// ~~~
+/// {"name": "ioperf", "branches": [
+///   {"branch": "px", "baskets": 10, "cachemisses": 0, "zipbytes": 3241, ...},
+///   ...
+/// ]}
+/// ~~~
+
+TString TTreePerfStats::GetBranchStatsJSON() const
+{
+   std::lock_guard<std::mutex> lock(gBranchStatsMutex);
+   ((TTreePerfStats*)this)->MergeBranchStats();
+   TString json = TString::Format("{\"name\": \"%s\", \"branches\": [", fName.Data());
+   for (BranchStatsMap_t::const_iterator iter = fBranchStats.begin(); iter != fBranchStats.end(); ++iter) {
+      TString name = iter->first.c_str();
+      name.ReplaceAll("\\", "\\\\");
+      name.ReplaceAll("\"", "\\\"");
+      const BranchStats_t &stats = iter->second;
+      if (iter != fBranchStats.begin()) json += ",";
+      json += TString::Format("\n  {\"branch\": \"%s\", \"baskets\": %lld, \"cachemisses\": %lld, "
+                              "\"zipbytes\": %lld, \"unzipbytes\": %lld, \"entries\": %lld, "
+                              "\"unziptime\": %g, \"streamtime\": %g}",
+                              name.Data(), stats.fBaskets, stats.fCacheMisses, stats.fZipBytes,
+                              stats.fUnzipBytes, stats.fEntries, stats.fUnzipTime, stats.fStreamTime);
+   }
+   json += "\n]}\n";
+   return json;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a TTree with one entry per branch read, holding its counters.
+/// The tree is attached to the current directory and owned by the caller.
+
+TTree *TTreePerfStats::MakeBranchStatsTree(const char *name) const
+{
+   std::lock_guard<std::mutex> lock(gBranchStatsMutex);
+   ((TTreePerfStats*)this)->MergeBranchStats();
+   std::string branch;
+   BranchStats_t stats;
+   TTree *tree = new TTree(name, TString::Format("Per-branch I/O statistics of %s", fName.Data()));
+   tree->Branch("branch", &branch);
+   tree->Branch("baskets", &stats.fBaskets, "baskets/L");
+   tree->Branch("cachemisses", &stats.fCacheMisses, "cachemisses/L");
+   tree->Branch("zipbytes", &stats.fZipBytes, "zipbytes/L");
+   tree->Branch("unzipbytes", &stats.fUnzipBytes, "unzipbytes/L");
+   tree->Branch("entries", &stats.fEntries, "entries/L");
+   tree->Branch("unziptime", &stats.fUnzipTime, "unziptime/D");
+   tree->Branch("streamtime", &stats.fStreamTime, "streamtime/D");
+   for (BranchStatsMap_t::const_iterator iter = fBranchStats.begin(); iter != fBranchStats.end(); ++iter) {
+      branch = iter->first;
+      stats = iter->second;
+      tree->Fill();
+   }
+   tree->ResetBranchAddresses();
+   return tree;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// When the run is finished this function must be called
 /// to save the current parameters in the file and Tree in this object
@@ -318,6 +551,11 @@ void TTreePerfStats::UnzipEvent(TObject * tree, Long64_t /* pos */, Double_t sta
 
 void TTreePerfStats::Finish()
 {
+   {
+      // per-branch counters are saved with the object
+      std::lock_guard<std::mutex> lock(gBranchStatsMutex);
+      MergeBranchStats();
+   }
    if (fRealNorm)   return;  //has already been called
    if (!fFile)      return;
    if (!fTree)      return;
@@ -423,6 +661,8 @@ void TTreePerfStats::Paint(Option_t *option)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Print the TTree I/O perf stats.
+/// With option "unzip" the time spent uncompressing is printed, with
+/// option "branches" the per-branch counters, largest readers first.
 
 void TTreePerfStats::Print(Option_t * option) const
 {
@@ -457,6 +697,26 @@ void TTreePerfStats::Print(Option_t * option) const
       printf("ReadStrCP = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/(fCpuTime-fUnzipTime));
       printf("ReadZipCP = %7.3f MBytes/s\n",1e-6*fCompress*fBytesRead/fUnzipTime);
    }
+   if (opts.Contains("branches")) {
+      // Largest readers first
+      std::lock_guard<std::mutex> lock(gBranchStatsMutex);
+      ps->MergeBranchStats();
+      std::vector<const BranchStatsMap_t::value_type*> branches;
+      for (BranchStatsMap_t::const_iterator iter = fBranchStats.begin(); iter != fBranchStats.end(); ++iter)
+         branches.push_back(&*iter);
+      std::sort(branches.begin(), branches.end(),
+                [](const BranchStatsMap_t::value_type *a, const BranchStatsMap_t::value_type *b) {
+                   return a->second.fZipBytes > b->second.fZipBytes;
+                });
+      printf("%-30s %8s %8s %12s %12s %10s %10s %10s\n", "Branch", "Baskets", "Misses", "ZipBytes",
+             "UnzipBytes", "Entries", "UnzipTime", "StrmTime");
+      for (size_t i = 0; i < branches.size(); ++i) {
+         const BranchStats_t &stats = branches[i]->second;
+         printf("%-30s %8lld %8lld %12lld %12lld %10lld %10.3f %10.3f\n", branches[i]->first.c_str(),
+                stats.fBaskets, stats.fCacheMisses, stats.fZipBytes, stats.fUnzipBytes, stats.fEntries,
+                stats.fUnzipTime, stats.fStreamTime);
+      }
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -113,10 +113,6 @@ TTreePlayer::TTreePlayer()
    fInput->Add(new TNamed("varexp",""));
    fInput->Add(new TNamed("selection",""));
    fSelector->SetInputList(fInput);
-   {
-      R__LOCKGUARD(gROOTMutex);
-      gROOT->GetListOfCleanups()->Add(this);
-   }
    TClass::GetClass("TRef")->AdoptReferenceProxy(new TRefProxy());
    TClass::GetClass("TRefArray")->AdoptReferenceProxy(new TRefArrayProxy());
 }
@@ -131,8 +127,7 @@ TTreePlayer::~TTreePlayer()
    DeleteSelectorFromFile();
    fInput->Delete();
    delete fInput;
-   R__LOCKGUARD(gROOTMutex);
-   gROOT->GetListOfCleanups()->Remove(this);
+   if (fHistogram) gROOT->UnregisterCleanup(fHistogram, this);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -436,7 +431,15 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    Int_t action   = fSelector->GetAction();
    Bool_t draw = kFALSE;
    if (!drawflag && !opt.Contains("goff")) draw = kTRUE;
-   if (!optcandle && !optpara) fHistogram = (TH1*)fSelector->GetObject();
+   if (!optcandle && !optpara) {
+      TH1 *hist = (TH1*)fSelector->GetObject();
+      if (hist != fHistogram) {
+         // only the deletion of the histogram is of interest, see RecursiveRemove
+         if (fHistogram) gROOT->UnregisterCleanup(fHistogram, this);
+         fHistogram = hist;
+         if (fHistogram) gROOT->RegisterCleanup(fHistogram, this);
+      }
+   }
    if (optnorm) {
       Double_t sumh= fHistogram->GetSumOfWeights();
       if (sumh != 0) fHistogram->Scale(1./sumh);
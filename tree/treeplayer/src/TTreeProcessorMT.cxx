@@ -21,6 +21,12 @@ The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+If performance statistics are attached to the processed TTree (e.g. a TTreePerfStats,
+see TTree::SetPerfStats), they are attached to the TTree of each thread too, so that
+the per-branch counters of TTreePerfStats cover the whole parallel processing.
+When the TTreeProcessorMT is constructed from file and tree names, the performance
+statistics can be given to the constructor.
 */
 
 #include "TROOT.h"
@@ -35,7 +41,10 @@ using namespace ROOT;
 /// \param[in] treename Name of the tree to process. If not provided,
 ///                     the implementation will automatically search for a
 ///                     tree in the file.
-TTreeProcessorMT::TTreeProcessorMT(std::string_view filename, std::string_view treename) : treeView(filename, treename) {}
+/// \param[in] perfStats Performance statistics (e.g. a TTreePerfStats) attached
+///                      to the tree of each thread, or nullptr.
+TTreeProcessorMT::TTreeProcessorMT(std::string_view filename, std::string_view treename, TVirtualPerfStats *perfStats)
+   : treeView(filename, treename, perfStats) {}
 
 ////////////////////////////////////////////////////////////////////////
 /// Constructor based on a collection of file names.
@@ -43,7 +52,11 @@ TTreeProcessorMT::TTreeProcessorMT(std::string_view filename, std::string_view t
 /// \param[in] treename Name of the tree to process. If not provided,
 ///                     the implementation will automatically search for a
 ///                     tree in the collection of files.
-TTreeProcessorMT::TTreeProcessorMT(const std::vector<std::string_view> &filenames, std::string_view treename) : treeView(filenames, treename) {}
+/// \param[in] perfStats Performance statistics (e.g. a TTreePerfStats) attached
+///                      to the tree of each thread, or nullptr.
+TTreeProcessorMT::TTreeProcessorMT(const std::vector<std::string_view> &filenames, std::string_view treename,
+                                   TVirtualPerfStats *perfStats)
+   : treeView(filenames, treename, perfStats) {}
 
 ////////////////////////////////////////////////////////////////////////
 /// Constructor based on a TTree.
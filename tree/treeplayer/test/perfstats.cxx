@@ -0,0 +1,164 @@
+#include "RConfigure.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreePerfStats.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+#include "ROOT/TDataFrame.hxx"
+#include "ROOT/TTreeProcessorMT.hxx"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <vector>
+
+static const char *kFileName = "treeplayer_perfstats.root";
+static const Long64_t kNEntries = 20000;
+
+void WritePerfStatsTree()
+{
+   TFile f(kFileName, "RECREATE");
+   TTree t("T", "perf stats test tree");
+   Int_t i = 0;
+   Double_t x = 0;
+   t.Branch("i", &i, "i/I");
+   t.Branch("x", &x, "x/D");
+   t.SetAutoFlush(2000);
+   for (i = 0; i < kNEntries; ++i) {
+      x = i * 0.5;
+      t.Fill();
+   }
+   t.Write();
+}
+
+TEST(TTreePerfStats, BranchStats)
+{
+   WritePerfStatsTree();
+   TFile f(kFileName);
+   TTree *t = nullptr;
+   f.GetObject("T", t);
+   ASSERT_NE(t, nullptr);
+   t->SetCacheSize(0);
+
+   TTreePerfStats ps("ioperf", t);
+   for (Long64_t entry = 0; entry < kNEntries; ++entry)
+      t->GetEntry(entry);
+
+   for (auto name : {"i", "x"}) {
+      const TTreePerfStats::BranchStats_t *stats = ps.GetBranchStats(name);
+      ASSERT_NE(stats, nullptr);
+      EXPECT_EQ(stats->fEntries, kNEntries);
+      EXPECT_EQ(stats->fBaskets, t->GetBranch(name)->GetWriteBasket());
+      // Without a TTreeCache every basket comes from the file.
+      EXPECT_EQ(stats->fCacheMisses, stats->fBaskets);
+      EXPECT_GT(stats->fZipBytes, 0);
+      EXPECT_GT(stats->fUnzipBytes, 0);
+   }
+   EXPECT_EQ(ps.GetBranchStats("y"), nullptr);
+
+   TString json = ps.GetBranchStatsJSON();
+   EXPECT_TRUE(json.Contains("\"branch\": \"i\""));
+   EXPECT_TRUE(json.Contains("\"branch\": \"x\""));
+
+   std::unique_ptr<TTree> bs(ps.MakeBranchStatsTree());
+   bs->SetDirectory(nullptr);
+   EXPECT_EQ(bs->GetEntries(), 2);
+   EXPECT_EQ(bs->GetEntries("entries==20000"), 2);
+   t->SetPerfStats(nullptr);
+}
+
+#ifdef R__USE_IMT
+TEST(TTreePerfStats, BranchStatsMT)
+{
+   WritePerfStatsTree();
+   TFile f(kFileName);
+   TTree *t = nullptr;
+   f.GetObject("T", t);
+   ASSERT_NE(t, nullptr);
+
+   TTreePerfStats ps("ioperf", t);
+   ROOT::EnableImplicitMT(4);
+   std::atomic<Long64_t> nread(0);
+   ROOT::TTreeProcessorMT tp(*t);
+   tp.Process([&nread](TTreeReader &r) {
+      TTreeReaderValue<Double_t> x(r, "x");
+      while (r.Next()) {
+         if (*x >= 0) ++nread;
+      }
+   });
+   ROOT::DisableImplicitMT();
+
+   EXPECT_EQ(nread, kNEntries);
+   const TTreePerfStats::BranchStats_t *stats = ps.GetBranchStats("x");
+   ASSERT_NE(stats, nullptr);
+   EXPECT_EQ(stats->fEntries, kNEntries);
+   EXPECT_EQ(ps.GetBranchStats("i"), nullptr);
+   t->SetPerfStats(nullptr);
+}
+
+TEST(TTreePerfStats, BranchStatsMTFileNames)
+{
+   WritePerfStatsTree();
+   TFile f(kFileName);
+   TTree *t = nullptr;
+   f.GetObject("T", t);
+   ASSERT_NE(t, nullptr);
+
+   TTreePerfStats ps("ioperf", t);
+   t->SetPerfStats(nullptr);
+   ROOT::EnableImplicitMT(4);
+   std::atomic<Long64_t> nread(0);
+   std::vector<std::string_view> fileNames{kFileName};
+   ROOT::TTreeProcessorMT tp(fileNames, "T", &ps);
+   tp.Process([&nread](TTreeReader &r) {
+      TTreeReaderValue<Int_t> i(r, "i");
+      while (r.Next()) {
+         if (*i >= 0) ++nread;
+      }
+   });
+   ROOT::DisableImplicitMT();
+
+   EXPECT_EQ(nread, kNEntries);
+   const TTreePerfStats::BranchStats_t *stats = ps.GetBranchStats("i");
+   ASSERT_NE(stats, nullptr);
+   EXPECT_EQ(stats->fEntries, kNEntries);
+   EXPECT_EQ(ps.GetBranchStats("x"), nullptr);
+}
+#endif
+
+TEST(TTreePerfStats, DataFrame)
+{
+   WritePerfStatsTree();
+   TFile f(kFileName);
+   TTree *t = nullptr;
+   f.GetObject("T", t);
+   ASSERT_NE(t, nullptr);
+
+   TTreePerfStats ps("ioperf", t);
+   t->SetPerfStats(nullptr);
+   {
+      ROOT::Experimental::TDataFrame df("T", kFileName);
+      df.SetPerfStats(&ps);
+      EXPECT_DOUBLE_EQ(*df.Max<Double_t>("x"), 0.5 * (kNEntries - 1));
+   }
+   const TTreePerfStats::BranchStats_t *stats = ps.GetBranchStats("x");
+   ASSERT_NE(stats, nullptr);
+   EXPECT_EQ(stats->fEntries, kNEntries);
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   {
+      ROOT::Experimental::TDataFrame df("T", kFileName);
+      df.SetPerfStats(&ps);
+      EXPECT_DOUBLE_EQ(*df.Max<Double_t>("x"), 0.5 * (kNEntries - 1));
+   }
+   ROOT::DisableImplicitMT();
+   stats = ps.GetBranchStats("x");
+   ASSERT_NE(stats, nullptr);
+   EXPECT_EQ(stats->fEntries, 2 * kNEntries);
+#endif
+
+   gSystem->Unlink(kFileName);
+}
@@ -0,0 +1,80 @@
+#include "TAxis.h"
+#include "TChain.h"
+#include "TFile.h"
+#include "THashList.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+static const char *kRecycleFileName = "treeplayer_recycleobjects.root";
+static const Int_t kRecycleEntries = 50;
+
+// TAxis::fLabels is a pointer data member without '->': it is deleted and
+// read again for each entry unless the tree recycles objects.
+void WriteRecycleTree()
+{
+   TFile f(kRecycleFileName, "RECREATE");
+   TTree t("T", "recycle objects test tree");
+   TAxis axis(3, 0., 3.);
+   TAxis *paxis = &axis;
+   t.Branch("axis", &paxis, 32000, 0);
+   for (Int_t i = 0; i < kRecycleEntries; ++i) {
+      axis.SetBinLabel(1, TString::Format("first%d", i));
+      axis.SetBinLabel(3, TString::Format("third%d", i));
+      t.Fill();
+   }
+   t.Write();
+}
+
+void ReadRecycleTree(TTree &t, Bool_t recycle)
+{
+   // owned by the test, not by the branch
+   TAxis *axis = new TAxis();
+   t.SetBranchAddress("axis", &axis);
+   t.SetRecycleObjects(recycle);
+
+   THashList *labels = nullptr;
+   for (Long64_t entry = 0; entry < t.GetEntries(); ++entry) {
+      ASSERT_GT(t.GetEntry(entry), 0);
+      ASSERT_NE(axis, nullptr);
+      ASSERT_NE(axis->GetLabels(), nullptr);
+      Int_t i = entry % kRecycleEntries;
+      EXPECT_STREQ(axis->GetBinLabel(1), TString::Format("first%d", i).Data());
+      EXPECT_STREQ(axis->GetBinLabel(2), "");
+      EXPECT_STREQ(axis->GetBinLabel(3), TString::Format("third%d", i).Data());
+      EXPECT_EQ(axis->GetLabels()->GetSize(), 2);
+      // the list of labels is constructed again in the same memory
+      if (recycle && labels) EXPECT_EQ(axis->GetLabels(), labels) << "entry " << entry;
+      labels = axis->GetLabels();
+   }
+   t.ResetBranchAddresses();
+   delete axis;
+}
+
+TEST(RecycleObjects, Tree)
+{
+   WriteRecycleTree();
+   for (Bool_t recycle : {kFALSE, kTRUE}) {
+      TFile f(kRecycleFileName);
+      TTree *t = nullptr;
+      f.GetObject("T", t);
+      ASSERT_NE(t, nullptr);
+      ReadRecycleTree(*t, recycle);
+   }
+}
+
+TEST(RecycleObjects, Chain)
+{
+   WriteRecycleTree();
+   for (Bool_t recycle : {kFALSE, kTRUE}) {
+      TChain c("T");
+      c.Add(kRecycleFileName);
+      c.Add(kRecycleFileName);
+      EXPECT_EQ(c.GetEntries(), 2 * kRecycleEntries);
+      ReadRecycleTree(c, recycle);
+   }
+   gSystem->Unlink(kRecycleFileName);
+}